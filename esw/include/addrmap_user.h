@@ -14,6 +14,15 @@
 // 2025-07-31  1.0      mrosiere Created
 // 2025-11-02  1.1      mrosiere Add Timer
 // 2026-05-29  1.2      mrosiere Add SPINLOCK and MAILBOX
+// 2026-10-17  1.3      mrosiere Fix GIC_TIMER_MSK
+// 2026-10-17  1.4      mrosiere Add MODBUS_RTU
+// 2026-10-17  1.5      mrosiere Add DMA
+// 2026-10-17  1.6      mrosiere Add BOOT
+// 2026-10-17  1.7      mrosiere Add GIC_MAILBOX
+// 2026-10-17  1.8      mrosiere Add RAM_GLO_HI
+// 2026-10-17  1.9      mrosiere Add GIC_SPINLOCK
+// 2026-10-17  1.10     mrosiere Add ATOMIC
+// 2026-10-17  1.11     mrosiere Add BARRIER
 //-----------------------------------------------------------------------------
 
 #ifndef _addrmap_user_h_
@@ -31,7 +40,12 @@
 #include "timer.h"
 #include "crc.h"
 #include "spinlock.h"
+#include "atomic.h"
+#include "barrier.h"
 #include "mailbox.h"
+#include "modbus_rtu_hw.h"
+#include "dma.h"
+#include "boot.h"
 
 //--------------------------------------
 // Address Map
@@ -46,14 +60,25 @@
 #define SPI                 0x18
 #define UART                0x20
 #define TIMER               0x28
+#define BARRIER             0x2D // Unused address of the TIMER
+#define ATOMIC              0x2E // Unused addresses of the TIMER
+#define MODBUS_RTU          0x30
+#define DMA                 0x38
+#define BOOT                0x3C
 #define RAM_GLO             0x40
 #define RAM_LOC             0x80
+#define RAM_GLO_HI          0xC0 // RAM2_DEPTH > 64 and RAM1_DEPTH <= 64
 
 //--------------------------------------
 // IT
 //--------------------------------------
 #define GIC_IT_USER_MSK     0x01
 #define GIC_UART_MSK        0x02
-#define GIC_TIMER_MSK       0x03
+#define GIC_TIMER_MSK       0x04
+#define GIC_MODBUS_RTU_MSK  0x08
+#define GIC_DMA_MSK         0x10
+#define GIC_MAILBOX0_MSK    0x20
+#define GIC_MAILBOX1_MSK    0x40
+#define GIC_SPINLOCK_MSK    0x80
 
 #endif
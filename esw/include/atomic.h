@@ -0,0 +1,89 @@
+//-----------------------------------------------------------------------------
+// Title      : Macro for atomic operations
+// Project    : Asylum
+//-----------------------------------------------------------------------------
+// File       : atomic.h
+// Author     : mrosiere
+//-----------------------------------------------------------------------------
+// Description:
+// Atomic operations on 32 bits cells shared by all the CPUs
+// (see hdl/sbi_atomic_mp.vhd). Each CPU has its own operands and result :
+// the operand is kept between the operations, so once set, a fetch and add
+// is one write of CMD then the reads of the result.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026
+//-----------------------------------------------------------------------------
+// Revisions  :
+// Date        Version  Author   Description
+// 2026-10-17  1.0      mrosiere Created
+//-----------------------------------------------------------------------------
+
+#ifndef _atomic_h_
+#define _atomic_h_
+
+// Registers
+#define ATOMIC_DATA             0x0
+#define ATOMIC_CMD              0x1
+
+// Operations (CMD[7:6]), the cell is CMD[5:0]
+#define ATOMIC_OP_LOAD          0x00
+#define ATOMIC_OP_ADD           0x40
+#define ATOMIC_OP_SWAP          0x80
+#define ATOMIC_OP_CAS           0xC0
+
+// Operand: Set the operand of the next operations (32 bits)
+#define atomic_operand(_BA_, _VAL_)                        \
+  do {                                                     \
+    PORT_WR(_BA_, ATOMIC_DATA, ((_VAL_)      ) & 0xFF);    \
+    PORT_WR(_BA_, ATOMIC_DATA, ((_VAL_) >>  8) & 0xFF);    \
+    PORT_WR(_BA_, ATOMIC_DATA, ((_VAL_) >> 16) & 0xFF);    \
+    PORT_WR(_BA_, ATOMIC_DATA, ((_VAL_) >> 24) & 0xFF);    \
+  } while (0)
+
+// Compare: Set the compare value then the operand of a CAS
+#define atomic_compare(_BA_, _CMP_, _VAL_)                 \
+  do {                                                     \
+    atomic_operand(_BA_, _CMP_);                           \
+    atomic_operand(_BA_, _VAL_);                           \
+  } while (0)
+
+// Cmd: Do the operation _OP_ on the cell _CELL_ with the current operands
+#define atomic_cmd(_BA_, _OP_, _CELL_)  PORT_WR(_BA_, ATOMIC_CMD, (_OP_) | (_CELL_))
+
+// Result: Value of the cell before the last operation (4 reads)
+#define atomic_result(_BA_, _VAR_)                                 \
+  do {                                                             \
+    (_VAR_)  = ((uint32_t)PORT_RD(_BA_, ATOMIC_DATA));             \
+    (_VAR_) |= ((uint32_t)PORT_RD(_BA_, ATOMIC_DATA)) <<  8;       \
+    (_VAR_) |= ((uint32_t)PORT_RD(_BA_, ATOMIC_DATA)) << 16;       \
+    (_VAR_) |= ((uint32_t)PORT_RD(_BA_, ATOMIC_DATA)) << 24;       \
+  } while (0)
+
+// Done: 1 if the last CAS has written the cell
+#define atomic_cas_done(_BA_)           (PORT_RD(_BA_, ATOMIC_CMD) & 0x1)
+
+// Fetch and add: _VAR_ = cell, cell += _VAL_
+#define atomic_fetch_add(_BA_, _CELL_, _VAL_, _VAR_)       \
+  do {                                                     \
+    atomic_operand(_BA_, _VAL_);                           \
+    atomic_cmd    (_BA_, ATOMIC_OP_ADD, _CELL_);           \
+    atomic_result (_BA_, _VAR_);                           \
+  } while (0)
+
+// Swap: _VAR_ = cell, cell = _VAL_
+#define atomic_swap(_BA_, _CELL_, _VAL_, _VAR_)            \
+  do {                                                     \
+    atomic_operand(_BA_, _VAL_);                           \
+    atomic_cmd    (_BA_, ATOMIC_OP_SWAP, _CELL_);          \
+    atomic_result (_BA_, _VAR_);                           \
+  } while (0)
+
+// Compare and swap: if cell == _CMP_ then cell = _VAL_, _DONE_ = 1 if written
+#define atomic_cas(_BA_, _CELL_, _CMP_, _VAL_, _DONE_)     \
+  do {                                                     \
+    atomic_compare(_BA_, _CMP_, _VAL_);                    \
+    atomic_cmd    (_BA_, ATOMIC_OP_CAS, _CELL_);           \
+    (_DONE_) = atomic_cas_done(_BA_);                      \
+  } while (0)
+
+#endif
@@ -0,0 +1,36 @@
+//-----------------------------------------------------------------------------
+// Title      : Macro for barrier
+// Project    : Asylum
+//-----------------------------------------------------------------------------
+// File       : barrier.h
+// Author     : mrosiere
+//-----------------------------------------------------------------------------
+// Description:
+// Barrier of all the CPUs (see hdl/sbi_barrier_mp.vhd).
+// The barrier is local to each CPU : the wait doesn't use the ICN2.
+// With BARRIER_HOLD, the CPUs 1 to NB_CPU-1 are in reset until the CPU 0
+// arrives at the barrier.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026
+//-----------------------------------------------------------------------------
+// Revisions  :
+// Date        Version  Author   Description
+// 2026-10-17  1.0      mrosiere Created
+//-----------------------------------------------------------------------------
+
+#ifndef _barrier_h_
+#define _barrier_h_
+
+// Registers
+#define BARRIER_ARRIVE               0x0
+
+// Arrive: The CPU arrives at the barrier
+#define barrier_arrive(_BA_)         PORT_WR(_BA_,BARRIER_ARRIVE,0x01)
+
+// Waiting: 1 while the CPU waits the other CPUs, 0 when released
+#define barrier_waiting(_BA_)        PORT_RD(_BA_,BARRIER_ARRIVE)
+
+// Wait: Arrive then wait until all the CPUs have arrived
+#define barrier_wait(_BA_)           do {barrier_arrive(_BA_); while (barrier_waiting(_BA_) != 0);} while (0)
+
+#endif
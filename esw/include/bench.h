@@ -0,0 +1,30 @@
+//-----------------------------------------------------------------------------
+// Title      : Macro for benchmark
+// Project    : Asylum
+//-----------------------------------------------------------------------------
+// File       : bench.h
+// Author     : mrosiere
+//-----------------------------------------------------------------------------
+// Description:
+// Each measured section is framed by bench_begin(ID) / bench_end().
+// The section ID is written on LED0, tb_PicoSoC_bench measures the
+// number of cycles while LED0 is not 0 and stops on BENCH_ID_EXIT.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026
+//-----------------------------------------------------------------------------
+// Revisions  :
+// Date        Version  Author   Description
+// 2026-10-17  1.0      mrosiere Created
+//-----------------------------------------------------------------------------
+
+#ifndef _bench_h_
+#define _bench_h_
+
+#define BENCH_ID_EXIT        0xFF
+
+#define bench_setup()        do {gpio_setup(LED0,OUTPUT);gpio_setup(LED1,OUTPUT);gpio_wr(LED0,0);gpio_wr(LED1,0);} while (0)
+#define bench_begin(_ID_)    gpio_wr(LED0,_ID_)
+#define bench_end()          gpio_wr(LED0,0)
+#define bench_exit(_ERR_)    do {gpio_wr(LED1,_ERR_);gpio_wr(LED0,BENCH_ID_EXIT);} while (0)
+
+#endif
@@ -0,0 +1,57 @@
+//-----------------------------------------------------------------------------
+// Title      : Macro for boot loader
+// Project    : Asylum
+//-----------------------------------------------------------------------------
+// File       : boot.h
+// Author     : mrosiere
+//-----------------------------------------------------------------------------
+// Description:
+// Image in the spi flash (BOOT_IMAGE<n>_ADDR) built by tools/mkboot.py
+//   +0 LEN      : Number of instructions (16 bits, LSB first)
+//   +2 CRC      : CRC16 of the instructions (16 bits, LSB first)
+//   +4 INSTR    : Instructions, BOOT_INSTR_BYTES bytes each, LSB first
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026
+//-----------------------------------------------------------------------------
+// Revisions  :
+// Date        Version  Author   Description
+// 2026-10-17  1.0      mrosiere Created
+//-----------------------------------------------------------------------------
+
+#ifndef _boot_h_
+#define _boot_h_
+
+// Registers (see hdl/sbi_boot.vhd)
+#define BOOT_ADDR_LSB           0x0
+#define BOOT_ADDR_MSB           0x1
+#define BOOT_DATA               0x2
+#define BOOT_CTRL               0x3
+
+#define BOOT_CTRL_ROM           0x00
+#define BOOT_CTRL_RAM           0x01
+
+// Image
+#define BOOT_HEADER_SIZE        4
+#define BOOT_IMAGE0_ADDR        0x010000
+#define BOOT_IMAGE1_ADDR        0x020000
+
+#ifdef picoblaze
+#define BOOT_INSTR_BYTES        3 // 18 bits instruction
+#else
+#define BOOT_INSTR_BYTES        4 // 32 bits instruction
+#endif
+
+#ifndef BOOT_IMAGE_LEN_MAX
+#define BOOT_IMAGE_LEN_MAX      1024 // Depth of the instruction RAM
+#endif
+
+// Address : next instruction to write in the instruction RAM
+// Write   : next byte of the instruction (LSB first)
+// Start   : reset all CPUs and fetch from the instruction RAM
+#define boot_addr(_BA_,_ADDR_)             do {PORT_WR(_BA_,BOOT_ADDR_LSB,((_ADDR_)>>0)&0xFF);PORT_WR(_BA_,BOOT_ADDR_MSB,((_ADDR_)>>8)&0xFF);} while (0)
+#define boot_wr(_BA_,_DATA_)               PORT_WR(_BA_,BOOT_DATA,_DATA_)
+#define boot_start(_BA_)                   PORT_WR(_BA_,BOOT_CTRL,BOOT_CTRL_RAM)
+#define boot_rom(_BA_)                     PORT_WR(_BA_,BOOT_CTRL,BOOT_CTRL_ROM)
+#define boot_is_ram(_BA_)                  (PORT_RD(_BA_,BOOT_CTRL)&BOOT_CTRL_RAM)
+
+#endif
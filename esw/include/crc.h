@@ -13,6 +13,7 @@
 // Date        Version  Author   Description
 // 2025-11-02  1.0      mrosiere Created
 // 2026-06-26  1.1      mrosiere Use include from regtool
+// 2026-10-17  1.2      mrosiere Add streaming API
 //-----------------------------------------------------------------------------
 
 #ifndef _crc_h_
@@ -23,4 +24,12 @@
 #define crc_rd(_BA_,_ADDR_)         PORT_RD(_BA_,CRC_##_ADDR_)
 #define crc_wr(_BA_,_ADDR_,_DATA_)  PORT_WR(_BA_,CRC_##_ADDR_,_DATA_)
 
+// Streaming API
+// * crc_init  : set the running value
+// * crc_feed  : accumulate one byte, the running value stays in the peripheral
+// * crc_final : read the running value (once per frame)
+#define crc_init(_BA_,_CRC_)        do {PORT_WR(_BA_,CRC_CRC0,((_CRC_)>>0)&0xFF);PORT_WR(_BA_,CRC_CRC1,((_CRC_)>>8)&0xFF);} while (0)
+#define crc_feed(_BA_,_DATA_)       PORT_WR(_BA_,CRC_DATA0,_DATA_)
+#define crc_final(_BA_)             ((((uint16_t)PORT_RD(_BA_,CRC_CRC1))<<8)|PORT_RD(_BA_,CRC_CRC0))
+
 #endif
@@ -0,0 +1,90 @@
+//-----------------------------------------------------------------------------
+// Title      : Software CRC16 (Modbus)
+// Project    : Asylum
+//-----------------------------------------------------------------------------
+// File       : crc16.h
+// Author     : mrosiere
+//-----------------------------------------------------------------------------
+// Description:
+// CRC16 Modbus (polynom 0xA001, LSB first)
+// * crc16_bitwise_next : 8 shift/xor steps per byte
+// * crc16_table_next   : 2 lookups per byte in a 16 entries table
+//                        (available if CRC_TABLE is defined)
+//                        the table is computed by crc16_table_init in RAM
+//                        (a 256 entries table don't fit in the data memory)
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026
+//-----------------------------------------------------------------------------
+// Revisions  :
+// Date        Version  Author   Description
+// 2026-10-17  1.0      mrosiere Created
+//-----------------------------------------------------------------------------
+
+#ifndef _crc16_h_
+#define _crc16_h_
+
+#include <stdint.h>
+
+#define CRC16_POLYNOM        0xA001
+
+//--------------------------------------
+// crc16_bitwise_next
+// Compute one loop of CRC16
+//--------------------------------------
+uint16_t crc16_bitwise_next(uint16_t crc,
+                            uint8_t  data)
+{
+  crc = crc ^ data;
+
+  if ((crc & 0x0001) != 0) {crc >>= 1; crc ^= CRC16_POLYNOM;} else { crc >>= 1; }
+  if ((crc & 0x0001) != 0) {crc >>= 1; crc ^= CRC16_POLYNOM;} else { crc >>= 1; }
+  if ((crc & 0x0001) != 0) {crc >>= 1; crc ^= CRC16_POLYNOM;} else { crc >>= 1; }
+  if ((crc & 0x0001) != 0) {crc >>= 1; crc ^= CRC16_POLYNOM;} else { crc >>= 1; }
+  if ((crc & 0x0001) != 0) {crc >>= 1; crc ^= CRC16_POLYNOM;} else { crc >>= 1; }
+  if ((crc & 0x0001) != 0) {crc >>= 1; crc ^= CRC16_POLYNOM;} else { crc >>= 1; }
+  if ((crc & 0x0001) != 0) {crc >>= 1; crc ^= CRC16_POLYNOM;} else { crc >>= 1; }
+  if ((crc & 0x0001) != 0) {crc >>= 1; crc ^= CRC16_POLYNOM;} else { crc >>= 1; }
+
+  return crc;
+}
+
+#ifdef CRC_TABLE
+uint16_t crc16_table[16];
+
+//--------------------------------------
+// crc16_table_init
+// Compute the CRC16 of each nibble
+//--------------------------------------
+void crc16_table_init()
+{
+  uint8_t  i;
+  uint8_t  j;
+  uint16_t crc;
+
+  for (i = 0; i < 16; i++)
+    {
+      crc = i;
+      for (j = 0; j < 4; j++)
+        {
+          if ((crc & 0x0001) != 0) {crc >>= 1; crc ^= CRC16_POLYNOM;} else { crc >>= 1; }
+        }
+      crc16_table[i] = crc;
+    }
+}
+
+//--------------------------------------
+// crc16_table_next
+// Compute one loop of CRC16 (LSB nibble first)
+//--------------------------------------
+uint16_t crc16_table_next(uint16_t crc,
+                          uint8_t  data)
+{
+  crc = crc ^ data;
+  crc = (crc >> 4) ^ crc16_table[crc & 0x0F];
+  crc = (crc >> 4) ^ crc16_table[crc & 0x0F];
+
+  return crc;
+}
+#endif
+
+#endif
@@ -0,0 +1,73 @@
+//-----------------------------------------------------------------------------
+// Title      : Macro for dma
+// Project    : Asylum
+//-----------------------------------------------------------------------------
+// File       : dma.h
+// Author     : mrosiere
+//-----------------------------------------------------------------------------
+// Description:
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026
+//-----------------------------------------------------------------------------
+// Revisions  :
+// Date        Version  Author   Description
+// 2026-10-17  1.0      mrosiere Created
+//-----------------------------------------------------------------------------
+
+#ifndef _dma_h_
+#define _dma_h_
+
+// Registers (see hdl/sbi_dma.vhd)
+#define DMA_ISR                 0x0
+#define DMA_IMR                 0x1
+#define DMA_DESC                0x2
+#define DMA_STATUS              0x3
+
+#define DMA_IT_DONE             0
+#define DMA_IT_DESC             1
+
+#define DMA_IT_DONE_MSK         0x01
+#define DMA_IT_DESC_MSK         0x02
+
+#define DMA_STATUS_BUSY_MSK     0x01
+
+// Descriptor (5 bytes, in a memory reachable by the DMA : RAM_GLO)
+#define DMA_DESC_SRC            0x0
+#define DMA_DESC_DST            0x1
+#define DMA_DESC_LEN            0x2
+#define DMA_DESC_CTRL           0x3
+#define DMA_DESC_NEXT           0x4
+#define DMA_DESC_SIZE           5
+
+#define DMA_CTRL_SRC_INC        0x01
+#define DMA_CTRL_DST_INC        0x02
+#define DMA_CTRL_IT             0x04
+
+#define DMA_DESC_LAST           0x00
+
+// Copy memory to memory, memory to a data register and a data register to memory
+#define DMA_CTRL_MEM2MEM        (DMA_CTRL_SRC_INC|DMA_CTRL_DST_INC)
+#define DMA_CTRL_MEM2REG        (DMA_CTRL_SRC_INC)
+#define DMA_CTRL_REG2MEM        (DMA_CTRL_DST_INC)
+
+#define dma_desc_wr(_DESC_,_SRC_,_DST_,_LEN_,_CTRL_,_NEXT_) \
+do {                                                        \
+  PORT_WR(_DESC_,DMA_DESC_SRC ,_SRC_ );                     \
+  PORT_WR(_DESC_,DMA_DESC_DST ,_DST_ );                     \
+  PORT_WR(_DESC_,DMA_DESC_LEN ,_LEN_ );                     \
+  PORT_WR(_DESC_,DMA_DESC_CTRL,_CTRL_);                     \
+  PORT_WR(_DESC_,DMA_DESC_NEXT,_NEXT_);                     \
+ } while (0)
+
+// Start  : run the chain of descriptors (ignored if busy)
+// Busy   : the chain is running
+#define dma_start(_BA_,_DESC_)             PORT_WR(_BA_,DMA_DESC,_DESC_)
+#define dma_busy(_BA_)                     (PORT_RD(_BA_,DMA_STATUS)&DMA_STATUS_BUSY_MSK)
+#define dma_wait(_BA_)                     do {} while (dma_busy(_BA_))
+
+#define dma_it_enable(_BA_,_VALUE_)        PORT_WR(_BA_,DMA_IMR,( (_VALUE_)|PORT_RD(_BA_,DMA_IMR)))
+#define dma_it_disable(_BA_,_VALUE_)       PORT_WR(_BA_,DMA_IMR,(~(_VALUE_)&PORT_RD(_BA_,DMA_IMR)))
+#define dma_isr(_BA_)                      PORT_RD(_BA_,DMA_ISR)
+#define dma_clr(_BA_,_DATA_)               PORT_WR(_BA_,DMA_ISR,_DATA_)
+
+#endif
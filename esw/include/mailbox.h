@@ -6,7 +6,10 @@
 // Author     : mrosiere
 //-----------------------------------------------------------------------------
 // Description:
-// Interface for Mailbox FIFO management.
+// Interface for Mailbox FIFO management (see hdl/sbi_mailbox_it.vhd).
+// A push waits while the FIFO is full, a pop waits while the FIFO is empty.
+// The interruption of a FIFO (GIC_MAILBOX<n>_MSK) is set while its level is
+// greater or equal to its watermark : the receiver enables it in its GIC.
 //-----------------------------------------------------------------------------
 // Copyright (c) 2026
 //-----------------------------------------------------------------------------
@@ -14,12 +17,21 @@
 // Date        Version  Author   Description
 // 2026-05-31  1.0      mrosiere Created
 // 2026-06-26  1.1      mrosiere Use include from regtool
+// 2026-10-17  1.2      mrosiere Add fill level and watermark
 //-----------------------------------------------------------------------------
 
 #ifndef _mailbox_h_
 #define _mailbox_h_
 
-#include "mailbox_csr.h"
+// Registers
+#define MAILBOX_FIFO0           0x0
+#define MAILBOX_FIFO1           0x1
+#define MAILBOX_LEVEL0          0x2
+#define MAILBOX_LEVEL1          0x3
+
+// Watermark 0 disables the interruption, 1 is "not empty"
+#define MAILBOX_WATERMARK_DISABLE   0
+#define MAILBOX_WATERMARK_NOT_EMPTY 1
 
 // Push: Writes data to the specified FIFO (_ID_: 0 or 1)
 #define mailbox_push(_BA_, _ID_, _VAL_) PORT_WR(_BA_, MAILBOX_FIFO##_ID_, _VAL_)
@@ -28,4 +40,10 @@
 #define mailbox_pop(_BA_, _ID_)         PORT_RD(_BA_, MAILBOX_FIFO##_ID_)
 #define mailbox_pop0(_BA_)              mailbox_pop(_BA_, 0)
 
+// Level: Number of bytes in the specified FIFO
+#define mailbox_level(_BA_, _ID_)       PORT_RD(_BA_, MAILBOX_LEVEL##_ID_)
+
+// Watermark: Interruption while the level of the FIFO is >= _VAL_
+#define mailbox_watermark(_BA_, _ID_, _VAL_) PORT_WR(_BA_, MAILBOX_LEVEL##_ID_, _VAL_)
+
 #endif
\ No newline at end of file
@@ -0,0 +1,195 @@
+//-----------------------------------------------------------------------------
+// Title      : Memory routines
+// Project    : Asylum
+//-----------------------------------------------------------------------------
+// File       : mem.h
+// Author     : mrosiere
+//-----------------------------------------------------------------------------
+// Description:
+// Copy, fill, compare and length of buffers in the data memory. The
+// buffers are given by their address on the bus (like PORT_RD / PORT_WR),
+// the length in bytes.
+// * mem_cpy : copy len bytes from src to dst (no overlap)
+// * mem_set : fill len bytes of dst with val
+// * mem_cmp : 0 if the len bytes of a and b are equal, else the difference
+//             of the first different bytes (a - b)
+// * str_len : bytes before the first 0 of the string at src
+// RISC-V : when the addresses are aligned on 4 bytes, the words are
+// accessed by one load / store (4 words per loop), the bytes after the last
+// word are accessed one by one. PicoBlaze : byte loops.
+// Used by user_mem_bench.c : user_modbus_rtu.c and user_xmodem.c stream
+// the bytes between the peripherals and don't copy buffers.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026
+//-----------------------------------------------------------------------------
+// Revisions  :
+// Date        Version  Author   Description
+// 2026-10-17  1.0      mrosiere Created
+// 2026-10-17  1.1      mrosiere Fix signed overflow in mem_set
+// 2026-10-17  1.2      mrosiere Comment on the users
+//-----------------------------------------------------------------------------
+
+#ifndef _mem_h_
+#define _mem_h_
+
+#include <stdint.h>
+
+#ifndef picoblaze
+#define DMEM32               ((volatile uint32_t*)0)
+
+#define MEM_ALIGNED(_A_)     (((_A_) & 0x3) == 0)
+
+// Word of the data memory at the address _A_ (aligned)
+#define MEM_WR32(_A_,_DATA_) DMEM32[(_A_)>>2] = (_DATA_)
+#define MEM_RD32(_A_)        DMEM32[(_A_)>>2]
+#endif
+
+//--------------------------------------
+// mem_cpy
+//--------------------------------------
+void mem_cpy(uint8_t dst,
+             uint8_t src,
+             uint8_t len)
+{
+#ifndef picoblaze
+  if (MEM_ALIGNED(dst|src))
+    {
+      // 4 words per loop
+      while (len >= 16)
+        {
+          MEM_WR32(dst   ,MEM_RD32(src   ));
+          MEM_WR32(dst+ 4,MEM_RD32(src+ 4));
+          MEM_WR32(dst+ 8,MEM_RD32(src+ 8));
+          MEM_WR32(dst+12,MEM_RD32(src+12));
+          dst += 16;
+          src += 16;
+          len -= 16;
+        }
+
+      while (len >= 4)
+        {
+          MEM_WR32(dst,MEM_RD32(src));
+          dst += 4;
+          src += 4;
+          len -= 4;
+        }
+    }
+#endif
+
+  while (len != 0)
+    {
+      PORT_WR(dst,0,PORT_RD(src,0));
+      dst ++;
+      src ++;
+      len --;
+    }
+}
+
+//--------------------------------------
+// mem_set
+//--------------------------------------
+void mem_set(uint8_t dst,
+             uint8_t val,
+             uint8_t len)
+{
+#ifndef picoblaze
+  if (MEM_ALIGNED(dst))
+    {
+      uint32_t val32 = (uint32_t)val * 0x01010101u;
+
+      // 4 words per loop
+      while (len >= 16)
+        {
+          MEM_WR32(dst   ,val32);
+          MEM_WR32(dst+ 4,val32);
+          MEM_WR32(dst+ 8,val32);
+          MEM_WR32(dst+12,val32);
+          dst += 16;
+          len -= 16;
+        }
+
+      while (len >= 4)
+        {
+          MEM_WR32(dst,val32);
+          dst += 4;
+          len -= 4;
+        }
+    }
+#endif
+
+  while (len != 0)
+    {
+      PORT_WR(dst,0,val);
+      dst ++;
+      len --;
+    }
+}
+
+//--------------------------------------
+// mem_cmp
+//--------------------------------------
+int16_t mem_cmp(uint8_t a,
+                uint8_t b,
+                uint8_t len)
+{
+#ifndef picoblaze
+  // Equal words are skipped, the first different word is compared by bytes
+  if (MEM_ALIGNED(a|b))
+    {
+      while (len >= 4)
+        {
+          if (MEM_RD32(a) != MEM_RD32(b))
+            break;
+          a   += 4;
+          b   += 4;
+          len -= 4;
+        }
+    }
+#endif
+
+  while (len != 0)
+    {
+      uint8_t data_a = PORT_RD(a,0);
+      uint8_t data_b = PORT_RD(b,0);
+
+      if (data_a != data_b)
+        return data_a - data_b;
+
+      a   ++;
+      b   ++;
+      len --;
+    }
+
+  return 0;
+}
+
+//--------------------------------------
+// str_len
+//--------------------------------------
+uint8_t str_len(uint8_t src)
+{
+  uint8_t len = 0;
+
+#ifndef picoblaze
+  // Words without byte at 0 are skipped
+  if (MEM_ALIGNED(src))
+    {
+      uint32_t data;
+
+      while (1)
+        {
+          data = MEM_RD32(src+len);
+          if (((data - 0x01010101) & ~data & 0x80808080) != 0)
+            break;
+          len += 4;
+        }
+    }
+#endif
+
+  while (PORT_RD(src,len) != 0)
+    len ++;
+
+  return len;
+}
+
+#endif
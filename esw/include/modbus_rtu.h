@@ -12,6 +12,7 @@
 // Revisions  :
 // Date        Version  Author   Description
 // 2025-10-18  1.0      mrosiere Created
+// 2026-10-17  1.1      mrosiere Add Write Multiple and Read/Write Multiple Registers
 //-----------------------------------------------------------------------------
 
 #ifndef _MODBUS_RTU_H_
@@ -25,7 +26,9 @@
 typedef enum
   {
    MODBUS_FC_READ_HOLDING_REGISTERS    = 0x03,
-   MODBUS_FC_WRITE_SINGLE_REGISTER     = 0x06
+   MODBUS_FC_WRITE_SINGLE_REGISTER     = 0x06,
+   MODBUS_FC_WRITE_MULTIPLE_REGISTERS  = 0x10,
+   MODBUS_FC_READ_WRITE_REGISTERS      = 0x17
   } ModbusFunctionCode;
 
 // Modbus Error codes
@@ -0,0 +1,53 @@
+//-----------------------------------------------------------------------------
+// Title      : Macro for modbus rtu accelerator
+// Project    : Asylum
+//-----------------------------------------------------------------------------
+// File       : modbus_rtu_hw.h
+// Author     : mrosiere
+//-----------------------------------------------------------------------------
+// Description:
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026
+//-----------------------------------------------------------------------------
+// Revisions  :
+// Date        Version  Author   Description
+// 2026-10-17  1.0      mrosiere Created
+//-----------------------------------------------------------------------------
+
+#ifndef _modbus_rtu_hw_h_
+#define _modbus_rtu_hw_h_
+
+// Registers (see hdl/sbi_modbus_rtu.vhd)
+#define MODBUS_RTU_ISR              0x0
+#define MODBUS_RTU_IMR              0x1
+#define MODBUS_RTU_CTRL             0x2
+#define MODBUS_RTU_SLAVE_ID         0x3
+#define MODBUS_RTU_LEN              0x4
+#define MODBUS_RTU_DATA             0x5
+#define MODBUS_RTU_CNT_DROP         0x6
+#define MODBUS_RTU_CNT_CRC          0x7
+
+#define MODBUS_RTU_IT_VALID_MSK     0x01
+
+#define MODBUS_RTU_CTRL_ENABLE      0x01
+#define MODBUS_RTU_CTRL_BROADCAST   0x02
+
+#define modbus_rtu_rd(_BA_,_ADDR_)         PORT_RD(_BA_,MODBUS_RTU_##_ADDR_)
+#define modbus_rtu_wr(_BA_,_ADDR_,_DATA_)  PORT_WR(_BA_,MODBUS_RTU_##_ADDR_,_DATA_)
+
+// Setup  : slave address, enable the frame filter and accept broadcast
+#define modbus_rtu_setup(_BA_,_ID_)        do {PORT_WR(_BA_,MODBUS_RTU_SLAVE_ID,_ID_);PORT_WR(_BA_,MODBUS_RTU_CTRL,MODBUS_RTU_CTRL_ENABLE|MODBUS_RTU_CTRL_BROADCAST);} while (0)
+
+// Valid  : a frame with a good CRC is in the buffer
+// Len    : number of bytes of the frame (CRC included)
+// Getc   : read the next byte of the frame (0 after the end)
+// Release: free the buffer for the next frame
+#define modbus_rtu_valid(_BA_)             (PORT_RD(_BA_,MODBUS_RTU_ISR)&MODBUS_RTU_IT_VALID_MSK)
+#define modbus_rtu_len(_BA_)               PORT_RD(_BA_,MODBUS_RTU_LEN)
+#define modbus_rtu_getc(_BA_)              PORT_RD(_BA_,MODBUS_RTU_DATA)
+#define modbus_rtu_release(_BA_)           PORT_WR(_BA_,MODBUS_RTU_ISR,MODBUS_RTU_IT_VALID_MSK)
+
+#define modbus_rtu_it_enable(_BA_)         PORT_WR(_BA_,MODBUS_RTU_IMR,MODBUS_RTU_IT_VALID_MSK)
+#define modbus_rtu_it_disable(_BA_)        PORT_WR(_BA_,MODBUS_RTU_IMR,0x00)
+
+#endif
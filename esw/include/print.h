@@ -0,0 +1,207 @@
+//-----------------------------------------------------------------------------
+// Title      : Lightweight print on uart
+// Project    : Asylum
+//-----------------------------------------------------------------------------
+// File       : print.h
+// Author     : mrosiere
+//-----------------------------------------------------------------------------
+// Description:
+// print_char  : send a char into uart
+// print_crlf  : send "\r\n" into uart
+// print_str   : send a string (until '\0') into uart (not on picoblaze :
+//               no data in the instruction ROM, the strings are printed
+//               char by char with print_char)
+// print_hex8  : send a byte in hexadecimal into uart
+// print_hex16 : send a half word in hexadecimal into uart
+// print_hex32 : send a word in hexadecimal into uart
+//
+// Unlike puthex, the print functions are not expanded at each call site.
+// Must be included after addrmap_user.h.
+//
+// With UART_TX_IT, print_char push the char in a ring buffer and the
+// buffer is drained by the UART TX interruption :
+// * print_tx_isr must be called by the ISR when GIC_UART_MSK is set
+// * print_flush wait until all chars are given to the uart
+// print_char wait only if the ring buffer is full. The ring buffer must
+// only be filled by the main loop (not by the ISR). The ring buffer is
+// local to the CPU : UART_TX_IT is not for several CPUs sharing the uart.
+// print_char masks the UART in the GIC during the update of the ring
+// buffer and restores the previous mask : the interruptions of the CPU are
+// not enabled by print_char (it can be called before interrupt_enable).
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026
+//-----------------------------------------------------------------------------
+// Revisions  :
+// Date        Version  Author   Description
+// 2026-10-17  1.0      mrosiere Created
+// 2026-10-17  1.1      mrosiere Restore the UART mask in print_char
+//                               No print_str on picoblaze, add print_crlf
+//-----------------------------------------------------------------------------
+
+#ifndef _print_h_
+#define _print_h_
+
+#include <stdint.h>
+
+//--------------------------------------
+// TX Ring Buffer
+//--------------------------------------
+#ifdef UART_TX_IT
+
+#ifndef PRINT_TX_BUFFER_SIZE
+#define PRINT_TX_BUFFER_SIZE 16 // Must be a power of 2
+#endif
+#define PRINT_TX_BUFFER_MSK  (PRINT_TX_BUFFER_SIZE-1)
+
+#ifdef picoblaze
+// RAM_LOC is not used by the compiler : the buffer is mapped on its end
+#define PRINT_TX_BUFFER_BA                (RAM_LOC+0x80-PRINT_TX_BUFFER_SIZE)
+#define print_tx_buffer_wr(_PTR_,_DATA_)  PORT_WR(PRINT_TX_BUFFER_BA,(_PTR_)&PRINT_TX_BUFFER_MSK,_DATA_)
+#define print_tx_buffer_rd(_PTR_)         PORT_RD(PRINT_TX_BUFFER_BA,(_PTR_)&PRINT_TX_BUFFER_MSK)
+#else
+// RAM_LOC contains data and stack : the compiler place the buffer
+volatile uint8_t print_tx_buffer[PRINT_TX_BUFFER_SIZE];
+#define print_tx_buffer_wr(_PTR_,_DATA_)  print_tx_buffer[(_PTR_)&PRINT_TX_BUFFER_MSK] = (_DATA_)
+#define print_tx_buffer_rd(_PTR_)         print_tx_buffer[(_PTR_)&PRINT_TX_BUFFER_MSK]
+#endif
+
+// Free running pointers : wr_ptr is only written by print_char, rd_ptr only by print_tx_drain
+volatile uint8_t print_tx_wr_ptr;
+volatile uint8_t print_tx_rd_ptr;
+
+#define print_tx_empty()        (print_tx_wr_ptr == print_tx_rd_ptr)
+#define print_tx_full()         ((uint8_t)(print_tx_wr_ptr-print_tx_rd_ptr) == PRINT_TX_BUFFER_SIZE)
+
+//--------------------------------------
+// print_tx_drain
+// Give chars to the uart until the ring buffer is empty or the uart TX is full
+// Disable the UART TX interruption when the ring buffer is empty
+//--------------------------------------
+void print_tx_drain()
+{
+  while (!print_tx_empty())
+    {
+      // UART ISR : TX_FULL is set while the TX FIFO is full
+      gic_clr(UART,UART_IT_TX_FULL_MSK);
+      if (gic_get(UART) & UART_IT_TX_FULL_MSK)
+        return;
+
+      uart_wr(UART,print_tx_buffer_rd(print_tx_rd_ptr));
+      print_tx_rd_ptr ++;
+    }
+
+  gic_it_disable(UART,UART_IT_TX_EMPTY_B_MSK);
+}
+
+//--------------------------------------
+// print_tx_isr
+// (ISR) Drain the ring buffer and ack the UART TX interruption
+//--------------------------------------
+void print_tx_isr()
+{
+  if (gic_get(UART) & UART_IT_TX_EMPTY_B_MSK)
+    {
+      print_tx_drain();
+      gic_clr(UART,UART_IT_TX_EMPTY_B_MSK);
+    }
+}
+
+//--------------------------------------
+// print_char
+// Push the char in the ring buffer and restart the drain if it was idle
+//--------------------------------------
+void print_char(uint8_t c)
+{
+  uint8_t gic_uart;
+
+  // Wait a free place, the ISR drains the ring buffer
+  while (print_tx_full());
+
+  print_tx_buffer_wr(print_tx_wr_ptr,c);
+
+  // Critical section with the UART ISR
+  gic_uart = gic_imr(GIC) & GIC_UART_MSK;
+  gic_it_disable(GIC,GIC_UART_MSK);
+
+  print_tx_wr_ptr ++;
+  if ((gic_imr(UART) & UART_IT_TX_EMPTY_B_MSK) == 0)
+    {
+      // Drain is idle : give the first chars then let the ISR continue
+      print_tx_drain();
+      if (!print_tx_empty())
+        gic_it_enable(UART,UART_IT_TX_EMPTY_B_MSK);
+    }
+
+  if (gic_uart)
+    gic_it_enable(GIC,GIC_UART_MSK);
+}
+
+#define print_setup()           do {print_tx_wr_ptr = 0; print_tx_rd_ptr = 0; gic_it_enable(GIC,GIC_UART_MSK);} while (0)
+#define print_flush()           while (!print_tx_empty())
+
+#else
+
+#define print_char(_byte_)      putchar(_byte_)
+#define print_tx_isr()          do {} while (0)
+#define print_setup()           do {} while (0)
+#define print_flush()           do {} while (0)
+
+#endif
+
+//--------------------------------------
+// Hexadecimal
+//--------------------------------------
+#ifndef picoblaze
+const char print_hex_table[16] = "0123456789ABCDEF";
+#endif
+
+void print_nibble(uint8_t x)
+{
+#ifdef picoblaze
+  // No data in the instruction ROM : compute the ascii code
+  if (x>9)
+    x += 'A'-10;
+  else
+    x += '0';
+  print_char(x);
+#else
+  print_char(print_hex_table[x]);
+#endif
+}
+
+void print_hex8(uint8_t x)
+{
+  print_nibble(x>>4);
+  print_nibble(x&0x0F);
+}
+
+void print_hex16(uint16_t x)
+{
+  print_hex8((x>>8)&0xFF);
+  print_hex8((x   )&0xFF);
+}
+
+void print_hex32(uint32_t x)
+{
+  print_hex16((x>>16)&0xFFFF);
+  print_hex16((x    )&0xFFFF);
+}
+
+//--------------------------------------
+// String
+//--------------------------------------
+void print_crlf()
+{
+  print_char('\r');
+  print_char('\n');
+}
+
+#ifndef picoblaze
+void print_str(const char * s)
+{
+  while (*s != '\0')
+    print_char(*s++);
+}
+#endif
+
+#endif
@@ -0,0 +1,117 @@
+//-----------------------------------------------------------------------------
+// Title      : Single producer / single consumer rings between CPUs
+// Project    : Asylum
+//-----------------------------------------------------------------------------
+// File       : ring.h
+// Author     : mrosiere
+//-----------------------------------------------------------------------------
+// Description:
+// Ring of fixed size slots in the shared memory (RAM_GLO or RAM_GLO_HI).
+// The producer fills a slot in place then sends its index in a mailbox
+// FIFO, the consumer gets the index from the mailbox, uses the slot in
+// place then releases it : the data are never copied and only one byte
+// goes through the mailbox per slot.
+// * ring_init    : set the ring at the address ring (producer, once)
+// * ring_alloc   : address of the next free slot, RING_FULL if no slot
+//                  (producer)
+// * ring_send    : publish the slot given by ring_alloc in the mailbox
+//                  FIFO _ID_ (producer)
+// * ring_recv    : address of the next published slot, waits on the
+//                  mailbox FIFO _ID_ (consumer)
+// * ring_release : release the oldest published slot (consumer)
+// HEAD is only written by the producer and TAIL by the consumer : no lock.
+// One mailbox FIFO per ring, the FIFO must be as deep as the number of
+// slots. The consumer can wait with the interruption of the FIFO
+// (mailbox_watermark and GIC_MAILBOX<n>_MSK).
+// Must be included after addrmap_user.h.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026
+//-----------------------------------------------------------------------------
+// Revisions  :
+// Date        Version  Author   Description
+// 2026-10-17  1.0      mrosiere Created
+//-----------------------------------------------------------------------------
+
+#ifndef _ring_h_
+#define _ring_h_
+
+#include <stdint.h>
+
+// Header of the ring, followed by the slots
+#define RING_HEAD            0x0 // Number of published slots (modulo 256)
+#define RING_TAIL            0x1 // Number of released  slots (modulo 256)
+#define RING_MASK            0x2 // Number of slots - 1, number of slots is a power of 2
+#define RING_SLOT_SIZE       0x3 // Size of a slot in bytes
+#define RING_HEADER_SIZE     4
+
+// Size of a ring in the shared memory
+#define RING_SIZE(_NB_SLOT_,_SLOT_SIZE_) (RING_HEADER_SIZE+(_NB_SLOT_)*(_SLOT_SIZE_))
+
+// The shared memory is never at the address 0
+#define RING_FULL            0x00
+
+#define ring_used(_RING_)    ((uint8_t)(PORT_RD(_RING_,RING_HEAD)-PORT_RD(_RING_,RING_TAIL)))
+
+#define ring_send(_RING_,_ID_)  mailbox_push(MAILBOX,_ID_,ring_publish(_RING_))
+#define ring_recv(_RING_,_ID_)  ring_slot(_RING_,mailbox_pop(MAILBOX,_ID_))
+
+//--------------------------------------
+// ring_init
+//--------------------------------------
+void ring_init(uint8_t ring,
+               uint8_t nb_slot,
+               uint8_t slot_size)
+{
+  PORT_WR(ring,RING_HEAD     ,0);
+  PORT_WR(ring,RING_TAIL     ,0);
+  PORT_WR(ring,RING_MASK     ,nb_slot-1);
+  PORT_WR(ring,RING_SLOT_SIZE,slot_size);
+}
+
+//--------------------------------------
+// ring_slot
+// Address of the slot idx
+//--------------------------------------
+uint8_t ring_slot(uint8_t ring,
+                  uint8_t idx)
+{
+  return ring+RING_HEADER_SIZE+idx*PORT_RD(ring,RING_SLOT_SIZE);
+}
+
+//--------------------------------------
+// ring_alloc
+// Address of the slot at HEAD, RING_FULL if all slots are in use
+//--------------------------------------
+uint8_t ring_alloc(uint8_t ring)
+{
+  uint8_t head = PORT_RD(ring,RING_HEAD);
+
+  if ((uint8_t)(head-PORT_RD(ring,RING_TAIL)) > PORT_RD(ring,RING_MASK))
+    return RING_FULL;
+
+  return ring_slot(ring,head&PORT_RD(ring,RING_MASK));
+}
+
+//--------------------------------------
+// ring_publish
+// Give the slot at HEAD to the consumer, return its index
+//--------------------------------------
+uint8_t ring_publish(uint8_t ring)
+{
+  uint8_t head = PORT_RD(ring,RING_HEAD);
+
+  PORT_WR(ring,RING_HEAD,head+1);
+
+  return head&PORT_RD(ring,RING_MASK);
+}
+
+//--------------------------------------
+// ring_release
+// Give back the slot at TAIL to the producer
+//--------------------------------------
+void ring_release(uint8_t ring)
+{
+  PORT_WR(ring,RING_TAIL,PORT_RD(ring,RING_TAIL)+1);
+}
+
+#endif
@@ -13,6 +13,8 @@
 // Date        Version  Author   Description
 // 2025-06-14  1.0      mrosiere Created
 // 2026-06-26  1.1      mrosiere Use include from regtool
+// 2026-10-17  1.2      mrosiere Add Fast Read
+// 2026-10-17  1.3      mrosiere Add Dual/Quad SPI (sbi_spi_quad)
 //-----------------------------------------------------------------------------
 
 #ifndef _spi_h_
@@ -21,6 +23,11 @@
 #include "SPI_csr.h"
  
 #define SPI_SINGLE_READ           0x03
+#define SPI_FAST_READ             0x0B
+#define SPI_DUAL_OUTPUT_READ      0x3B
+#define SPI_QUAD_OUTPUT_READ      0x6B
+#define SPI_QUAD_IO_READ          0xEB
+#define SPI_QUAD_PAGE_PROGRAM     0x32
 #define SPI_SFDP                  0x5A
 #define SPI_PAGE_PROGRAM          0x02
 #define SPI_WRITE_ENABLE          0x06
@@ -36,6 +43,17 @@
 #define SPI_LAST                  1
 #define SPI_CONTINUE              0
 
+#define SPI_CMD_LEN_MAX           32 // Number of bytes of one command (LEN+1)
+#define SPI_FAST_READ_DUMMY       1  // Number of dummy bytes (8 cycles each) after the address
+#define SPI_QUAD_IO_READ_DUMMY    2  // Number of dummy bytes (2 cycles each in quad) after the mode byte
+
+// Bus width of the next commands (CFG[5:4], only with sbi_spi_quad)
+#define SPI_CFG_WIDTH             4
+#define SPI_CFG_WIDTH_MSK         0x30
+#define SPI_WIDTH_SINGLE          0
+#define SPI_WIDTH_DUAL            1
+#define SPI_WIDTH_QUAD            2
+
 #ifdef HAVE_SPI
 
 #define spi_setup(_BA_,_CPOL_,_CPHA_,_LOOPBACK_) \
@@ -80,6 +98,41 @@
   spi_tx(_BA_ ,_ADDR_>>0);\
   } while (0)
 
+// Bus width of the commands written after this one
+// (a command with TX drives the IOs, a command without TX samples the IOs)
+#define spi_width(_BA_,_WIDTH_) \
+  PORT_WR(_BA_,SPI_CFG,(PORT_RD(_BA_,SPI_CFG)&~SPI_CFG_WIDTH_MSK)|((_WIDTH_)<<SPI_CFG_WIDTH))
+
+// Instruction, 24b address then dummy bytes (ex : Fast Read)
+#define spi_inst24_dummy(_BA_,_INSTRUCTION_,_ADDR_,_DUMMY_,_LAST_) \
+  do { \
+  uint8_t _dummy_;\
+  spi_cmd(_BA_,1,0,_LAST_,3+(_DUMMY_));\
+  spi_tx(_BA_ ,_INSTRUCTION_);\
+  spi_tx(_BA_ ,(_ADDR_)>>16);\
+  spi_tx(_BA_ ,(_ADDR_)>>8);\
+  spi_tx(_BA_ ,(_ADDR_)>>0);\
+  for (_dummy_=0; _dummy_<(_DUMMY_); _dummy_++)\
+    spi_tx(_BA_ ,0x00);\
+  } while (0)
+
+// Instruction in single, then 24b address, mode and dummy bytes in quad (Quad I/O Read)
+// The bus width stays in quad for the data
+#define spi_inst24_quad_io(_BA_,_INSTRUCTION_,_ADDR_,_LAST_) \
+  do { \
+  uint8_t _dummy_;\
+  spi_width(_BA_,SPI_WIDTH_SINGLE);\
+  spi_inst(_BA_,_INSTRUCTION_,SPI_CONTINUE);\
+  spi_width(_BA_,SPI_WIDTH_QUAD);\
+  spi_cmd(_BA_,1,0,_LAST_,3+1+SPI_QUAD_IO_READ_DUMMY-1);\
+  spi_tx(_BA_ ,(_ADDR_)>>16);\
+  spi_tx(_BA_ ,(_ADDR_)>>8);\
+  spi_tx(_BA_ ,(_ADDR_)>>0);\
+  spi_tx(_BA_ ,0x00);\
+  for (_dummy_=0; _dummy_<SPI_QUAD_IO_READ_DUMMY; _dummy_++)\
+    spi_tx(_BA_ ,0x00);\
+  } while (0)
+
 
 #else
 
@@ -87,6 +140,9 @@
 #define spi_cmd(_BA_,_TX_,_RX_,_LAST_,_LEN_)	     do {} while (0)
 #define spi_inst(_BA_,_INSTRUCTION_,_LAST_)          do {} while (0)
 #define spi_inst24(_BA_,_INSTRUCTION_,_ADDR_,_LAST_) do {} while (0)
+#define spi_inst24_dummy(_BA_,_INSTRUCTION_,_ADDR_,_DUMMY_,_LAST_) do {} while (0)
+#define spi_inst24_quad_io(_BA_,_INSTRUCTION_,_ADDR_,_LAST_) do {} while (0)
+#define spi_width(_BA_,_WIDTH_)                      do {} while (0)
 #define spi_tx(_BA_,_DATA_)	                     do {} while (0)
 #define spi_rx(_BA_) 0
 
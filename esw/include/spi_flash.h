@@ -0,0 +1,189 @@
+//-----------------------------------------------------------------------------
+// Title      : Read and program of spi flash
+// Project    : Asylum
+//-----------------------------------------------------------------------------
+// File       : spi_flash.h
+// Author     : mrosiere
+//-----------------------------------------------------------------------------
+// Description:
+// spi_flash_read    : copy len bytes of the flash at addr into the ICN2
+//                     memory at dst (RAM_GLO, RAM_LOC, ...)
+// spi_flash_wait    : wait the end of the program or erase in progress
+// spi_flash_erase   : erase the sector (64KB) at addr and wait its end
+// spi_flash_program : program len bytes of the ICN2 memory at src into
+//                     the flash at addr. The bytes must be in the same page
+//                     (256 bytes). spi_flash_program doesn't wait the end of
+//                     the program : the CPU is free during the program and
+//                     must call spi_flash_wait before the next access to the
+//                     flash.
+// spi_flash_program_begin : start the program of len bytes (1 to
+//                     SPI_CMD_LEN_MAX, in the same page) at addr. The bytes
+//                     are then given one by one with spi_tx, at the pace of
+//                     the CPU (the chip select is held) : the flash programs
+//                     after the last byte.
+//
+// The read is done with Fast Read. With SPI_FLASH_WIDTH (sbi_spi_quad),
+// the data are received in dual (Dual Output Read) or quad (Quad Output
+// Read, the QE bit of the flash must be set). The data are received by bursts of
+// SPI_BURST_LEN bytes, one spi_cmd per burst : the chip select is held
+// between the bursts (SPI_CONTINUE) and released after the last one.
+// SPI_BURST_LEN must not be greater than SPI_CMD_LEN_MAX. While the CPU
+// empties the RX FIFO (SPI_DEPTH_RX), the SPI continue the burst.
+// Must be included after addrmap_user.h.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026
+//-----------------------------------------------------------------------------
+// Revisions  :
+// Date        Version  Author   Description
+// 2026-10-17  1.0      mrosiere Created
+// 2026-10-17  1.1      mrosiere Add program and erase
+// 2026-10-17  1.2      mrosiere Add spi_flash_program_begin
+//-----------------------------------------------------------------------------
+
+#ifndef _spi_flash_h_
+#define _spi_flash_h_
+
+#include <stdint.h>
+
+#ifndef SPI_BURST_LEN
+#define SPI_BURST_LEN        SPI_CMD_LEN_MAX
+#endif
+
+#ifndef SPI_FLASH_WIDTH
+#define SPI_FLASH_WIDTH      SPI_WIDTH_SINGLE
+#endif
+
+#if   SPI_FLASH_WIDTH == SPI_WIDTH_QUAD
+#define SPI_FLASH_READ       SPI_QUAD_OUTPUT_READ
+#elif SPI_FLASH_WIDTH == SPI_WIDTH_DUAL
+#define SPI_FLASH_READ       SPI_DUAL_OUTPUT_READ
+#else
+#define SPI_FLASH_READ       SPI_FAST_READ
+#endif
+
+#define SPI_FLASH_SR1_WIP     0x01 // Write In Progress
+#define SPI_FLASH_PAGE_SIZE   256
+#define SPI_FLASH_SECTOR_SIZE 0x10000
+
+#ifdef HAVE_SPI
+
+//--------------------------------------
+// spi_flash_read
+//--------------------------------------
+void spi_flash_read(uint32_t addr,
+                    uint8_t  dst,
+                    uint8_t  len)
+{
+  uint8_t burst;
+
+  if (len == 0)
+    return;
+
+  // Instruction, address and dummy in single, data in SPI_FLASH_WIDTH
+  spi_inst24_dummy(SPI,SPI_FLASH_READ,addr,SPI_FAST_READ_DUMMY,SPI_CONTINUE);
+#if SPI_FLASH_WIDTH != SPI_WIDTH_SINGLE
+  spi_width(SPI,SPI_FLASH_WIDTH);
+#endif
+
+  do
+    {
+      burst = (len > SPI_BURST_LEN)?SPI_BURST_LEN:len;
+      len  -= burst;
+
+      spi_cmd(SPI,SPI_TX_DISABLE,SPI_RX_ENABLE,(len == 0)?SPI_LAST:SPI_CONTINUE,burst-1);
+
+      do
+        {
+          PORT_WR(dst,0,spi_rx(SPI));
+          dst ++;
+        }
+      while (--burst != 0);
+    }
+  while (len != 0);
+
+#if SPI_FLASH_WIDTH != SPI_WIDTH_SINGLE
+  spi_width(SPI,SPI_WIDTH_SINGLE);
+#endif
+}
+
+//--------------------------------------
+// spi_flash_wait
+//--------------------------------------
+void spi_flash_wait()
+{
+  uint8_t sr1;
+
+  do
+    {
+      spi_inst(SPI,SPI_READ_SR1,SPI_CONTINUE);
+      spi_cmd (SPI,SPI_TX_DISABLE,SPI_RX_ENABLE,SPI_LAST,1-1);
+      sr1 = spi_rx(SPI);
+    }
+  while (sr1 & SPI_FLASH_SR1_WIP);
+}
+
+//--------------------------------------
+// spi_flash_erase
+//--------------------------------------
+void spi_flash_erase(uint32_t addr)
+{
+  spi_inst  (SPI,SPI_WRITE_ENABLE,SPI_LAST);
+  spi_inst24(SPI,SPI_SECTOR_ERASE,addr,SPI_LAST);
+
+  spi_flash_wait();
+}
+
+//--------------------------------------
+// spi_flash_program
+//--------------------------------------
+void spi_flash_program(uint32_t addr,
+                       uint8_t  src,
+                       uint8_t  len)
+{
+  uint8_t burst;
+
+  if (len == 0)
+    return;
+
+  spi_inst  (SPI,SPI_WRITE_ENABLE,SPI_LAST);
+  spi_inst24(SPI,SPI_PAGE_PROGRAM,addr,SPI_CONTINUE);
+
+  do
+    {
+      burst = (len > SPI_BURST_LEN)?SPI_BURST_LEN:len;
+      len  -= burst;
+
+      spi_cmd(SPI,SPI_TX_ENABLE,SPI_RX_DISABLE,(len == 0)?SPI_LAST:SPI_CONTINUE,burst-1);
+
+      do
+        {
+          spi_tx(SPI,PORT_RD(src,0));
+          src ++;
+        }
+      while (--burst != 0);
+    }
+  while (len != 0);
+}
+
+//--------------------------------------
+// spi_flash_program_begin
+//--------------------------------------
+void spi_flash_program_begin(uint32_t addr,
+                             uint8_t  len)
+{
+  spi_inst  (SPI,SPI_WRITE_ENABLE,SPI_LAST);
+  spi_inst24(SPI,SPI_PAGE_PROGRAM,addr,SPI_CONTINUE);
+  spi_cmd   (SPI,SPI_TX_ENABLE,SPI_RX_DISABLE,SPI_LAST,len-1);
+}
+
+#else
+
+#define spi_flash_read(_ADDR_,_DST_,_LEN_)    do {} while (0)
+#define spi_flash_wait()                      do {} while (0)
+#define spi_flash_erase(_ADDR_)               do {} while (0)
+#define spi_flash_program(_ADDR_,_SRC_,_LEN_) do {} while (0)
+#define spi_flash_program_begin(_ADDR_,_LEN_) do {} while (0)
+
+#endif
+
+#endif
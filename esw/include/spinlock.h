@@ -13,12 +13,15 @@
 // Date        Version  Author   Description
 // 2026-05-30  1.0      mrosiere Created
 // 2026-06-26  1.1      mrosiere Use include from regtool
+// 2026-10-17  1.2      mrosiere Add spinlock_lock, ticket mode
 //-----------------------------------------------------------------------------
 
 #ifndef _spinlock_h_
 #define _spinlock_h_
 
-#include "spinlock_csr.h"
+// Registers (see hdl/sbi_spinlock_mp.vhd)
+#define SPINLOCK_LOCK0               0x0
+#define SPINLOCK_LOCK1               0x1
 
 // Read Set   : Returns 0 if lock acquired (was 0, now set to 1), 1 if already locked.
 #define spinlock_try_lock(_BA_,_ID_) PORT_RD(_BA_,SPINLOCK_LOCK##_ID_)
@@ -26,4 +29,11 @@
 // Write 0 Clear : Release the lock by writing 0.
 #define spinlock_unlock(_BA_,_ID_)   PORT_WR(_BA_,SPINLOCK_LOCK##_ID_,0x00)
 
+// Lock : wait until the lock is acquired.
+// The spinlock is local to each CPU : the retries don't use the ICN2.
+// With SPINLOCK_MODE "ticket", the first try takes a ticket and the lock is
+// given in the order of the tickets : a CPU which gets 1 must try again
+// until it gets the lock (GIC_SPINLOCK_MSK is set when the lock is given).
+#define spinlock_lock(_BA_,_ID_)     while (spinlock_try_lock(_BA_,_ID_) != 0)
+
 #endif
\ No newline at end of file
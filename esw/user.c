@@ -16,10 +16,16 @@
 // 2017-03-30  1.0      mrosiere Created
 // 2025-01-06  1.1      mrosiere Add comments
 // 2025-06-13  1.2      mrosiere Add SPI
+// 2026-10-17  1.3      mrosiere Use print.h, buffered UART TX with UART_TX_IT
+// 2026-10-17  1.4      mrosiere Load table from SPI memory with Fast Read
+// 2026-10-17  1.5      mrosiere Pop the mailbox with its fill level
+// 2026-10-17  1.6      mrosiere Print the strings char by char (picoblaze)
 //-----------------------------------------------------------------------------
 
 #include <stdint.h>
 #include "addrmap_user.h"
+#include "print.h"
+#include "spi_flash.h"
 
 //--------------------------------------
 // Constant
@@ -33,6 +39,10 @@
 
 #define UART_RX_LOOPBACK 0
 
+// Table in SPI memory, loaded in RAM_GLO at boot
+#define SPI_TABLE_ADDR   0x000000
+#define SPI_TABLE_LEN    16
+
 //--------------------------------------
 // Interrupt Sub Routine
 //--------------------------------------
@@ -51,17 +61,27 @@ ISR_FCT
       gic_clr(GIC,GIC_IT_USER_MSK);
     }
 
-  // ... Check if UART RX is not empty
+  // ... Check if UART is active
   if (gic_it_vector & GIC_UART_MSK)
     {
-      // Get UART RX and echo 
-      uint8_t uart_rx = getchar();
-      putchar(uart_rx);
-      
-      //gpio_wr(SWITCH,uart_rx); // Dummy access
+      // ... Check if UART RX is not empty
+      if (gic_get(UART) & UART_IT_RX_EMPTY_B_MSK)
+        {
+          // Get UART RX and echo
+          // (directly : the TX ring buffer is only filled by the main loop)
+          uint8_t uart_rx = getchar();
+          putchar(uart_rx);
+
+          //gpio_wr(SWITCH,uart_rx); // Dummy access
 
-      // Ack the interruption (in UART and in GIC)
-      gic_clr(UART,UART_IT_RX_EMPTY_B_MSK);
+          // Ack the interruption in UART
+          gic_clr(UART,UART_IT_RX_EMPTY_B_MSK);
+        }
+
+      // ... Drain the TX ring buffer
+      print_tx_isr();
+
+      // Ack the interruption in GIC
       gic_clr(GIC,GIC_UART_MSK);
     }
 }
@@ -87,6 +107,10 @@ void setup()
   uart_setup(UART,CLOCK_FREQ,BAUD_RATE,UART_RX_LOOPBACK);
   gic_it_enable(UART,UART_IT_RX_EMPTY_B_MSK);
 
+  // Print
+  // * Reset the TX ring buffer (UART_TX_IT only)
+  print_setup();
+
   // SPI
   // * Configure CPOL / CPHA
   // * Configure SPI Loopback
@@ -115,12 +139,11 @@ void spi_sfdp()
   spi_cmd(SPI,SPI_TX_DISABLE,SPI_RX_ENABLE,SPI_LAST,4-1);
 
   // SFDP_HEADER[0] : SFDP Signature
-  putchar(spi_rx(SPI)); // 7:0
-  putchar(spi_rx(SPI)); // 15:8
-  putchar(spi_rx(SPI)); // 23:16
-  putchar(spi_rx(SPI)); // 31:24
-  putchar('\r');
-  putchar('\n');
+  print_char(spi_rx(SPI)); // 7:0
+  print_char(spi_rx(SPI)); // 15:8
+  print_char(spi_rx(SPI)); // 23:16
+  print_char(spi_rx(SPI)); // 31:24
+  print_crlf();
 }
 
 //--------------------------------------
@@ -178,20 +201,19 @@ void spi_read()
 {
   uint8_t rx;
   
-  spi_inst24(SPI,SPI_SINGLE_READ,0x000000,SPI_CONTINUE);
+  spi_inst24_dummy(SPI,SPI_FAST_READ,0x000000,SPI_FAST_READ_DUMMY,SPI_CONTINUE);
 
   do
     {
       spi_cmd(SPI,SPI_TX_DISABLE,SPI_RX_ENABLE,SPI_CONTINUE,1-1);
       rx = spi_rx(SPI);
-      putchar(rx);
+      print_char(rx);
     }
   while (rx != '\0');
 
   spi_cmd(SPI,SPI_TX_DISABLE,SPI_RX_DISABLE,SPI_LAST,1-1);
         
-  putchar('\r');
-  putchar('\n');
+  print_crlf();
 }
 
 //--------------------------------------
@@ -207,16 +229,6 @@ void spi_sector_erase()
   spi_wait_device_ready();
 }
 
-//--------------------------------------
-// Printf
-//--------------------------------------
-void printf(char * x)
-{
-  uint8_t i=0;
-  while (x[i] != '\0')
-    putchar(x[i++]);
-}
-
 //--------------------------------------
 // Main
 //--------------------------------------
@@ -244,34 +256,50 @@ void main()
   //------------------------------------
 
 #ifdef HAVE_SPI_MEMORY
+  {
+    // Load the table in RAM_GLO (one burst read) and print it
+    uint8_t i;
+
+    spi_flash_read(SPI_TABLE_ADDR,RAM_GLO,SPI_TABLE_LEN);
+
+    print_char('T');
+    print_char('a');
+    print_char('b');
+    print_char('l');
+    print_char('e');
+    print_char(' ');
+    for (i=0; i<SPI_TABLE_LEN; i++)
+      print_hex8(PORT_RD(RAM_GLO,i));
+    print_crlf();
+  }
+
   spi_inst24(SPI,SPI_SINGLE_READ,0x000000,SPI_CONTINUE);
 #endif  
 
-  putchar('W');
-  putchar('e');
-  putchar('l');
-  putchar('c');
-  putchar('o');
-  putchar('m');
-  putchar('e');
-  putchar(' ');
-  putchar('B');
-  putchar('a');
-  putchar('c');
-  putchar('k');
-  putchar(',');
-  putchar(' ');
-  putchar('C');
-  putchar('o');
-  putchar('m');
-  putchar('m');
-  putchar('a');
-  putchar('n');
-  putchar('d');
-  putchar('e');
-  putchar('r');
-  putchar('\r');
-  putchar('\n');
+  print_char('W');
+  print_char('e');
+  print_char('l');
+  print_char('c');
+  print_char('o');
+  print_char('m');
+  print_char('e');
+  print_char(' ');
+  print_char('B');
+  print_char('a');
+  print_char('c');
+  print_char('k');
+  print_char(',');
+  print_char(' ');
+  print_char('C');
+  print_char('o');
+  print_char('m');
+  print_char('m');
+  print_char('a');
+  print_char('n');
+  print_char('d');
+  print_char('e');
+  print_char('r');
+  print_crlf();
 
   while (1)
     {
@@ -281,12 +309,9 @@ void main()
       // Get switch[5]
       if (sw&0x20)
 	{
-	  uint8_t cpt_byte3,cpt_byte2,cpt_byte1,cpt_byte0;
+	  uint8_t cpt_byte0;
 
-	  // Split 32b counter into 4 bytes
-	  cpt_byte3 = (cpt>>24)&0xFF;
-	  cpt_byte2 = (cpt>>16)&0xFF;
-	  cpt_byte1 = (cpt>> 8)&0xFF;
+	  // Get the LSB of 32b counter
 	  cpt_byte0 = (cpt>> 0)&0xFF;
 
 	  // SPI : Read 1 byte
@@ -300,45 +325,42 @@ void main()
 #endif       
 
 	  // Print Message
-	  putchar('L');
-	  putchar('o');
-	  putchar('o');
-	  putchar('p');
-	  putchar(' ');
+	  print_char('L');
+	  print_char('o');
+	  print_char('o');
+	  print_char('p');
+	  print_char(' ');
 
 	  // Print 32b counter
-	  puthex (cpt_byte3);
-	  puthex (cpt_byte2);
-	  puthex (cpt_byte1);
-	  puthex (cpt_byte0);
+	  print_hex32(cpt);
 
 	  // Print 8b Switch
-	  putchar('-');
-	  puthex (sw);
+	  print_char('-');
+	  print_hex8(sw);
 
     {
       // Print SPI Byte @ cpt
       uint8_t spi_byte;
-      putchar('-');
+      print_char('-');
       spi_byte = spi_rx(SPI);
-      puthex (spi_byte);
+      print_hex8(spi_byte);
     }
 
     {
       // Test Spinlock
       uint8_t spinlock;
 
-      putchar(' ');
-      putchar('L');
-      putchar('o');
-      putchar('c');
-      putchar('k');
-      putchar(' ');
+      print_char(' ');
+      print_char('L');
+      print_char('o');
+      print_char('c');
+      print_char('k');
+      print_char(' ');
       spinlock = spinlock_try_lock(SPINLOCK,0);
-      puthex (spinlock);
-      putchar(' ');
+      print_hex8(spinlock);
+      print_char(' ');
       spinlock = spinlock_try_lock(SPINLOCK,0);
-      puthex (spinlock);
+      print_hex8(spinlock);
       spinlock_unlock(SPINLOCK,0);
     }
 
@@ -347,25 +369,26 @@ void main()
       uint8_t mb;
       uint8_t i;
 
-      putchar(' ');
-      putchar('M');
-      putchar('B');
-      putchar('0');
-      putchar(' ');
+      print_char(' ');
+      print_char('M');
+      print_char('B');
+      print_char('0');
+      print_char(' ');
       for (i=0; i<8; i++)
         {
           mailbox_push(MAILBOX,0,i);
         }
-      for (i=0; i<8; i++)
+      print_hex8(mailbox_level(MAILBOX,0));
+      print_char(':');
+      while (mailbox_level(MAILBOX,0) != 0)
         {
           mb = mailbox_pop(MAILBOX,0);
-          puthex(mb);
-          putchar(' ');
+          print_hex8(mb);
+          print_char(' ');
         }
     }
 
-	  putchar('\r');
-	  putchar('\n');
+	  print_crlf();
 
 	  // Increase loop counter
 	  cpt ++;
@@ -0,0 +1,131 @@
+//-----------------------------------------------------------------------------
+// Title      : Boot stub
+// Project    : Asylum
+//-----------------------------------------------------------------------------
+// File       : user_boot.c
+// Author     : mrosiere
+//-----------------------------------------------------------------------------
+// Description:
+// Boot stub in ROM_user (IMEM_RAM must be set) :
+// * SWITCH[0] select the image in the spi flash (0 : BOOT_IMAGE0_ADDR,
+//   1 : BOOT_IMAGE1_ADDR)
+// * Copy the image from the spi flash into the instruction RAM
+// * Check the CRC16 of the image with the CRC
+// * If the image is valid, reset the CPUs and fetch from the instruction RAM
+//   Else, LED1 is the error code and the CPUs stay in the ROM
+// With several CPUs, the first CPU to get the spinlock 0 load the image
+// and the other ones wait the reset.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026
+//-----------------------------------------------------------------------------
+// Revisions  :
+// Date        Version  Author   Description
+// 2026-10-17  1.0      mrosiere Created
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include "addrmap_user.h"
+
+//--------------------------------------
+// Constant
+//--------------------------------------
+#define BOOT_SWITCH_IMAGE_MSK 0x01
+
+#define BOOT_ERR_NONE         0x00
+#define BOOT_ERR_LEN          0x01 // Empty image or greater than the instruction RAM
+#define BOOT_ERR_CRC          0x02 // Corrupted image
+
+//--------------------------------------
+// Interrupt Sub Routine
+//--------------------------------------
+ISR_FCT
+{
+}
+
+//--------------------------------------
+// boot_load
+// Copy the image at addr in the instruction RAM and check its CRC
+//--------------------------------------
+uint8_t boot_load(uint32_t addr)
+{
+  uint16_t len;
+  uint16_t crc;
+  uint8_t  burst;
+  uint8_t  data;
+
+  // Header
+  spi_inst24(SPI,SPI_SINGLE_READ,addr,SPI_CONTINUE);
+  spi_cmd   (SPI,SPI_TX_DISABLE,SPI_RX_ENABLE,SPI_LAST,BOOT_HEADER_SIZE-1);
+  len  =           spi_rx(SPI);
+  len |= ((uint16_t)spi_rx(SPI))<<8;
+  crc  =           spi_rx(SPI);
+  crc |= ((uint16_t)spi_rx(SPI))<<8;
+
+  if ((len == 0) || (len > BOOT_IMAGE_LEN_MAX))
+    return BOOT_ERR_LEN;
+
+  // Instructions : one command per SPI_CMD_LEN_MAX bytes
+  len  *= BOOT_INSTR_BYTES;
+  addr += BOOT_HEADER_SIZE;
+
+  boot_addr(BOOT,0);
+  crc_init (CRC,0xFFFF);
+
+  spi_inst24(SPI,SPI_SINGLE_READ,addr,SPI_CONTINUE);
+
+  do
+    {
+      burst = (len > SPI_CMD_LEN_MAX)?SPI_CMD_LEN_MAX:len;
+      len  -= burst;
+
+      spi_cmd(SPI,SPI_TX_DISABLE,SPI_RX_ENABLE,(len == 0)?SPI_LAST:SPI_CONTINUE,burst-1);
+
+      do
+        {
+          data = spi_rx(SPI);
+          boot_wr (BOOT,data);
+          crc_feed(CRC ,data);
+        }
+      while (--burst != 0);
+    }
+  while (len != 0);
+
+  if (crc_final(CRC) != crc)
+    return BOOT_ERR_CRC;
+
+  return BOOT_ERR_NONE;
+}
+
+//--------------------------------------
+// Main
+//--------------------------------------
+void main()
+{
+  uint8_t err;
+
+  // Only one CPU load the image
+  if (spinlock_try_lock(SPINLOCK,0))
+    while (1);
+
+  gpio_setup(SWITCH,INPUT);
+  gpio_setup(LED1  ,OUTPUT);
+  gpio_wr   (LED1  ,0);
+
+  spi_setup (SPI,0,0,SPI_LOOPBACK_DISABLE);
+
+  if (gpio_rd(SWITCH) & BOOT_SWITCH_IMAGE_MSK)
+    err = boot_load(BOOT_IMAGE1_ADDR);
+  else
+    err = boot_load(BOOT_IMAGE0_ADDR);
+
+  if (err == BOOT_ERR_NONE)
+    {
+      // The application can use the spinlock 0
+      spinlock_unlock(SPINLOCK,0);
+      boot_start(BOOT);
+    }
+
+  gpio_wr(LED1,err);
+
+  while (1);
+}
@@ -0,0 +1,147 @@
+//-----------------------------------------------------------------------------
+// Title      : Benchmark of CRC16 implementations
+// Project    : Asylum
+//-----------------------------------------------------------------------------
+// File       : user_crc_bench.c
+// Author     : mrosiere
+//-----------------------------------------------------------------------------
+// Description:
+// Compute the Modbus CRC16 of CRC_BENCH_LEN bytes with each implementation.
+// The data memory can't contains CRC_BENCH_LEN bytes, so the data are the
+// loop index (the cost is measured by the reference loop).
+// Each implementation is a bench section (see bench.h).
+// LED1 is the number of implementations with a wrong CRC.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026
+//-----------------------------------------------------------------------------
+// Revisions  :
+// Date        Version  Author   Description
+// 2026-10-17  1.0      mrosiere Created
+// 2026-10-17  1.1      mrosiere Add table driven software CRC
+//-----------------------------------------------------------------------------
+
+#include "addrmap_user.h"
+#include "bench.h"
+
+#define CRC_TABLE
+#include "crc16.h"
+
+//--------------------------------------
+// Constant
+//--------------------------------------
+#define CRC_BENCH_LEN        256
+
+#define BENCH_ID_LOOP        0x01 // Empty loop (reference)
+#define BENCH_ID_CRC_SW      0x02 // Software, bitwise
+#define BENCH_ID_CRC_HW_RD   0x03 // Hardware, running value read after each byte
+#define BENCH_ID_CRC_HW      0x04 // Hardware, running value read once (streaming)
+#define BENCH_ID_CRC_TABLE   0x05 // Software, nibble table
+
+volatile uint16_t crc_result;
+
+//--------------------------------------
+// crc16_hw_rd_next
+// Compute one loop of CRC16 and read back the running value
+//--------------------------------------
+uint16_t crc16_hw_rd_next(uint16_t crc,
+                          uint8_t  data)
+{
+  uint8_t byte0;
+  uint8_t byte1;
+
+  crc_wr(CRC,DATA0,data);
+
+  byte1 = crc_rd(CRC,CRC1);
+  byte0 = crc_rd(CRC,CRC0);
+  crc   = ((byte1<<8)|
+           (byte0));
+
+  return crc;
+}
+
+//--------------------------------------
+// Interrupt Sub Routine
+//--------------------------------------
+ISR_FCT
+{
+}
+
+//--------------------------------------
+// Application Setup
+//--------------------------------------
+void setup()
+{
+  bench_setup();
+  crc16_table_init();
+}
+
+//--------------------------------------
+// Main
+//--------------------------------------
+// Arduino Style, Don't modify
+void main()
+{
+  uint16_t i;
+  uint16_t crc;
+  uint16_t crc_exp;
+  uint8_t  errors = 0;
+
+  setup();
+
+  //------------------------------------
+  bench_begin(BENCH_ID_LOOP);
+  crc = 0xFFFF;
+  for (i = 0; i < CRC_BENCH_LEN; i++)
+    crc ^= (uint8_t)i;
+  crc_result = crc;
+  bench_end();
+
+  //------------------------------------
+  bench_begin(BENCH_ID_CRC_SW);
+  crc = 0xFFFF;
+  for (i = 0; i < CRC_BENCH_LEN; i++)
+    crc = crc16_bitwise_next(crc,(uint8_t)i);
+  crc_result = crc;
+  bench_end();
+
+  crc_exp = crc;
+
+  //------------------------------------
+  bench_begin(BENCH_ID_CRC_HW_RD);
+  crc_init(CRC,0xFFFF);
+  crc = 0xFFFF;
+  for (i = 0; i < CRC_BENCH_LEN; i++)
+    crc = crc16_hw_rd_next(crc,(uint8_t)i);
+  crc_result = crc;
+  bench_end();
+
+  if (crc != crc_exp)
+    errors ++;
+
+  //------------------------------------
+  bench_begin(BENCH_ID_CRC_HW);
+  crc_init(CRC,0xFFFF);
+  for (i = 0; i < CRC_BENCH_LEN; i++)
+    crc_feed(CRC,(uint8_t)i);
+  crc = crc_final(CRC);
+  crc_result = crc;
+  bench_end();
+
+  if (crc != crc_exp)
+    errors ++;
+
+  //------------------------------------
+  bench_begin(BENCH_ID_CRC_TABLE);
+  crc = 0xFFFF;
+  for (i = 0; i < CRC_BENCH_LEN; i++)
+    crc = crc16_table_next(crc,(uint8_t)i);
+  crc_result = crc;
+  bench_end();
+
+  if (crc != crc_exp)
+    errors ++;
+
+  bench_exit(errors);
+
+  while (1);
+}
@@ -0,0 +1,189 @@
+//-----------------------------------------------------------------------------
+// Title      : DMA test and benchmark
+// Project    : Asylum
+//-----------------------------------------------------------------------------
+// File       : user_dma.c
+// Author     : mrosiere
+//-----------------------------------------------------------------------------
+// Description:
+// Compare the copy of DMA_BENCH_LEN bytes done by the CPU and by the DMA :
+// * from RAM_GLO to RAM_GLO
+// * from RAM_GLO to the CRC data register
+// Each copy is a bench section (see bench.h).
+// DMA_RAM selects the shared RAM of the descriptors and buffers (RAM_GLO,
+// or RAM_GLO_HI with RAM2_DEPTH = 128).
+// LED1 is the number of wrong copies.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026
+//-----------------------------------------------------------------------------
+// Revisions  :
+// Date        Version  Author   Description
+// 2026-10-17  1.0      mrosiere Created
+// 2026-10-17  1.1      mrosiere Add DMA_RAM
+//-----------------------------------------------------------------------------
+
+#include "addrmap_user.h"
+#include "bench.h"
+#include "crc16.h"
+
+//--------------------------------------
+// Constant
+//--------------------------------------
+#define DMA_BENCH_LEN        16
+
+#ifndef DMA_RAM
+#define DMA_RAM              RAM_GLO
+#endif
+
+// DMA_RAM Mapping
+#define DMA_DESC0            (DMA_RAM+0x00)
+#define DMA_DESC1            (DMA_RAM+0x08)
+#define DMA_BUF_SRC          (DMA_RAM+0x10)
+#define DMA_BUF_DST          (DMA_RAM+0x20)
+
+#define BENCH_ID_COPY_CPU    0x01 // RAM_GLO to RAM_GLO by the CPU
+#define BENCH_ID_COPY_DMA    0x02 // RAM_GLO to RAM_GLO by the DMA (polling)
+#define BENCH_ID_CRC_CPU     0x03 // RAM_GLO to CRC by the CPU
+#define BENCH_ID_CRC_DMA     0x04 // RAM_GLO to RAM_GLO then to CRC by the DMA (interruption)
+
+volatile uint8_t dma_done;
+
+//--------------------------------------
+// check_copy
+// Return 1 if the destination buffer is the source buffer
+//--------------------------------------
+uint8_t check_copy()
+{
+  uint8_t i;
+
+  for (i = 0; i < DMA_BENCH_LEN; i++)
+    if (PORT_RD(DMA_BUF_DST,i) != PORT_RD(DMA_BUF_SRC,i))
+      return 0;
+
+  return 1;
+}
+
+//--------------------------------------
+// clear_copy
+//--------------------------------------
+void clear_copy()
+{
+  uint8_t i;
+
+  for (i = 0; i < DMA_BENCH_LEN; i++)
+    PORT_WR(DMA_BUF_DST,i,0);
+}
+
+//--------------------------------------
+// Interrupt Sub Routine
+//--------------------------------------
+ISR_FCT
+{
+  uint8_t gic_it_vector = gic_isr(GIC);
+
+  if (gic_it_vector & GIC_DMA_MSK)
+    {
+      dma_done = 1;
+
+      dma_clr(DMA,DMA_IT_DONE_MSK);
+      gic_clr(GIC,GIC_DMA_MSK);
+    }
+}
+
+//--------------------------------------
+// Application Setup
+//--------------------------------------
+void setup()
+{
+  uint8_t i;
+
+  bench_setup();
+
+  for (i = 0; i < DMA_BENCH_LEN; i++)
+    PORT_WR(DMA_BUF_SRC,i,0xA5^(i*7));
+
+  clear_copy();
+
+  interrupt_setup(isr);
+}
+
+//--------------------------------------
+// Main
+//--------------------------------------
+// Arduino Style, Don't modify
+void main()
+{
+  uint8_t  i;
+  uint16_t crc;
+  uint16_t crc_exp;
+  uint8_t  errors = 0;
+
+  setup();
+
+  crc_exp = 0xFFFF;
+  for (i = 0; i < DMA_BENCH_LEN; i++)
+    crc_exp = crc16_bitwise_next(crc_exp,PORT_RD(DMA_BUF_SRC,i));
+
+  //------------------------------------
+  bench_begin(BENCH_ID_COPY_CPU);
+  for (i = 0; i < DMA_BENCH_LEN; i++)
+    PORT_WR(DMA_BUF_DST,i,PORT_RD(DMA_BUF_SRC,i));
+  bench_end();
+
+  if (check_copy() == 0)
+    errors ++;
+
+  clear_copy();
+
+  //------------------------------------
+  dma_desc_wr(DMA_DESC0,DMA_BUF_SRC,DMA_BUF_DST,DMA_BENCH_LEN,DMA_CTRL_MEM2MEM,DMA_DESC_LAST);
+
+  bench_begin(BENCH_ID_COPY_DMA);
+  dma_start(DMA,DMA_DESC0);
+  dma_wait (DMA);
+  bench_end();
+
+  dma_clr(DMA,DMA_IT_DONE_MSK);
+
+  if (check_copy() == 0)
+    errors ++;
+
+  //------------------------------------
+  bench_begin(BENCH_ID_CRC_CPU);
+  crc_init(CRC,0xFFFF);
+  for (i = 0; i < DMA_BENCH_LEN; i++)
+    crc_feed(CRC,PORT_RD(DMA_BUF_SRC,i));
+  crc = crc_final(CRC);
+  bench_end();
+
+  if (crc != crc_exp)
+    errors ++;
+
+  //------------------------------------
+  // Chain : copy the buffer then feed the CRC
+  dma_desc_wr(DMA_DESC0,DMA_BUF_SRC,DMA_BUF_DST,DMA_BENCH_LEN,DMA_CTRL_MEM2MEM,DMA_DESC1);
+  dma_desc_wr(DMA_DESC1,DMA_BUF_SRC,CRC+CRC_DATA0,DMA_BENCH_LEN,DMA_CTRL_MEM2REG,DMA_DESC_LAST);
+  clear_copy();
+
+  dma_done = 0;
+  dma_it_enable(DMA,DMA_IT_DONE_MSK);
+  gic_it_enable(GIC,GIC_DMA_MSK);
+  interrupt_enable();
+
+  bench_begin(BENCH_ID_CRC_DMA);
+  crc_init (CRC,0xFFFF);
+  dma_start(DMA,DMA_DESC0);
+  // The CPU is free until the end of the chain
+  while (dma_done == 0);
+  crc = crc_final(CRC);
+  bench_end();
+
+  if (check_copy() == 0)
+    errors ++;
+  if (crc != crc_exp)
+    errors ++;
+
+  bench_exit(errors);
+
+  while (1);
+}
@@ -6,8 +6,12 @@
 // Author     : mrosiere
 //-----------------------------------------------------------------------------
 // Description:
-// Read  switch
-// Write led
+// All the CPUs share HELLO_LOOPS iterations of an atomic counter, then
+// print HELLO_LOCK_LOOPS lines each under the spinlock.
+// At the end, the CPU 0 checks the counters and writes on LED1 the number
+// of CPUs (or HELLO_KO with the errors).
+// With HELLO_FAIRNESS, the iterations of the atomic loop of the CPUs
+// differ by HELLO_FAIRNESS at most.
 //-----------------------------------------------------------------------------
 // Copyright (c) 2021
 //-----------------------------------------------------------------------------
@@ -16,10 +20,17 @@
 // 2017-03-30  1.0      mrosiere Created
 // 2025-01-06  1.1      mrosiere Add comments
 // 2025-06-13  1.2      mrosiere Add SPI
+// 2026-10-17  1.3      mrosiere Use print.h
+// 2026-10-17  1.4      mrosiere Add SPINLOCK_TICKET
+// 2026-10-17  1.5      mrosiere Loop counter with atomic fetch and add
+// 2026-10-17  1.6      mrosiere Setup by the CPU 0, then barrier
+// 2026-10-17  1.7      mrosiere Bounded loops, result checked by the CPU 0 on LED1
+// 2026-10-17  1.8      mrosiere Add HELLO_FAIRNESS
 //-----------------------------------------------------------------------------
 
 #include <stdint.h>
 #include "addrmap_user.h"
+#include "print.h"
 
 static inline uint32_t read_mhartid(void)
 {
@@ -28,18 +39,32 @@ static inline uint32_t read_mhartid(void)
   return id;
 }
 
-typedef struct
-{
-  uint32_t cpt;
-} app_data_t;
-
-#define app_data (*(volatile app_data_t *)RAM_GLO)
-
 //--------------------------------------
 // Constant
 //--------------------------------------
 #define UART_RX_LOOPBACK 0
 
+// Loop counter shared by all the CPUs (reset to 0)
+#define ATOMIC_CELL_CPT  0
+// Number of CPUs at the end of the run (reset to 0)
+#define ATOMIC_CELL_END  1
+
+// Iterations of the atomic loop, shared by all the CPUs
+#define HELLO_LOOPS      64
+// Iterations of the locked loop, for each CPU
+#define HELLO_LOCK_LOOPS 2
+
+// RAM_GLO : iterations of the atomic loop of the CPU i at HELLO_CPT+i,
+// counter of the locked loop (not atomic) at HELLO_LOCK_CPT
+#define HELLO_CPT        0x00
+#define HELLO_LOCK_CPT   0x20
+
+// LED1 at the end : number of CPUs, or HELLO_KO with the errors
+#define HELLO_KO         0x80
+#define HELLO_KO_CPT     0x01 // Sum of the iterations of the atomic loop
+#define HELLO_KO_LOCK    0x02 // Counter of the locked loop
+#define HELLO_KO_FAIR    0x04 // Spread of the iterations of the CPUs (HELLO_FAIRNESS)
+
 //--------------------------------------
 // Interrupt Sub Routine
 //--------------------------------------
@@ -73,6 +98,11 @@ void setup()
   gpio_wr(LED0,0);
   gpio_wr(LED1,0);
 
+  // Counters in RAM_GLO
+  for (uint8_t i=0; i<HELLO_LOCK_CPT; ++i)
+    PORT_WR(RAM_GLO,HELLO_CPT+i,0);
+  PORT_WR(RAM_GLO,HELLO_LOCK_CPT,0);
+
   // UART
   // * Setup the clock frequency and the target Baud Rate
   // * Configurae the Uart RX Loopback
@@ -100,35 +130,48 @@ void setup()
 void main()
 {
   uint32_t cpu_id;
+  uint32_t cpt;
   uint8_t seed; 
 
   // Read the CPU ID
   cpu_id = read_mhartid();
   seed   = (uint8_t)cpu_id;
 
-  while (spinlock_try_lock(SPINLOCK,0) != 0);
-
-  // Try to acquire the lock, if it is already locked, it means it's not the first CPU, so it will not setup the application, just run the loop
-  if (spinlock_try_lock(SPINLOCK,1) == 0)
+  // The CPU 0 setups the application while the other CPUs wait at the
+  // barrier (in reset with BARRIER_HOLD), then all the CPUs start together
+  if (cpu_id == 0)
     {
       setup();
-
-      app_data.cpt = 0;
     }
-  spinlock_unlock(SPINLOCK,0);
+  barrier_wait(BARRIER);
+
+  // The operand of this CPU is kept : each increment is one write
+  atomic_operand(ATOMIC,1);
 
   //------------------------------------
   // Application Run Loop
   //------------------------------------
 
+  // Atomic loop : the CPUs share HELLO_LOOPS iterations, without lock.
+  // Each CPU counts its iterations in RAM_GLO (one access of ICN2)
   while (1)
     {
-      uint32_t cpt;
-      uint8_t  cpt_byte3;
-      uint8_t  cpt_byte2;
-      uint8_t  cpt_byte1;
-      uint8_t  cpt_byte0;
+      atomic_cmd   (ATOMIC,ATOMIC_OP_ADD,ATOMIC_CELL_CPT);
+      atomic_result(ATOMIC,cpt);
+
+      if (cpt >= HELLO_LOOPS)
+        break;
 
+      PORT_WR(RAM_GLO,HELLO_CPT+cpu_id,PORT_RD(RAM_GLO,HELLO_CPT+cpu_id)+1);
+    }
+
+  // Locked loop : the lock is for the UART and the counter in RAM_GLO
+  for (uint8_t i=0; i<HELLO_LOCK_LOOPS; ++i)
+    {
+#ifdef SPINLOCK_TICKET
+      // Acquire the lock in the order of the tickets, no backoff
+      spinlock_lock(SPINLOCK,0);
+#else
       // Acquire the lock, wait until it is available
       while (spinlock_try_lock(SPINLOCK,0) != 0)
         {
@@ -143,52 +186,64 @@ void main()
           }
 
         }
+#endif
+
+      // Read, print then write : a CPU in the lock at the same time
+      // loses an increment
+      uint8_t lock_cpt = PORT_RD(RAM_GLO,HELLO_LOCK_CPT);
+
+      print_str  ("CPU ");
+      print_hex8 (cpu_id&0xFF);
+      print_str  (" - Loop ");
+      print_hex32(lock_cpt);
+      print_crlf ();
 
-      putchar('C');
-      putchar('P');
-      putchar('U');
-      putchar(' ');
-      
-      cpt       = cpu_id;
-	    //cpt_byte3 = (cpt>>24)&0xFF;
-	    //cpt_byte2 = (cpt>>16)&0xFF;
-	    //cpt_byte1 = (cpt>> 8)&0xFF;
-	    cpt_byte0 = (cpt>> 0)&0xFF;
-
-      //puthex (cpt_byte3);
-   	  //puthex (cpt_byte2);
-   	  //puthex (cpt_byte1);
-   	  puthex (cpt_byte0);
-
-      putchar(' ');
-      putchar('-');
-      putchar(' ');
-
-      putchar('L');
-      putchar('o');
-      putchar('o');
-      putchar('p');
-      putchar(' ');
-
-      // Split 32b counter into 4 bytes
-      cpt       = app_data.cpt;
-	    cpt_byte3 = (cpt>>24)&0xFF;
-	    cpt_byte2 = (cpt>>16)&0xFF;
-	    cpt_byte1 = (cpt>> 8)&0xFF;
-	    cpt_byte0 = (cpt>> 0)&0xFF;
-
-      puthex (cpt_byte3);
-   	  puthex (cpt_byte2);
-   	  puthex (cpt_byte1);
-   	  puthex (cpt_byte0);
-
-      putchar('\r');
-      putchar('\n');
-
-      // Increase loop counter
-      app_data.cpt++;
+      PORT_WR(RAM_GLO,HELLO_LOCK_CPT,lock_cpt+1);
 
       // Release the lock
       spinlock_unlock(SPINLOCK,0);
     }
+
+  // End of the run, wait all the CPUs
+  atomic_cmd(ATOMIC,ATOMIC_OP_ADD,ATOMIC_CELL_END);
+  barrier_wait(BARRIER);
+
+  // The CPU 0 checks the counters
+  if (cpu_id == 0)
+    {
+      uint32_t nb_cpu;
+      uint8_t  sum = 0;
+      uint8_t  led = 0;
+#ifdef HELLO_FAIRNESS
+      uint8_t  cpt_min = 0xFF;
+      uint8_t  cpt_max = 0;
+#endif
+
+      atomic_cmd   (ATOMIC,ATOMIC_OP_LOAD,ATOMIC_CELL_END);
+      atomic_result(ATOMIC,nb_cpu);
+
+      for (uint8_t i=0; i<nb_cpu; ++i)
+        {
+          uint8_t cpu_cpt = PORT_RD(RAM_GLO,HELLO_CPT+i);
+
+          sum += cpu_cpt;
+#ifdef HELLO_FAIRNESS
+          if (cpu_cpt < cpt_min) cpt_min = cpu_cpt;
+          if (cpu_cpt > cpt_max) cpt_max = cpu_cpt;
+#endif
+        }
+
+      if (sum != HELLO_LOOPS)
+        led |= HELLO_KO|HELLO_KO_CPT;
+      if (PORT_RD(RAM_GLO,HELLO_LOCK_CPT) != nb_cpu*HELLO_LOCK_LOOPS)
+        led |= HELLO_KO|HELLO_KO_LOCK;
+#ifdef HELLO_FAIRNESS
+      if (cpt_max-cpt_min > HELLO_FAIRNESS)
+        led |= HELLO_KO|HELLO_KO_FAIR;
+#endif
+
+      gpio_wr(LED1,(led != 0)?led:nb_cpu);
+    }
+
+  while (1);
 }
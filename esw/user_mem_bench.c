@@ -0,0 +1,216 @@
+//-----------------------------------------------------------------------------
+// Title      : Benchmark of the memory routines
+// Project    : Asylum
+//-----------------------------------------------------------------------------
+// File       : user_mem_bench.c
+// Author     : mrosiere
+//-----------------------------------------------------------------------------
+// Description:
+// Copy, fill, compare and length of MEM_BENCH_LEN bytes in RAM_GLO, with a
+// byte loop (reference) and with the routines of mem.h.
+// Each routine is a bench section (see bench.h) : the cycles per byte are
+// the cycles of the section divided by MEM_BENCH_LEN.
+// LED1 is the number of wrong results.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026
+//-----------------------------------------------------------------------------
+// Revisions  :
+// Date        Version  Author   Description
+// 2026-10-17  1.0      mrosiere Created
+//-----------------------------------------------------------------------------
+
+#include "addrmap_user.h"
+#include "bench.h"
+#include "mem.h"
+
+//--------------------------------------
+// Constant
+//--------------------------------------
+#define MEM_BENCH_LEN        31   // 7 words and 3 bytes
+
+// RAM_GLO Mapping
+#define MEM_BUF_SRC          (RAM_GLO+0x00)
+#define MEM_BUF_DST          (RAM_GLO+0x20)
+
+#define BENCH_ID_CPY_BYTE    0x01 // Copy, byte loop
+#define BENCH_ID_CPY         0x02 // Copy, mem_cpy
+#define BENCH_ID_SET_BYTE    0x03 // Fill, byte loop
+#define BENCH_ID_SET         0x04 // Fill, mem_set
+#define BENCH_ID_CMP_BYTE    0x05 // Compare, byte loop
+#define BENCH_ID_CMP         0x06 // Compare, mem_cmp
+#define BENCH_ID_LEN_BYTE    0x07 // Length, byte loop
+#define BENCH_ID_LEN         0x08 // Length, str_len
+
+volatile int16_t mem_result;
+
+//--------------------------------------
+// check_buf
+// Return 1 if the len bytes of the destination buffer are val
+//--------------------------------------
+uint8_t check_buf(uint8_t val,
+                  uint8_t len)
+{
+  uint8_t i;
+
+  for (i = 0; i < len; i++)
+    if (PORT_RD(MEM_BUF_DST,i) != val)
+      return 0;
+
+  return 1;
+}
+
+//--------------------------------------
+// check_copy
+// Return 1 if the destination buffer is the source buffer
+//--------------------------------------
+uint8_t check_copy()
+{
+  uint8_t i;
+
+  for (i = 0; i < MEM_BENCH_LEN; i++)
+    if (PORT_RD(MEM_BUF_DST,i) != PORT_RD(MEM_BUF_SRC,i))
+      return 0;
+
+  return 1;
+}
+
+//--------------------------------------
+// clear_copy
+//--------------------------------------
+void clear_copy()
+{
+  uint8_t i;
+
+  for (i = 0; i < MEM_BENCH_LEN; i++)
+    PORT_WR(MEM_BUF_DST,i,0);
+}
+
+//--------------------------------------
+// Interrupt Sub Routine
+//--------------------------------------
+ISR_FCT
+{
+}
+
+//--------------------------------------
+// Application Setup
+//--------------------------------------
+void setup()
+{
+  uint8_t i;
+
+  bench_setup();
+
+  // Source : string of MEM_BENCH_LEN non null bytes, then 0
+  for (i = 0; i < MEM_BENCH_LEN; i++)
+    PORT_WR(MEM_BUF_SRC,i,0xA5^(i*7)|0x01);
+  PORT_WR(MEM_BUF_SRC,MEM_BENCH_LEN,0);
+
+  clear_copy();
+}
+
+//--------------------------------------
+// Main
+//--------------------------------------
+// Arduino Style, Don't modify
+void main()
+{
+  uint8_t  i;
+  int16_t  res;
+  uint8_t  errors = 0;
+
+  setup();
+
+  //------------------------------------
+  // Copy
+  //------------------------------------
+  bench_begin(BENCH_ID_CPY_BYTE);
+  for (i = 0; i < MEM_BENCH_LEN; i++)
+    PORT_WR(MEM_BUF_DST,i,PORT_RD(MEM_BUF_SRC,i));
+  bench_end();
+
+  if (check_copy() == 0)
+    errors ++;
+
+  clear_copy();
+
+  bench_begin(BENCH_ID_CPY);
+  mem_cpy(MEM_BUF_DST,MEM_BUF_SRC,MEM_BENCH_LEN);
+  bench_end();
+
+  if (check_copy() == 0)
+    errors ++;
+
+  //------------------------------------
+  // Compare (equal buffers : all the bytes are read)
+  //------------------------------------
+  bench_begin(BENCH_ID_CMP_BYTE);
+  res = 0;
+  for (i = 0; i < MEM_BENCH_LEN; i++)
+    if (PORT_RD(MEM_BUF_DST,i) != PORT_RD(MEM_BUF_SRC,i))
+      {
+        res = PORT_RD(MEM_BUF_DST,i) - PORT_RD(MEM_BUF_SRC,i);
+        break;
+      }
+  mem_result = res;
+  bench_end();
+
+  if (res != 0)
+    errors ++;
+
+  bench_begin(BENCH_ID_CMP);
+  res = mem_cmp(MEM_BUF_DST,MEM_BUF_SRC,MEM_BENCH_LEN);
+  mem_result = res;
+  bench_end();
+
+  if (res != 0)
+    errors ++;
+
+  // Last byte different
+  PORT_WR(MEM_BUF_DST,MEM_BENCH_LEN-1,PORT_RD(MEM_BUF_SRC,MEM_BENCH_LEN-1)+1);
+  if (mem_cmp(MEM_BUF_DST,MEM_BUF_SRC,MEM_BENCH_LEN) != 1)
+    errors ++;
+
+  //------------------------------------
+  // Length
+  //------------------------------------
+  bench_begin(BENCH_ID_LEN_BYTE);
+  i = 0;
+  while (PORT_RD(MEM_BUF_SRC,i) != 0)
+    i ++;
+  mem_result = i;
+  bench_end();
+
+  if (i != MEM_BENCH_LEN)
+    errors ++;
+
+  bench_begin(BENCH_ID_LEN);
+  i = str_len(MEM_BUF_SRC);
+  mem_result = i;
+  bench_end();
+
+  if (i != MEM_BENCH_LEN)
+    errors ++;
+
+  //------------------------------------
+  // Fill
+  //------------------------------------
+  bench_begin(BENCH_ID_SET_BYTE);
+  for (i = 0; i < MEM_BENCH_LEN; i++)
+    PORT_WR(MEM_BUF_DST,i,0x5A);
+  bench_end();
+
+  if (check_buf(0x5A,MEM_BENCH_LEN) == 0)
+    errors ++;
+
+  bench_begin(BENCH_ID_SET);
+  mem_set(MEM_BUF_DST,0xC3,MEM_BENCH_LEN);
+  bench_end();
+
+  if (check_buf(0xC3,MEM_BENCH_LEN) == 0)
+    errors ++;
+
+  bench_exit(errors);
+
+  while (1);
+}
@@ -12,6 +12,11 @@
 // Revisions  :
 // Date        Version  Author   Description
 // 2025-10-18  1.0      mrosiere Created
+// 2026-10-17  1.1      mrosiere Add interrupt driven reception (MODBUS_RX_IT)
+// 2026-10-17  1.2      mrosiere Add FC16 and FC23
+// 2026-10-17  1.3      mrosiere Use streaming crc : CRC_HW is read once per frame
+// 2026-10-17  1.4      mrosiere Add CRC_TABLE
+// 2026-10-17  1.5      mrosiere Add MODBUS_RX_HW (modbus_rtu accelerator)
 //-----------------------------------------------------------------------------
 
 //#include <intr.h>
@@ -25,76 +30,149 @@
 //#define DISABLE_ERROR
 //#define DISABLE_WAIT
 //#define UART_ECHO
+//#define MODBUS_RX_IT
+//#define MODBUS_RX_HW    // Framing, address filter and request CRC check done by the modbus_rtu accelerator
+//#define CRC_TABLE       // Software CRC with a nibble table instead CRC_HW
+#ifndef CRC_TABLE
 #define CRC_HW
+#endif
+
+#ifndef CRC_HW
+#include "crc16.h"
+#endif
+
+// Maximum number of registers written by FC16/FC23
+#define MODBUS_WRITE_LEN_MAX  8
+
+//--------------------------------------
+// Write Data Buffer
+// Data are applied only after the CRC check
+//--------------------------------------
+uint8_t modbus_write_data    [MODBUS_WRITE_LEN_MAX];
+uint8_t modbus_write_data_msb;
+
+#ifdef MODBUS_RX_IT
+//--------------------------------------
+// Reception Ring Buffer
+// * Filled by the ISR on UART RX interruption
+// * Frame boundary (T3.5) detected by the ISR on TIMER interruption
+// * Pointers are free running, size must be a power of 2
+//--------------------------------------
+#define MODBUS_RX_BUFFER_SIZE 32
+#define MODBUS_RX_BUFFER_MSK  (MODBUS_RX_BUFFER_SIZE-1)
+#define MODBUS_RX_FRAME_SIZE  4
+#define MODBUS_RX_FRAME_MSK   (MODBUS_RX_FRAME_SIZE-1)
+
+#ifdef picoblaze
+// RAM_LOC is not used by the compiler : the buffer is mapped on it
+#define modbus_rx_buffer_wr(_PTR_,_DATA_) PORT_WR(RAM_LOC,(_PTR_)&MODBUS_RX_BUFFER_MSK,_DATA_)
+#define modbus_rx_buffer_rd(_PTR_)        PORT_RD(RAM_LOC,(_PTR_)&MODBUS_RX_BUFFER_MSK)
+#else
+// RAM_LOC contains data and stack : the compiler place the buffer
+volatile uint8_t modbus_rx_buffer[MODBUS_RX_BUFFER_SIZE];
+#define modbus_rx_buffer_wr(_PTR_,_DATA_) modbus_rx_buffer[(_PTR_)&MODBUS_RX_BUFFER_MSK] = (_DATA_)
+#define modbus_rx_buffer_rd(_PTR_)        modbus_rx_buffer[(_PTR_)&MODBUS_RX_BUFFER_MSK]
+#endif
+
+volatile uint8_t modbus_rx_wr_ptr;                       // Next byte to write     (ISR)
+volatile uint8_t modbus_rx_sof_ptr;                      // Start of current frame (ISR)
+volatile uint8_t modbus_rx_overflow;                     // Current frame is lost  (ISR)
+volatile uint8_t modbus_rx_rd_ptr;                       // Next byte to read      (main)
+volatile uint8_t modbus_rx_eof_ptr;                      // End of read frame      (main)
+volatile uint8_t modbus_rx_frame[MODBUS_RX_FRAME_SIZE];  // End of received frames
+volatile uint8_t modbus_rx_frame_wr;                     // (ISR)
+volatile uint8_t modbus_rx_frame_rd;                     // (main)
+#endif
+
+#ifdef MODBUS_RX_HW
+//--------------------------------------
+// Valid frame in the modbus_rtu accelerator (ISR)
+//--------------------------------------
+volatile uint8_t modbus_rx_hw_valid;
+
+//--------------------------------------
+// Request CRC is already checked by the accelerator
+//--------------------------------------
+#define crc16_rx_init()         do {} while (0)
+#define crc16_rx_next(_DATA_)   do {} while (0)
+#define crc16_rx_check(_CRC_)   1
+#else
+#define crc16_rx_init()         crc16_init()
+#define crc16_rx_next(_DATA_)   crc16_next(_DATA_)
+#define crc16_rx_check(_CRC_)   ((_CRC_) == crc16_final())
+#endif
+
+//--------------------------------------
+// Running CRC16 of the current frame
+// * CRC_HW : the running value stays in the crc peripheral
+//            and is read only by crc16_final
+// * else   : the running value is in crc16_value
+//            (CRC_TABLE : table driven, else bitwise)
+//--------------------------------------
+#ifndef CRC_HW
+uint16_t crc16_value;
+#endif
+
+//--------------------------------------
+// crc16_init
+//--------------------------------------
+void crc16_init()
+{
+#ifdef CRC_HW
+  crc_init(CRC,0xFFFF);
+#else
+  crc16_value = 0xFFFF;
+#endif
+}
 
 //--------------------------------------
 // crc16_next
 // Compute one loop of CRC16
 //--------------------------------------
-uint16_t crc16_next(uint16_t crc,
-                    uint8_t  data)
+void crc16_next(uint8_t data)
 {
 #ifndef CRC_HW
-  crc = crc ^ data;
-
-  if ((crc & 0x0001) != 0) {crc >>= 1; crc ^= 0xA001;} else { crc >>= 1; }
-  if ((crc & 0x0001) != 0) {crc >>= 1; crc ^= 0xA001;} else { crc >>= 1; }
-  if ((crc & 0x0001) != 0) {crc >>= 1; crc ^= 0xA001;} else { crc >>= 1; }
-  if ((crc & 0x0001) != 0) {crc >>= 1; crc ^= 0xA001;} else { crc >>= 1; }
-  if ((crc & 0x0001) != 0) {crc >>= 1; crc ^= 0xA001;} else { crc >>= 1; }
-  if ((crc & 0x0001) != 0) {crc >>= 1; crc ^= 0xA001;} else { crc >>= 1; }
-  if ((crc & 0x0001) != 0) {crc >>= 1; crc ^= 0xA001;} else { crc >>= 1; }
-  if ((crc & 0x0001) != 0) {crc >>= 1; crc ^= 0xA001;} else { crc >>= 1; }
+#ifdef CRC_TABLE
+  crc16_value = crc16_table_next  (crc16_value,data);
 #else
-  uint8_t byte0;
-  uint8_t byte1;
-  
-  crc_wr(CRC,DATA0,data);
-
-  byte1 = crc_rd(CRC,CRC1);
-  byte0 = crc_rd(CRC,CRC0);
-  crc   = ((byte1<<8)|
-           (byte0));
+  crc16_value = crc16_bitwise_next(crc16_value,data);
+#endif
+#else
+  crc_feed(CRC,data);
 #endif
-  return crc;
 }
 
 //--------------------------------------
-// crc16_init
+// crc16_final
+// Return the CRC16 of the current frame
 //--------------------------------------
-uint16_t crc16_init()
+uint16_t crc16_final()
 {
-  uint16_t crc;
-
-  crc = 0xFFFF;
-
 #ifdef CRC_HW
-  crc_wr(CRC,CRC0,0xFF);
-  crc_wr(CRC,CRC1,0xFF);
+  return crc_final(CRC);
+#else
+  return crc16_value;
 #endif
-  
-  return crc;
 }
 
 //--------------------------------------
 // modbus_response
 // send byte to uart and accumulate into crc
 //--------------------------------------
-uint16_t modbus_response (uint16_t crc,
-                          uint8_t  byte
-                          )
+void modbus_response (uint8_t byte)
 {
   putchar(byte);
-  return crc16_next(crc,byte);
+  crc16_next(byte);
 }
 
 //--------------------------------------
 // modbus_response_crc
 // send the crc to uart (LSB first)
 //--------------------------------------
-void modbus_response_crc (uint16_t crc)
+void modbus_response_crc ()
 {
-  uint8_t byte;
+  uint16_t crc = crc16_final();
+  uint8_t  byte;
 
   byte = crc & 0xFF;
   putchar(byte); // CRC : send LSB first
@@ -109,7 +187,22 @@ void modbus_response_crc (uint16_t crc)
 //--------------------------------------
 uint8_t _getchar()
 {
+#ifdef MODBUS_RX_IT
+  volatile uint8_t byte = 0;
+
+  // Don't read after the end of the current frame
+  // Missing bytes are read as 0 and invalidate the CRC
+  if (modbus_rx_rd_ptr != modbus_rx_eof_ptr)
+    {
+      byte = modbus_rx_buffer_rd(modbus_rx_rd_ptr);
+      modbus_rx_rd_ptr ++;
+    }
+#elif defined(MODBUS_RX_HW)
+  // Bytes after the end of the frame are read as 0
+  volatile uint8_t byte = modbus_rtu_getc(MODBUS_RTU);
+#else
   volatile uint8_t byte = getchar();
+#endif
 
 #ifdef UART_ECHO
   putchar(byte);
@@ -118,14 +211,160 @@ uint8_t _getchar()
   return byte;
 }
 
+//--------------------------------------
+// modbus_response_registers
+// send read_len registers (MSB first) and accumulate into crc
+//--------------------------------------
+void modbus_response_registers (uint8_t read_addr,
+                                uint8_t read_len
+                                )
+{
+  uint8_t i;
+
+  for (i = 0; i < read_len; i++)
+    {
+      uint8_t read_data = PORT_RD(0,read_addr);
+      modbus_response(0x00);
+      modbus_response(read_data);
+      read_addr ++;
+    }
+}
+
+//--------------------------------------
+// modbus_request_registers
+// receive byte_count bytes of registers and accumulate into crc
+// LSB are stored in modbus_write_data, MSB are or-ed in modbus_write_data_msb
+//--------------------------------------
+void modbus_request_registers (uint8_t byte_count)
+{
+  uint8_t i;
+  uint8_t byte;
+
+  modbus_write_data_msb = 0;
+
+  for (i = 0; i < byte_count; i++)
+    {
+      byte = _getchar();
+      crc16_rx_next(byte);
+
+      if      ((i & 1) == 0)
+        modbus_write_data_msb |= byte;
+      else if ((i >> 1) < MODBUS_WRITE_LEN_MAX)
+        modbus_write_data[i >> 1] = byte;
+    }
+}
+
+//--------------------------------------
+// modbus_write_registers
+// apply received registers
+//--------------------------------------
+void modbus_write_registers (uint8_t write_addr,
+                             uint8_t write_len
+                             )
+{
+  uint8_t i;
+
+  for (i = 0; i < write_len; i++)
+    {
+      PORT_WR(0,write_addr,modbus_write_data[i]);
+      write_addr ++;
+    }
+}
+
+#ifdef MODBUS_RX_IT
+//--------------------------------------
+// modbus_rx_push
+// (ISR) Push byte in ring buffer and restart the T3.5 timer
+//--------------------------------------
+void modbus_rx_push (uint8_t byte)
+{
+  // Keep byte only if ring buffer is not full
+  if ((uint8_t)(modbus_rx_wr_ptr - modbus_rx_rd_ptr) < MODBUS_RX_BUFFER_SIZE)
+    {
+      modbus_rx_buffer_wr(modbus_rx_wr_ptr,byte);
+      modbus_rx_wr_ptr ++;
+    }
+  else
+    {
+      modbus_rx_overflow = 1;
+    }
+
+  // Restart the timer
+  timer_clear  (TIMER);
+  timer_unclear(TIMER);
+  timer_enable (TIMER);
+}
+
+//--------------------------------------
+// modbus_rx_eof
+// (ISR) T3.5 elapsed : close the current frame
+//--------------------------------------
+void modbus_rx_eof ()
+{
+  // Stop Timer
+  timer_disable(TIMER);
+  timer_clear  (TIMER);
+
+  // Drop the frame if incomplete or if no free frame slot
+  if ((modbus_rx_overflow != 0) ||
+      ((uint8_t)(modbus_rx_frame_wr - modbus_rx_frame_rd) >= MODBUS_RX_FRAME_SIZE))
+    {
+      modbus_rx_wr_ptr = modbus_rx_sof_ptr;
+    }
+  else if (modbus_rx_wr_ptr != modbus_rx_sof_ptr)
+    {
+      modbus_rx_frame[modbus_rx_frame_wr & MODBUS_RX_FRAME_MSK] = modbus_rx_wr_ptr;
+      modbus_rx_frame_wr ++;
+      modbus_rx_sof_ptr = modbus_rx_wr_ptr;
+    }
+
+  modbus_rx_overflow = 0;
+}
+
+//--------------------------------------
+// modbus_release
+// Discard unread bytes of the current frame
+//--------------------------------------
+void modbus_release ()
+{
+  modbus_rx_rd_ptr = modbus_rx_eof_ptr;
+  modbus_rx_frame_rd ++;
+}
+#endif
+
+#ifdef MODBUS_RX_HW
+//--------------------------------------
+// modbus_release
+// Free the accelerator buffer for the next frame
+//--------------------------------------
+void modbus_release ()
+{
+  modbus_rtu_release  (MODBUS_RTU);
+  modbus_rtu_it_enable(MODBUS_RTU);
+}
+#endif
+
 //--------------------------------------
 // modbus_wait
 // Active loop to Wait 3.5T
 // If uart have msg : pop and restart compteur
+// With MODBUS_RX_IT : wait a complete frame received by the ISR
+// With MODBUS_RX_HW : wait a valid frame in the accelerator
 //--------------------------------------
 
 void modbus_wait ()
 {
+#ifdef MODBUS_RX_IT
+  // The CPU is free until a complete frame is received
+  while (modbus_rx_frame_rd == modbus_rx_frame_wr);
+
+  modbus_rx_eof_ptr = modbus_rx_frame[modbus_rx_frame_rd & MODBUS_RX_FRAME_MSK];
+#elif defined(MODBUS_RX_HW)
+  // The CPU is free until the accelerator has a valid frame
+  while (modbus_rx_hw_valid == 0);
+
+  modbus_rx_hw_valid = 0;
+#else
   uint8_t status = 0;
 
   // Clear IT From UART
@@ -164,6 +403,7 @@ void modbus_wait ()
 
   // Clear IT from Timer
   gic_clr(TIMER,TIMER_IT_DONE_MSK);
+#endif
 }
 
 //--------------------------------------
@@ -202,7 +442,6 @@ uint8_t modbus_slave_read_holding_registers(uint8_t id)
 {
   uint8_t  slave_id      = id;
   uint8_t  function_code = MODBUS_FC_READ_HOLDING_REGISTERS;
-  uint16_t crc           ;
   uint8_t  errcode       = 0;
 
   // Read Holding Registers
@@ -218,7 +457,6 @@ uint8_t modbus_slave_read_holding_registers(uint8_t id)
   uint8_t  crc_rx_lsb   ;
   uint8_t  crc_rx_msb   ;
   uint16_t crc_rx       ;
-  uint8_t  i            ;
 
   do
     {
@@ -236,17 +474,17 @@ uint8_t modbus_slave_read_holding_registers(uint8_t id)
       crc_rx         = (crc_rx_msb<<8)|crc_rx_lsb;
 
       // crc after address = 1 and read
-      crc = crc16_init();
-      crc = crc16_next(crc,slave_id      );
-      crc = crc16_next(crc,function_code );
-      crc = crc16_next(crc,read_addr_msb);
-      crc = crc16_next(crc,read_addr_lsb);
-      crc = crc16_next(crc,read_len_msb);
-      crc = crc16_next(crc,read_len_lsb);
+      crc16_rx_init();
+      crc16_rx_next(slave_id      );
+      crc16_rx_next(function_code );
+      crc16_rx_next(read_addr_msb);
+      crc16_rx_next(read_addr_lsb);
+      crc16_rx_next(read_len_msb);
+      crc16_rx_next(read_len_lsb);
 
 #ifndef DISABLE_ERROR
       // If CRC is different, just ignore
-      if (crc_rx != crc)
+      if (!crc16_rx_check(crc_rx))
         break;
 
       // Supported Only 8b Address
@@ -271,26 +509,16 @@ uint8_t modbus_slave_read_holding_registers(uint8_t id)
       // Byte 0 : Slave ID
       // Byte 1 : Function Code
       // Byte 2 : Number of read bytes
-      crc = crc16_init();
-      crc = modbus_response(crc,slave_id     );
-      crc = modbus_response(crc,function_code);
-      crc = modbus_response(crc,read_len << 1); // read_len is in read word so 16b
+      crc16_init();
+      modbus_response(slave_id     );
+      modbus_response(function_code);
+      modbus_response(read_len << 1); // read_len is in read word so 16b
 
       // Byte 3 : read data MSB
       // Byte 4 : read data LSB
-      for (i = 0; i < read_len; i++)
-        {
-          //uint16_t read_data = holding_registers[read_addr + i];
-          //crc = modbus_response(crc,(read_data >> 8  ));
-          //crc = modbus_response(crc,(read_data & 0xFF));
-
-          uint8_t read_data = PORT_RD(0,read_addr);
-          crc = modbus_response(crc,0x00);
-          crc = modbus_response(crc,read_data);
-          read_addr ++;
-        }
+      modbus_response_registers(read_addr,read_len);
 
-      modbus_response_crc(crc);
+      modbus_response_crc();
     }
   while (0);
   
@@ -304,7 +532,6 @@ uint8_t modbus_slave_write_single_register(uint8_t id)
 {
   uint8_t  slave_id      = id;
   uint8_t  function_code = MODBUS_FC_WRITE_SINGLE_REGISTER;
-  uint16_t crc           ;
   uint8_t  errcode       = 0;
 
   // Write Single Register
@@ -336,17 +563,17 @@ uint8_t modbus_slave_write_single_register(uint8_t id)
       crc_rx         = (crc_rx_msb<<8)|crc_rx_lsb;
             
       // crc after address = 1 and write
-      crc = crc16_init();
-      crc = crc16_next(crc,slave_id      );
-      crc = crc16_next(crc,function_code );
-      crc = crc16_next(crc,write_addr_msb);
-      crc = crc16_next(crc,write_addr_lsb);
-      crc = crc16_next(crc,write_data_msb);
-      crc = crc16_next(crc,write_data_lsb);
+      crc16_rx_init();
+      crc16_rx_next(slave_id      );
+      crc16_rx_next(function_code );
+      crc16_rx_next(write_addr_msb);
+      crc16_rx_next(write_addr_lsb);
+      crc16_rx_next(write_data_msb);
+      crc16_rx_next(write_data_lsb);
 
 #ifndef DISABLE_ERROR
       // If CRC is different, just ignore
-      if (crc_rx != crc)
+      if (!crc16_rx_check(crc_rx))
         break;
 
       // Supported Only 8b Address
@@ -372,20 +599,227 @@ uint8_t modbus_slave_write_single_register(uint8_t id)
 #endif
         
       // Respons is the same like request
-      crc = crc16_init();
-      crc = modbus_response(crc,slave_id      ); 
-      crc = modbus_response(crc,function_code ); 
-      crc = modbus_response(crc,0x00          ); 
-      crc = modbus_response(crc,write_addr_lsb); 
-      crc = modbus_response(crc,0x00          ); 
-      crc = modbus_response(crc,write_data_lsb); 
-      modbus_response_crc(crc);
+      crc16_init();
+      modbus_response(slave_id      ); 
+      modbus_response(function_code ); 
+      modbus_response(0x00          ); 
+      modbus_response(write_addr_lsb); 
+      modbus_response(0x00          ); 
+      modbus_response(write_data_lsb); 
+      modbus_response_crc();
     }
   while (0);
   
   return errcode;
 }
 
+//--------------------------------------
+// modbus_slave_write_multiple_registers
+//--------------------------------------
+uint8_t modbus_slave_write_multiple_registers(uint8_t id)
+{
+  uint8_t  slave_id      = id;
+  uint8_t  function_code = MODBUS_FC_WRITE_MULTIPLE_REGISTERS;
+  uint8_t  errcode       = 0;
+
+  // Write Multiple Registers
+  // Request must be 9+2*N bytes
+  // Respons must be 8 bytes
+  uint8_t  write_addr_msb ;
+  uint8_t  write_addr_lsb ;
+  uint8_t  write_len_msb  ;
+  uint8_t  write_len_lsb  ;
+  uint8_t  byte_count     ;
+  uint8_t  crc_rx_lsb     ;
+  uint8_t  crc_rx_msb     ;
+  uint16_t crc_rx         ;
+
+  do
+    {
+#ifndef DISABLE_ERROR
+      if (modbus_id_req(slave_id)==0)
+        break;
+#endif
+
+      write_addr_msb = _getchar();
+      write_addr_lsb = _getchar();
+      write_len_msb  = _getchar();
+      write_len_lsb  = _getchar();
+      byte_count     = _getchar();
+
+      // crc after address = 1 and write
+      crc16_rx_init();
+      crc16_rx_next(slave_id      );
+      crc16_rx_next(function_code );
+      crc16_rx_next(write_addr_msb);
+      crc16_rx_next(write_addr_lsb);
+      crc16_rx_next(write_len_msb );
+      crc16_rx_next(write_len_lsb );
+      crc16_rx_next(byte_count    );
+      modbus_request_registers(byte_count);
+
+      crc_rx_lsb     = _getchar();
+      crc_rx_msb     = _getchar();
+      crc_rx         = (crc_rx_msb<<8)|crc_rx_lsb;
+
+#ifndef DISABLE_ERROR
+      // If CRC is different, just ignore
+      if (!crc16_rx_check(crc_rx))
+        break;
+
+      // Supported Only 8b Address
+      if (write_addr_msb != 0x00)
+        {
+          errcode = MODBUS_ERR_INVALID_ADDR;
+          break;
+        }
+
+      // Supported Only MODBUS_WRITE_LEN_MAX registers of 8b
+      if ((write_len_msb  != 0x00) ||
+          (write_len_lsb  >  MODBUS_WRITE_LEN_MAX) ||
+          (byte_count     != (write_len_lsb << 1)) ||
+          (modbus_write_data_msb != 0x00))
+        {
+          errcode = MODBUS_ERR_INVALID_DATA;
+          break;
+        }
+#endif
+
+      modbus_write_registers(write_addr_lsb,write_len_lsb);
+
+#ifndef DISABLE_ERROR
+      if (modbus_id_rsp(slave_id)==0)
+        break;
+#endif
+
+      // Response :
+      // Byte 0   : Slave ID
+      // Byte 1   : Function Code
+      // Byte 2-3 : Write Address
+      // Byte 4-5 : Number of written registers
+      crc16_init();
+      modbus_response(slave_id      );
+      modbus_response(function_code );
+      modbus_response(0x00          );
+      modbus_response(write_addr_lsb);
+      modbus_response(0x00          );
+      modbus_response(write_len_lsb );
+      modbus_response_crc();
+    }
+  while (0);
+
+  return errcode;
+}
+
+//--------------------------------------
+// modbus_slave_read_write_registers
+//--------------------------------------
+uint8_t modbus_slave_read_write_registers(uint8_t id)
+{
+  uint8_t  slave_id      = id;
+  uint8_t  function_code = MODBUS_FC_READ_WRITE_REGISTERS;
+  uint8_t  errcode       = 0;
+
+  // Read/Write Multiple Registers
+  // Request must be 13+2*N bytes
+  // Respons must be 5+2*M bytes
+  // The write is done before the read
+  uint8_t  read_addr_msb  ;
+  uint8_t  read_addr_lsb  ;
+  uint8_t  read_len_msb   ;
+  uint8_t  read_len_lsb   ;
+  uint8_t  write_addr_msb ;
+  uint8_t  write_addr_lsb ;
+  uint8_t  write_len_msb  ;
+  uint8_t  write_len_lsb  ;
+  uint8_t  byte_count     ;
+  uint8_t  crc_rx_lsb     ;
+  uint8_t  crc_rx_msb     ;
+  uint16_t crc_rx         ;
+
+  do
+    {
+#ifndef DISABLE_ERROR
+      if (modbus_id_rsp(slave_id)==0)
+        break;
+#endif
+
+      read_addr_msb  = _getchar();
+      read_addr_lsb  = _getchar();
+      read_len_msb   = _getchar();
+      read_len_lsb   = _getchar();
+      write_addr_msb = _getchar();
+      write_addr_lsb = _getchar();
+      write_len_msb  = _getchar();
+      write_len_lsb  = _getchar();
+      byte_count     = _getchar();
+
+      // crc after address = 1 and read/write
+      crc16_rx_init();
+      crc16_rx_next(slave_id      );
+      crc16_rx_next(function_code );
+      crc16_rx_next(read_addr_msb );
+      crc16_rx_next(read_addr_lsb );
+      crc16_rx_next(read_len_msb  );
+      crc16_rx_next(read_len_lsb  );
+      crc16_rx_next(write_addr_msb);
+      crc16_rx_next(write_addr_lsb);
+      crc16_rx_next(write_len_msb );
+      crc16_rx_next(write_len_lsb );
+      crc16_rx_next(byte_count    );
+      modbus_request_registers(byte_count);
+
+      crc_rx_lsb     = _getchar();
+      crc_rx_msb     = _getchar();
+      crc_rx         = (crc_rx_msb<<8)|crc_rx_lsb;
+
+#ifndef DISABLE_ERROR
+      // If CRC is different, just ignore
+      if (!crc16_rx_check(crc_rx))
+        break;
+
+      // Supported Only 8b Address
+      if ((read_addr_msb  != 0x00) ||
+          (write_addr_msb != 0x00))
+        {
+          errcode = MODBUS_ERR_INVALID_ADDR;
+          break;
+        }
+
+      // Supported Only MODBUS_WRITE_LEN_MAX registers of 8b
+      if ((read_len_msb   != 0x00) ||
+          (write_len_msb  != 0x00) ||
+          (write_len_lsb  >  MODBUS_WRITE_LEN_MAX) ||
+          (byte_count     != (write_len_lsb << 1)) ||
+          (modbus_write_data_msb != 0x00))
+        {
+          errcode = MODBUS_ERR_INVALID_DATA;
+          break;
+        }
+#endif
+
+      modbus_write_registers(write_addr_lsb,write_len_lsb);
+
+      // Response :
+      // Byte 0 : Slave ID
+      // Byte 1 : Function Code
+      // Byte 2 : Number of read bytes
+      crc16_init();
+      modbus_response(slave_id     );
+      modbus_response(function_code);
+      modbus_response(read_len_lsb << 1); // read_len is in read word so 16b
+
+      // Byte 3 : read data MSB
+      // Byte 4 : read data LSB
+      modbus_response_registers(read_addr_lsb,read_len_lsb);
+
+      modbus_response_crc();
+    }
+  while (0);
+
+  return errcode;
+}
+
 //--------------------------------------
 // modbus_slave
 // send byte to uart and accumulate into crc
@@ -394,7 +828,6 @@ void modbus_slave ()
 {
   uint8_t  slave_id      ;
   uint8_t  function_code ;
-  uint16_t crc           ;
   uint8_t  errcode       ;
 
   // not yet error
@@ -414,6 +847,14 @@ void modbus_slave ()
     {
       errcode = modbus_slave_write_single_register(slave_id);
     }
+  else if (function_code == MODBUS_FC_WRITE_MULTIPLE_REGISTERS)
+    {
+      errcode = modbus_slave_write_multiple_registers(slave_id);
+    }
+  else if (function_code == MODBUS_FC_READ_WRITE_REGISTERS)
+    {
+      errcode = modbus_slave_read_write_registers(slave_id);
+    }
   else 
       // Unsupported Function
     {
@@ -423,11 +864,11 @@ void modbus_slave ()
   // Have Error ?
   if (errcode != 0)
     {
-      crc = crc16_init();
-      crc = modbus_response(crc,slave_id      ); 
-      crc = modbus_response(crc,(function_code|0x80)); 
-      crc = modbus_response(crc,errcode       ); 
-      modbus_response_crc(crc);
+      crc16_init();
+      modbus_response(slave_id      ); 
+      modbus_response((function_code|0x80)); 
+      modbus_response(errcode       ); 
+      modbus_response_crc();
     }
 }
 
@@ -436,6 +877,44 @@ void modbus_slave ()
 //--------------------------------------
 ISR_FCT
 {
+#if defined(MODBUS_RX_IT) || defined(MODBUS_RX_HW)
+  uint8_t gic_it_vector = gic_isr(GIC);
+#endif
+
+#ifdef MODBUS_RX_IT
+
+  if (gic_it_vector & GIC_UART_MSK)
+    {
+      // Pop all received bytes
+      do
+        {
+          modbus_rx_push(getchar());
+          gic_clr(UART,UART_IT_RX_EMPTY_B_MSK);
+        }
+      while (gic_get(UART) & UART_IT_RX_EMPTY_B_MSK);
+
+      gic_clr(GIC,GIC_UART_MSK);
+    }
+
+  if (gic_it_vector & GIC_TIMER_MSK)
+    {
+      modbus_rx_eof();
+
+      gic_clr(TIMER,TIMER_IT_DONE_MSK);
+      gic_clr(GIC,GIC_TIMER_MSK);
+    }
+#endif
+
+#ifdef MODBUS_RX_HW
+  if (gic_it_vector & GIC_MODBUS_RTU_MSK)
+    {
+      // Masked until the frame is released
+      modbus_rtu_it_disable(MODBUS_RTU);
+      modbus_rx_hw_valid = 1;
+
+      gic_clr(GIC,GIC_MODBUS_RTU_MSK);
+    }
+#endif
 }
 
 //--------------------------------------
@@ -468,12 +947,46 @@ void setup()
   timer_cnt = (3.5 * 10 * CLOCK_FREQ)/(BAUD_RATE);
   timer_wr(TIMER,timer_cnt);
   gic_it_enable(TIMER,TIMER_IT_DONE_MSK);
+
+#ifdef CRC_TABLE
+  // CRC
+  // * Compute the nibble table
+  crc16_table_init();
+#endif
   
   // Setup the interruption handler address in the CPU
   interrupt_setup(isr);
 
+#ifdef MODBUS_RX_IT
+  // Reception is done in the ISR
+  modbus_rx_wr_ptr   = 0;
+  modbus_rx_sof_ptr  = 0;
+  modbus_rx_overflow = 0;
+  modbus_rx_rd_ptr   = 0;
+  modbus_rx_eof_ptr  = 0;
+  modbus_rx_frame_wr = 0;
+  modbus_rx_frame_rd = 0;
+
+  gic_it_enable(GIC,GIC_UART_MSK);
+  gic_it_enable(GIC,GIC_TIMER_MSK);
+
+  // Enable Interrtuption in the CPU
+  interrupt_enable();
+#elif defined(MODBUS_RX_HW)
+  // Reception is done by the accelerator, one interruption per valid frame
+  // The UART is only used to send the response
+  modbus_rx_hw_valid = 0;
+
+  modbus_rtu_setup    (MODBUS_RTU,MODBUS_ADDRESS);
+  modbus_rtu_it_enable(MODBUS_RTU);
+  gic_it_enable(GIC,GIC_MODBUS_RTU_MSK);
+
+  // Enable Interrtuption in the CPU
+  interrupt_enable();
+#else
   // Enable Interrtuption in the CPU
   //interrupt_enable();
+#endif
 }
 
 
@@ -496,5 +1009,8 @@ void main()
       modbus_wait   ();
 #endif
       modbus_slave  ();
+#if defined(MODBUS_RX_IT) || defined(MODBUS_RX_HW)
+      modbus_release();
+#endif
     }
 }
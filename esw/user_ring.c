@@ -0,0 +1,230 @@
+//-----------------------------------------------------------------------------
+// Title      : Lines received by one CPU and processed by another one
+// Project    : Asylum
+//-----------------------------------------------------------------------------
+// File       : user_ring.c
+// Author     : mrosiere
+//-----------------------------------------------------------------------------
+// Description:
+// Split of the I/O and the processing between two CPUs (NB_CPU >= 2)
+// without copy (see ring.h) :
+// * CPU 0 (producer) receives the UART lines directly in the slots of a
+//   ring in RAM_GLO and sends the index of each line in the mailbox FIFO0
+// * CPU 1 (consumer) is woken up by the interruption of the mailbox FIFO0,
+//   prints the length and the CRC of each line then releases its slot
+// * The other CPUs do nothing
+// A slot is a length byte followed by the line (without '\r' and '\n').
+// LED0 is the number of lines received, LED1 the number of lines processed.
+// With RING_PATTERN (simulation without UART RX), the producer receives
+// RING_PATTERN lines of a known pattern instead of the UART and the
+// consumer only counts in LED1 the lines equal to the pattern.
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026
+//-----------------------------------------------------------------------------
+// Revisions  :
+// Date        Version  Author   Description
+// 2026-10-17  1.0      mrosiere Created
+// 2026-10-17  1.1      mrosiere Add RING_PATTERN
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include "addrmap_user.h"
+#include "print.h"
+#include "ring.h"
+
+static inline uint32_t read_mhartid(void)
+{
+  uint32_t id;
+  asm volatile ("csrr %0, mhartid" : "=r" (id));
+  return id;
+}
+
+//--------------------------------------
+// Constant
+//--------------------------------------
+#define UART_RX_LOOPBACK     0
+
+#define CPU_PRODUCER         0
+#define CPU_CONSUMER         1
+
+#define RING_LINE            RAM_GLO
+#define RING_LINE_NB_SLOT    4  // Mailbox FIFO0 is 8 bytes deep
+#define RING_LINE_SLOT_SIZE  15 // Length + 14 characters
+
+#define SLOT_LEN             0
+#define SLOT_DATA            1
+
+#ifdef RING_PATTERN
+//--------------------------------------
+// Pattern
+// The line n has 1 to RING_LINE_SLOT_SIZE-SLOT_DATA characters, from
+// 'A'+n : the lines of the maximal length are cut without '\n'.
+//--------------------------------------
+#define pattern_len(_N_)      (((_N_)%(RING_LINE_SLOT_SIZE-SLOT_DATA))+1)
+#define pattern_char(_N_,_I_) ('A'+(_N_)+(_I_))
+
+uint8_t pattern_line; // Producer : line in progress
+uint8_t pattern_pos;  // Producer : next character of the line
+uint8_t pattern_recv; // Consumer : next line to check
+
+uint8_t ring_getchar()
+{
+  // All the lines are sent
+  while (pattern_line == RING_PATTERN);
+
+  if (pattern_pos == pattern_len(pattern_line))
+    {
+      pattern_line ++;
+      pattern_pos = 0;
+      return '\n';
+    }
+
+  return pattern_char(pattern_line,pattern_pos++);
+}
+#else
+#define ring_getchar()        getchar()
+#endif
+
+//--------------------------------------
+// Interrupt Sub Routine
+// Only the consumer enables the interruption
+//--------------------------------------
+ISR_FCT
+{
+  uint8_t slot;
+  uint8_t len;
+  uint8_t i;
+  uint8_t ok;
+
+  while (mailbox_level(MAILBOX,0) != 0)
+    {
+      slot = ring_recv(RING_LINE,0);
+      len  = PORT_RD(slot,SLOT_LEN);
+      ok   = 1;
+
+#ifdef RING_PATTERN
+      if (len != pattern_len(pattern_recv))
+        ok = 0;
+#endif
+
+      crc_init(CRC,0xFFFF);
+      for (i=0; i<len; i++)
+        {
+          crc_feed(CRC,PORT_RD(slot,SLOT_DATA+i));
+#ifdef RING_PATTERN
+          if (PORT_RD(slot,SLOT_DATA+i) != pattern_char(pattern_recv,i))
+            ok = 0;
+#endif
+        }
+
+      print_str  ("LEN ");
+      print_hex8 (len);
+      print_str  (" CRC ");
+      print_hex16(crc_final(CRC));
+      print_crlf ();
+
+      ring_release(RING_LINE);
+
+#ifdef RING_PATTERN
+      pattern_recv ++;
+#endif
+      if (ok)
+        gpio_wr(LED1,gpio_rd(LED1)+1);
+    }
+
+  // The FIFO is empty
+  gic_clr(GIC,GIC_MAILBOX0_MSK);
+}
+
+//--------------------------------------
+// producer
+//--------------------------------------
+void producer()
+{
+  uint8_t slot;
+  uint8_t len;
+  uint8_t c;
+
+  gpio_setup(SWITCH,INPUT);
+  gpio_setup(LED0  ,OUTPUT);
+  gpio_setup(LED1  ,OUTPUT);
+  gpio_wr(LED0,0);
+  gpio_wr(LED1,0);
+
+  uart_setup(UART,CLOCK_FREQ,BAUD_RATE,UART_RX_LOOPBACK);
+
+  ring_init(RING_LINE,RING_LINE_NB_SLOT,RING_LINE_SLOT_SIZE);
+
+#ifdef RING_PATTERN
+  pattern_line = 0;
+  pattern_pos  = 0;
+#endif
+
+  while (1)
+    {
+      // Wait a free slot
+      while ((slot = ring_alloc(RING_LINE)) == RING_FULL);
+
+      // Receive the line in the slot
+      len = 0;
+      while (1)
+        {
+          c = ring_getchar();
+
+          if ((c == '\r') || (c == '\n'))
+            {
+              if (len != 0)
+                break;
+              continue;
+            }
+
+          PORT_WR(slot,SLOT_DATA+len,c);
+          len++;
+
+          if (len == RING_LINE_SLOT_SIZE-SLOT_DATA)
+            break;
+        }
+      PORT_WR(slot,SLOT_LEN,len);
+
+      ring_send(RING_LINE,0);
+
+      gpio_wr(LED0,gpio_rd(LED0)+1);
+    }
+}
+
+//--------------------------------------
+// consumer
+//--------------------------------------
+void consumer()
+{
+#ifdef RING_PATTERN
+  pattern_recv = 0;
+#endif
+
+  // Interruption as soon as the FIFO0 is not empty
+  mailbox_watermark(MAILBOX,0,MAILBOX_WATERMARK_NOT_EMPTY);
+
+  // Only in the GIC of the consumer
+  gic_it_enable(GIC,GIC_MAILBOX0_MSK);
+
+  interrupt_setup(isr);
+  interrupt_enable();
+
+  while (1);
+}
+
+//--------------------------------------
+// Main
+//--------------------------------------
+void main()
+{
+  uint32_t cpu_id = read_mhartid();
+
+  if (cpu_id == CPU_PRODUCER)
+    producer();
+
+  if (cpu_id == CPU_CONSUMER)
+    consumer();
+
+  while (1);
+}
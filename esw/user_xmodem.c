@@ -6,101 +6,410 @@
 // Author     : mrosiere
 //-----------------------------------------------------------------------------
 // Description:
-// Read  switch
-// Write led
+// Receive a file with XMODEM-CRC (128 bytes blocks) or XMODEM-1K (1024
+// bytes blocks) and write it in the spi flash at XMODEM_FLASH_ADDR.
+// * The CRC of each block is computed by the CRC peripheral if it is
+//   CRC-16/XMODEM (USER_CRC16_MODEL "xmodem"), else by software.
+// * A block doesn't fit in RAM_GLO : it is staged in the flash at
+//   XMODEM_STAGE_ADDR (one sector) while it is received, and copied to the
+//   destination only if its CRC is good. A bad CRC is answered by NAK and
+//   the block is received again in the next slot of the stage sector. The
+//   stage sector is erased when it is full.
+// * Double buffering : the block is received by chunks of
+//   XMODEM_CHUNK_SIZE bytes, alternately in the two halves of RAM_GLO.
+//   The chunk received in one half is given to the flash (page program)
+//   byte by byte while the next chunk is received in the other half.
+//   A bad header is rejected (NAK) before any program.
+// The sender must use the RTS/CTS flow control.
+// LED0 is the number of received blocks, LED1 is the status of the transfer.
 //-----------------------------------------------------------------------------
 // Copyright (c) 2021
 //-----------------------------------------------------------------------------
 // Revisions  :
 // Date        Version  Author   Description
 // 2025-07-31  1.0      mrosiere Created
+// 2026-10-17  2.0      mrosiere XMODEM-CRC and XMODEM-1K into spi flash
+// 2026-10-17  2.1      mrosiere Stage the blocks in flash : check the CRC
+//                               before the program, NAK a bad CRC
+//                               Double buffering in RAM_GLO
+//                               Software CRC if the peripheral isn't xmodem
 //-----------------------------------------------------------------------------
 
 #include <stdint.h>
 #include "addrmap_user.h"
+#include "spi_flash.h"
 
 //--------------------------------------
-// xmodem_rx
+// Constant
 //--------------------------------------
 //                      ASCII Code
-//                      Start Of Heading
+//                      Start Of Heading (128 bytes block)
 #define SOH        0x01
+//                      Start Of Text (1024 bytes block)
+#define STX        0x02
 //                      End of Transmission
 #define EOT        0x04
 //                      Acknowledge
 #define ACK        0x06
 //                      Negative Acknowledge
 #define NAK        0x15
-#define BLOCK_SIZE 128
- 
-uint8_t xmodem_rx(uint8_t * buffer, uint8_t len)
+//                      Cancel
+#define CAN        0x18
+//                      Start in CRC mode
+#define XMODEM_CRC 'C'
+
+#define XMODEM_BLOCK_SIZE      128
+#define XMODEM_BLOCK_1K_SIZE   1024
+#define XMODEM_CHUNK_SIZE      32   // Half of RAM_GLO, divide the flash page
+#define XMODEM_CHUNK(_N_)      (RAM_GLO+(_N_)*XMODEM_CHUNK_SIZE)
+
+#ifndef XMODEM_FLASH_ADDR
+#define XMODEM_FLASH_ADDR      BOOT_IMAGE0_ADDR
+#endif
+#ifndef XMODEM_FLASH_SIZE
+#define XMODEM_FLASH_SIZE      SPI_FLASH_SECTOR_SIZE
+#endif
+#ifndef XMODEM_STAGE_ADDR
+#define XMODEM_STAGE_ADDR      (BOOT_IMAGE1_ADDR+SPI_FLASH_SECTOR_SIZE)
+#endif
+
+#define XMODEM_CRC16_POLYNOM   0x1021
+
+#define XMODEM_TIMEOUT         CLOCK_FREQ // 1s
+#define XMODEM_RETRY           10
+
+// Status
+#define XMODEM_OK              0x00
+#define XMODEM_ERR_TIMEOUT     0x01 // No answer of the sender
+#define XMODEM_ERR_CANCEL      0x02 // Canceled by the sender
+#define XMODEM_ERR_SEQ         0x03 // Block out of sequence
+#define XMODEM_ERR_CRC         0x04 // Bad CRC XMODEM_RETRY times
+#define XMODEM_ERR_SIZE        0x05 // File greater than XMODEM_FLASH_SIZE
+
+// 1 : the CRC peripheral is CRC-16/XMODEM, 0 : software CRC
+uint8_t  xmodem_crc_hw;
+uint16_t xmodem_crc_sw;
+
+//--------------------------------------
+// xmodem_crc_init / xmodem_crc_feed / xmodem_crc_final
+// CRC-16/XMODEM (polynom 0x1021, MSB first, init 0x0000)
+//--------------------------------------
+void xmodem_crc_init()
+{
+  if (xmodem_crc_hw)
+    crc_init(CRC,0x0000);
+  else
+    xmodem_crc_sw = 0x0000;
+}
+
+void xmodem_crc_feed(uint8_t data)
+{
+  uint8_t i;
+
+  if (xmodem_crc_hw)
+    {
+      crc_feed(CRC,data);
+      return;
+    }
+
+  xmodem_crc_sw ^= ((uint16_t)data)<<8;
+  for (i=0; i<8; i++)
+    {
+      if (xmodem_crc_sw & 0x8000)
+        xmodem_crc_sw = (xmodem_crc_sw<<1) ^ XMODEM_CRC16_POLYNOM;
+      else
+        xmodem_crc_sw =  xmodem_crc_sw<<1;
+    }
+}
+
+uint16_t xmodem_crc_final()
+{
+  if (xmodem_crc_hw)
+    return crc_final(CRC);
+  else
+    return xmodem_crc_sw;
+}
+
+//--------------------------------------
+// xmodem_wait
+// Return 1 if a byte is received before the timeout
+//--------------------------------------
+uint8_t xmodem_wait()
+{
+  uint8_t status = 0;
+
+  // Start Timer
+  timer_clear  (TIMER);
+  timer_unclear(TIMER);
+  timer_enable (TIMER);
+
+  while (1)
+    {
+      // Is RX Not Empty ? (the ISR bit is set while the RX FIFO is not empty)
+      gic_clr(UART,UART_IT_RX_EMPTY_B_MSK);
+      if (gic_get(UART) & UART_IT_RX_EMPTY_B_MSK)
+        {
+          status = 1;
+          break;
+        }
+
+      // Is Timeout ?
+      if (gic_get(TIMER) & TIMER_IT_DONE_MSK)
+        break;
+    }
+
+  // Disable Timer
+  timer_disable(TIMER);
+  timer_clear  (TIMER);
+
+  // Clear IT from Timer
+  gic_clr(TIMER,TIMER_IT_DONE_MSK);
+
+  return status;
+}
+
+//--------------------------------------
+// xmodem_purge
+// Drop the bytes until the line is idle
+//--------------------------------------
+void xmodem_purge()
+{
+  while (xmodem_wait())
+    getchar();
+}
+
+//--------------------------------------
+// xmodem_cancel
+//--------------------------------------
+void xmodem_cancel()
+{
+  putchar(CAN);
+  putchar(CAN);
+}
+
+//--------------------------------------
+// xmodem_block
+// Receive the data and the CRC of a block and program the data in the
+// flash at stage. Return 1 if the CRC is good.
+// The chunk c is received in one half of RAM_GLO while the chunk c-1 is
+// given to the flash from the other half.
+//--------------------------------------
+uint8_t xmodem_block(uint32_t stage,
+                     uint8_t  nb_chunk)
+{
+  uint8_t  c   ;
+  uint8_t  i   ;
+  uint8_t  rx  ; // Half of RAM_GLO receiving the chunk
+  uint8_t  data;
+  uint16_t crc ;
+
+  xmodem_crc_init();
+  rx = 0;
+
+  for (c=0; c<=nb_chunk; c++)
+    {
+      // Program of the previous chunk, its bytes are given with the
+      // received bytes (the chip select is held between them)
+      if (c != 0)
+        {
+          spi_flash_wait();
+          spi_flash_program_begin(stage,XMODEM_CHUNK_SIZE);
+          stage += XMODEM_CHUNK_SIZE;
+        }
+
+      for (i=0; i<XMODEM_CHUNK_SIZE; i++)
+        {
+          if (c != nb_chunk)
+            {
+              data = getchar();
+              PORT_WR(XMODEM_CHUNK(rx),i,data);
+              xmodem_crc_feed(data);
+            }
+
+          if (c != 0)
+            spi_tx(SPI,PORT_RD(XMODEM_CHUNK(rx^1),i));
+        }
+
+      rx ^= 1;
+    }
+
+  // Get CRC (MSB first) and check
+  crc  = ((uint16_t)getchar())<<8;
+  crc |= getchar();
+
+  return (xmodem_crc_final() == crc);
+}
+
+//--------------------------------------
+// xmodem_copy
+// Copy nb_chunk chunks of the flash from src to dst
+//--------------------------------------
+void xmodem_copy(uint32_t dst,
+                 uint32_t src,
+                 uint8_t  nb_chunk)
+{
+  do
+    {
+      spi_flash_wait();
+      spi_flash_read   (src,XMODEM_CHUNK(0),XMODEM_CHUNK_SIZE);
+      spi_flash_program(dst,XMODEM_CHUNK(0),XMODEM_CHUNK_SIZE);
+      src += XMODEM_CHUNK_SIZE;
+      dst += XMODEM_CHUNK_SIZE;
+    }
+  while (--nb_chunk != 0);
+}
+
+//--------------------------------------
+// xmodem_rx
+// Receive a file and write it in the flash at addr
+//--------------------------------------
+uint8_t xmodem_rx(uint32_t addr)
 {
   uint8_t  cmd     ;
   uint8_t  blk     ;
   uint8_t  blk_b   ;
-  uint8_t  checksum;
-  uint8_t  sum     ;
-  uint16_t byte_rx        = 0;
-  
+  uint8_t  retry   ;
+  uint8_t  retry_crc;
+  uint8_t  crc_ok  ;
+  uint8_t  nb_chunk;
+  uint32_t addr_end;
+  uint32_t stage   ; // Slot of the next block in the stage sector
+
   uint8_t  expected_block = 1;
-  
-  // Ack First block
-  putchar(NAK);
-  
+
+  // Ask the first block in CRC mode until the sender starts
+  do
+    {
+      putchar(XMODEM_CRC);
+    }
+  while (xmodem_wait() == 0);
+
+  // Erase the destination and the stage (the sender is stopped by the flow control)
+  for (addr_end = addr; addr_end != addr+XMODEM_FLASH_SIZE; addr_end += SPI_FLASH_SECTOR_SIZE)
+    spi_flash_erase(addr_end);
+  spi_flash_erase(XMODEM_STAGE_ADDR);
+  stage     = 0;
+
+  retry     = XMODEM_RETRY;
+  retry_crc = XMODEM_RETRY;
+
   while (1)
     {
-      // Get the command -> SOH or EOT
-      cmd      = getchar();
+      // Get the command -> SOH, STX or EOT
+      if (xmodem_wait() == 0)
+        {
+          if (--retry == 0)
+            {
+              xmodem_cancel();
+              return XMODEM_ERR_TIMEOUT;
+            }
+          putchar(NAK);
+          continue;
+        }
+
+      retry = XMODEM_RETRY;
+      cmd   = getchar();
 
       // If EOT, quit the function
       if (cmd == EOT)
-	{
-	  putchar(ACK);
-	  break;
+        {
+          spi_flash_wait();
+          putchar(ACK);
+          return XMODEM_OK;
         }
-      
+
+      if (cmd == CAN)
+        {
+          spi_flash_wait();
+          return XMODEM_ERR_CANCEL;
+        }
+
+      if      (cmd == SOH)
+        nb_chunk = XMODEM_BLOCK_SIZE   /XMODEM_CHUNK_SIZE;
+      else if (cmd == STX)
+        nb_chunk = XMODEM_BLOCK_1K_SIZE/XMODEM_CHUNK_SIZE;
+      else
+        {
+          xmodem_purge();
+          putchar(NAK);
+          continue;
+        }
+
       // Continue -> Get the number of blk
       blk      = getchar();
       blk_b    = getchar();
 
-      // Check the cmd and the number of blk
-      if ((cmd   != SOH                  ) ||
- 	  (blk   != expected_block       ) ||
-	  (blk_b != (255 - expected_block)))
-	{
-	  putchar(NAK);
-	  continue;
+      if (blk_b != (uint8_t)(~blk))
+        {
+          xmodem_purge();
+          putchar(NAK);
+          continue;
+        }
+
+      // Block already received (the ACK was lost)
+      if (blk == (uint8_t)(expected_block-1))
+        {
+          xmodem_purge();
+          putchar(ACK);
+          continue;
+        }
+
+      if (blk != expected_block)
+        {
+          spi_flash_wait();
+          xmodem_cancel();
+          return XMODEM_ERR_SEQ;
+        }
+
+      if ((addr_end - addr) < ((uint32_t)nb_chunk*XMODEM_CHUNK_SIZE))
+        {
+          spi_flash_wait();
+          xmodem_cancel();
+          return XMODEM_ERR_SIZE;
+        }
+
+      // Get Data in the stage and check the CRC
+      crc_ok = xmodem_block(XMODEM_STAGE_ADDR+stage,nb_chunk);
+
+      // Good block : copy in the destination
+      if (crc_ok)
+        {
+          xmodem_copy(addr,XMODEM_STAGE_ADDR+stage,nb_chunk);
+          addr += (uint32_t)nb_chunk*XMODEM_CHUNK_SIZE;
+        }
+
+      // Next slot, erase the stage if a 1K block doesn't fit
+      stage += (uint32_t)nb_chunk*XMODEM_CHUNK_SIZE;
+      if (stage > SPI_FLASH_SECTOR_SIZE-XMODEM_BLOCK_1K_SIZE)
+        {
+          spi_flash_wait();
+          spi_flash_erase(XMODEM_STAGE_ADDR);
+          stage = 0;
         }
 
-      // Get Data and compute the sum
-      sum = 0;
-      for (int i=0: i<BLOCK_SIZE)
-	{
-	  uint8_t data = getchar();
-	  if (byte_rx < len)
-	    buffer[i]  = data;
-	  sum       += data;
-	  byte_rx ++;
-	}
-
-      // Get Checksum and check
-      checksum = getchar();
-      
-      if (sum != checksum)
-	{
-	  putchar(NAK);
-	  continue;
+      // Bad block : ask it again
+      if (!crc_ok)
+        {
+          if (--retry_crc == 0)
+            {
+              spi_flash_wait();
+              xmodem_cancel();
+              return XMODEM_ERR_CRC;
+            }
+          putchar(NAK);
+          continue;
         }
 
+      retry_crc = XMODEM_RETRY;
+
       // Ack the block and continue
       putchar(ACK);
-      
+
+      gpio_wr(LED0,expected_block);
       expected_block++;
     }
-  
-  return 0;
 }
- 
+
 //--------------------------------------
 // Interrupt Sub Routine
 //--------------------------------------
@@ -114,15 +423,6 @@ ISR_FCT
       gpio_wr(LED1,gpio_rd(LED1)+1);
       gic_clr(GIC,GIC_IT_USER_MSK);
     }
-
-//// Check if UART RX is not empty
-//if (gic_it_vector & GIC_UART_MSK)
-//  {
-//    uint8_t uart_rx = getchar();
-//    gpio_wr(SWITCH,uart_rx); // Dummy access
-//    gic_clr(UART,UART_IT_RX_EMPTY_B_MSK);
-//    gic_clr(GIC,GIC_UART_MSK);
-//  }
 }
 
 //--------------------------------------
@@ -130,22 +430,35 @@ ISR_FCT
 //--------------------------------------
 void setup()
 {
+  uint8_t i;
+
   gpio_setup(SWITCH,INPUT);
   gpio_setup(LED0  ,OUTPUT);
   gpio_setup(LED1  ,OUTPUT);
   gpio_wr   (LED0  ,0);
   gpio_wr   (LED1  ,0);
 
-  uart_setup(UART,CLOCK_FREQ,BAUD_RATE,1);
+  uart_setup(UART,CLOCK_FREQ,BAUD_RATE,0);
   gic_it_enable(UART,UART_IT_RX_EMPTY_B_MSK);
-  
-//spi_setup(SPI,0,0,SPI_LOOPBACK);
+
+  // TIMER : timeout of the sender
+  timer_wr(TIMER,XMODEM_TIMEOUT);
+  gic_it_enable(TIMER,TIMER_IT_DONE_MSK);
+
+  spi_setup(SPI,0,0,SPI_LOOPBACK_DISABLE);
+
+  // CRC : use the peripheral if it gives the check value of
+  // CRC-16/XMODEM ("123456789" -> 0x31C3)
+  crc_init(CRC,0x0000);
+  for (i='1'; i<='9'; i++)
+    crc_feed(CRC,i);
+  xmodem_crc_hw = (crc_final(CRC) == 0x31C3);
+
   gic_it_enable(GIC,GIC_IT_USER_MSK);
-//gic_it_enable(GIC,GIC_UART_MSK);
-  
+
   // Setup the interruption handler address in the CPU
   interrupt_setup(isr);
-  
+
   // Enable Interrtuption in the CPU
   interrupt_enable();
 }
@@ -156,9 +469,6 @@ void setup()
 // Arduino Style, Don't modify
 void main()
 {
-#define BUFFER_SIZE 8
-  uint8_t  buffer [BUFFER_SIZE];
-
   setup();
 
   //------------------------------------
@@ -167,7 +477,6 @@ void main()
 
   while (1)
     {
-      xmodem_rx(buffer, BUFFER_SIZE)
+      gpio_wr(LED1,xmodem_rx(XMODEM_FLASH_ADDR));
     }
 }
-
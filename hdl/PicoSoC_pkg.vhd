@@ -12,6 +12,28 @@
 -- Revisions  :
 -- Date        Version  Author   Description
 -- 2025-04-14  1.0      mrosiere Created
+-- 2026-10-17  1.1      mrosiere Add Modbus RTU accelerator
+-- 2026-10-17  1.2      mrosiere Add DMA
+-- 2026-10-17  1.3      mrosiere Add Dual/Quad SPI
+-- 2026-10-17  1.4      mrosiere Add instruction RAM and boot loader
+-- 2026-10-17  1.5      mrosiere Add Generic CRC16_MODEL
+-- 2026-10-17  1.6      mrosiere Add mailbox with interruptions
+-- 2026-10-17  1.7      mrosiere Add RAM2_HI
+-- 2026-10-17  1.8      mrosiere Add spinlock with one port per CPU
+-- 2026-10-17  1.9      mrosiere Add atomic operations
+-- 2026-10-17  1.10     mrosiere Add barrier
+-- 2026-10-17  1.11     mrosiere Add ICN2 arbiter
+-- 2026-10-17  1.12     mrosiere Add ICN2 crossbar
+-- 2026-10-17  1.13     mrosiere Add ICN2 register slices
+-- 2026-10-17  1.14     mrosiere Add banked RAM2
+-- 2026-10-17  1.15     mrosiere Add RAM_SYNC_READ
+-- 2026-10-17  1.16     mrosiere Add instruction cache
+-- 2026-10-17  1.17     mrosiere Add shared instruction memory
+-- 2026-10-17  1.18     mrosiere Add clusters of CPUs
+-- 2026-10-17  1.19     mrosiere Add Generic USER_MODBUS_RTU
+-- 2026-10-17  1.20     mrosiere Counters of the instruction caches of all the CPUs
+-- 2026-10-17  1.21     mrosiere Remove RAM_SYNC_READ
+-- 2026-10-17  1.22     mrosiere debug_mux_i on 4 bits
 -------------------------------------------------------------------------------
 
 library ieee;
@@ -40,8 +62,14 @@ package PicoSoC_pkg is
   constant PICOSOC_USER_SPI_BA                 : std_logic_vector(8-1 downto 0) := X"18";
   constant PICOSOC_USER_UART_BA                : std_logic_vector(8-1 downto 0) := X"20";
   constant PICOSOC_USER_TIMER_BA               : std_logic_vector(8-1 downto 0) := X"28";
+  constant PICOSOC_USER_BARRIER_BA             : std_logic_vector(8-1 downto 0) := X"2D"; -- ICN1, TIMER has 5 registers
+  constant PICOSOC_USER_ATOMIC_BA              : std_logic_vector(8-1 downto 0) := X"2E"; -- ICN1, TIMER has 5 registers
+  constant PICOSOC_USER_MODBUS_RTU_BA          : std_logic_vector(8-1 downto 0) := X"30";
+  constant PICOSOC_USER_DMA_BA                 : std_logic_vector(8-1 downto 0) := X"38";
+  constant PICOSOC_USER_BOOT_BA                : std_logic_vector(8-1 downto 0) := X"3C";
   constant PICOSOC_USER_RAM2_BA                : std_logic_vector(8-1 downto 0) := X"40";
   constant PICOSOC_USER_RAM1_BA                : std_logic_vector(8-1 downto 0) := X"80";
+  constant PICOSOC_USER_RAM2_HI_BA             : std_logic_vector(8-1 downto 0) := X"C0"; -- Behind RAM1 if RAM1_DEPTH > 64
                                                
   constant PICOSOC_SUPERVISOR_ADDR_ENCODING    : string := "binary";
                                                
@@ -50,12 +78,28 @@ package PicoSoC_pkg is
   constant PICOSOC_SUPERVISOR_GIC_BA           : std_logic_vector(8-1 downto 0) := X"40";
   constant PICOSOC_SUPERVISOR_RAM_BA           : std_logic_vector(8-1 downto 0) := X"80";
 
+  -----------------------------------------------------------------------------
+  -- Local IP Address Width
+  -----------------------------------------------------------------------------
+  constant MODBUS_RTU_ADDR_WIDTH               : natural  := 3;
+  constant DMA_ADDR_WIDTH                      : natural  := 2;
+  constant BOOT_ADDR_WIDTH                     : natural  := 2;
+  constant MAILBOX_IT_ADDR_WIDTH               : natural  := 2;
+  constant SPINLOCK_MP_ADDR_WIDTH              : natural  := 1;
+  constant ATOMIC_MP_ADDR_WIDTH                : natural  := 1;
+  constant BARRIER_MP_ADDR_WIDTH               : natural  := 0;
+
   -----------------------------------------------------------------------------
   -- GIC Map
   -----------------------------------------------------------------------------
   constant PICOSOC_USER_GIC_IT_USER            : natural  := 0;
   constant PICOSOC_USER_GIC_UART               : natural  := 1;
   constant PICOSOC_USER_GIC_TIMER              : natural  := 2;
+  constant PICOSOC_USER_GIC_MODBUS_RTU         : natural  := 3;
+  constant PICOSOC_USER_GIC_DMA                : natural  := 4;
+  constant PICOSOC_USER_GIC_MAILBOX0           : natural  := 5;
+  constant PICOSOC_USER_GIC_MAILBOX1           : natural  := 6;
+  constant PICOSOC_USER_GIC_SPINLOCK           : natural  := 7;
   
   constant PICOSOC_SUPERVISOR_GIC_CPU0_VS_CPU1 : natural  := 0;
   constant PICOSOC_SUPERVISOR_GIC_CPU1_VS_CPU2 : natural  := 1;
@@ -78,6 +122,9 @@ package PicoSoC_pkg is
     cpu_daddr   : std_logic_vector( 8-1 downto 0);
     cpu_dready  : std_logic;
 
+    icache_hit  : std_logic_vector(16-1 downto 0); -- Counters of the instruction caches, sum of all the CPUs
+    icache_miss : std_logic_vector(16-1 downto 0);
+
     switch_cs   : std_logic;
     switch_ready: std_logic;
     led0_cs     : std_logic;
@@ -142,10 +189,15 @@ component PicoSoC_top is
 
     -- USER SoC
     ;USER_NB_CPU                 : natural  := 1
+    ;USER_CLUSTER_NB_CPU         : natural  := 0           -- CPUs per cluster (0 : one ICN2 master per CPU)
     ;USER_ICN_TARGET_SEL         : string   := "or"
-    ;USER_ICN_MASTER_SEL         : string   := "fix"
+    ;USER_ICN_MASTER_SEL         : string   := "fix"       -- "fix" / "rr" / "wrr"
+    ;USER_ICN_DMA_WEIGHT         : positive := 4           -- "wrr" : accesses of the DMA per turn
+    ;USER_ICN_XBAR               : boolean  := False       -- ICN2 crossbar
+    ;USER_ICN_PIPE               : string   := "none"      -- "none" / "master" / "target" / "all"
     ;USER_RAM1_DEPTH             : natural  := 128         -- Up to 128 bytes
-    ;USER_RAM2_DEPTH             : natural  := 64          -- Up to 64  bytes
+    ;USER_RAM2_DEPTH             : natural  := 64          -- Up to 128 bytes (above 64, USER_RAM1_DEPTH up to 64)
+    ;USER_RAM2_NB_BANK           : positive := 1           -- > 1 : RAM2 interleaved on banks
     ;USER_NB_SWITCH              : positive := 8
     ;USER_NB_LED0                : positive := 8
     ;USER_NB_LED1                : positive := 8
@@ -155,6 +207,16 @@ component PicoSoC_top is
     ;USER_SPI_DEPTH_CMD          : natural  := 0
     ;USER_SPI_DEPTH_TX           : natural  := 0
     ;USER_SPI_DEPTH_RX           : natural  := 0
+    ;USER_MODBUS_RTU             : boolean  := False       -- Add the Modbus RTU accelerator
+    ;USER_SPI_QUAD               : boolean  := False       -- Dual/Quad SPI on spi_io
+    ;USER_IMEM_RAM               : boolean  := False       -- Instruction RAM loaded by the ROM
+    ;USER_ICACHE_NB_LINE         : natural  := 0           -- Instruction cache lines (0 : without instruction cache)
+    ;USER_ICACHE_LINE_SIZE       : positive := 4           -- Instructions per line of the instruction cache
+    ;USER_IMEM_SHARED            : positive := 1           -- CPUs sharing one instruction memory (> 1 : needs the instruction cache)
+    ;USER_CRC16_MODEL            : string   := "modbus"    -- "modbus" / "xmodem"
+    ;USER_SPINLOCK_MODE          : string   := "tas"       -- "tas" / "ticket"
+    ;USER_ATOMIC_NB_CELL         : positive := 4           -- Up to 64 cells of 32 bits
+    ;USER_BARRIER_HOLD           : boolean  := False       -- CPUs 1 to N-1 in reset until CPU 0 arrives at the barrier
     ;USER_SAFETY                 : string   := "lock-step" -- "none" / "lock-step" / "tmr"
     ;USER_LOCK_STEP_DEPTH        : natural  := 2
     ;USER_FAULT_INJECTION        : boolean  := True  
@@ -192,12 +254,15 @@ component PicoSoC_top is
     ;spi_cs_b_o       : out std_logic
     ;spi_mosi_o       : out std_logic
     ;spi_miso_i       : in  std_logic
+    ;spi_io_o         : out std_logic_vector(4-1 downto 0) -- IO3..IO0 (USER_SPI_QUAD)
+    ;spi_io_oe_o      : out std_logic_vector(4-1 downto 0)
+    ;spi_io_i         : in  std_logic_vector(4-1 downto 0) := (others => '1')
      
     -- Error Injection Interface
     ;inject_error_i   : in  std_logic_vector(        3-1 downto 0)
 
     -- Debug Interface
-    ;debug_mux_i      : in  std_logic_vector(        3-1 downto 0)
+    ;debug_mux_i      : in  std_logic_vector(        4-1 downto 0) := (others => '0') -- 1xSS : counters of the instruction caches
     ;debug_o          : out std_logic_vector(        8-1 downto 0)
     ;debug_uart_tx_o  : out std_logic
      
@@ -221,14 +286,30 @@ component PicoSoC_user is
     ;FAULT_INJECTION        : boolean  := False
     ;ICN_TARGET_SEL         : string   := "or"
     ;ICN_MASTER_SEL         : string   := "fix"
+    ;ICN_DMA_WEIGHT         : positive := 4
+    ;ICN_XBAR               : boolean  := False
+    ;ICN_PIPE               : string   := "none"
     ;NB_CPU                 : natural  := 1
+    ;CLUSTER_NB_CPU         : natural  := 0
     ;CPU_MODEL              : string   := "OpenBlaze8"
     ;RAM1_DEPTH             : natural  := 128
     ;RAM2_DEPTH             : natural  := 64
+    ;RAM2_NB_BANK           : positive := 1
     ;MAILBOX_FIFO0_DEPTH_TX : natural  := 4
     ;MAILBOX_FIFO0_DEPTH_RX : natural  := 4
     ;MAILBOX_FIFO1_DEPTH_TX : natural  := 4
     ;MAILBOX_FIFO1_DEPTH_RX : natural  := 4
+    ;MODBUS_RTU             : boolean  := False
+    ;MODBUS_RTU_DEPTH       : positive := 32
+    ;SPI_QUAD               : boolean  := False
+    ;IMEM_RAM               : boolean  := False
+    ;ICACHE_NB_LINE         : natural  := 0
+    ;ICACHE_LINE_SIZE       : positive := 4
+    ;IMEM_SHARED            : positive := 1
+    ;CRC16_MODEL            : string   := "modbus"
+    ;SPINLOCK_MODE          : string   := "tas"
+    ;ATOMIC_NB_CELL         : positive := 4
+    ;BARRIER_HOLD           : boolean  := False
     );
   port
     (clk_i                 : in  std_logic
@@ -249,6 +330,9 @@ component PicoSoC_user is
     ;spi_cs_b_o            : out std_logic
     ;spi_mosi_o            : out std_logic
     ;spi_miso_i            : in  std_logic
+    ;spi_io_o              : out std_logic_vector(4-1 downto 0) -- IO3..IO0 (SPI_QUAD)
+    ;spi_io_oe_o           : out std_logic_vector(4-1 downto 0)
+    ;spi_io_i              : in  std_logic_vector(4-1 downto 0) := (others => '1')
                           
     ;it_i                  : in  std_logic
     ;inject_error_i        : in  std_logic_vector(        3-1 downto 0)
@@ -322,5 +406,252 @@ component cpu_wrapper is
   
 end component cpu_wrapper;
 
+component sbi_dma is
+  port
+    (clk_i                 : in  std_logic
+    ;arst_b_i              : in  std_logic
+
+    -- Configuration (target)
+    ;sbi_ini_i             : in  sbi_ini_t
+    ;sbi_tgt_o             : out sbi_tgt_t
+
+    -- Copy (initiator)
+    ;sbi_ini_o             : out sbi_ini_t
+    ;sbi_tgt_i             : in  sbi_tgt_t
+
+    ;it_o                  : out std_logic
+    );
+end component sbi_dma;
+
+component sbi_modbus_rtu is
+  generic
+    (CLOCK_FREQ            : integer  := 50000000
+    ;BAUD_RATE             : integer  := 115200
+    ;DEPTH                 : positive := 32
+    ;SLAVE_ID              : std_logic_vector(8-1 downto 0) := x"5A"
+    );
+  port
+    (clk_i                 : in  std_logic
+    ;arst_b_i              : in  std_logic
+
+    ;sbi_ini_i             : in  sbi_ini_t
+    ;sbi_tgt_o             : out sbi_tgt_t
+
+    ;uart_rx_i             : in  std_logic
+    ;it_o                  : out std_logic
+    );
+end component sbi_modbus_rtu;
+
+component sbi_spi_quad is
+  generic
+    (PRESCALER_RATIO       : std_logic_vector(8-1 downto 0) := x"00"
+    );
+  port
+    (clk_i                 : in  std_logic
+    ;arst_b_i              : in  std_logic
+
+    ;sbi_ini_i             : in  sbi_ini_t
+    ;sbi_tgt_o             : out sbi_tgt_t
+
+    ;sclk_o                : out std_logic
+    ;cs_b_o                : out std_logic
+    ;io_o                  : out std_logic_vector(4-1 downto 0)
+    ;io_oe_o               : out std_logic_vector(4-1 downto 0)
+    ;io_i                  : in  std_logic_vector(4-1 downto 0)
+    );
+end component sbi_spi_quad;
+
+component sbi_boot is
+  generic
+    (IMEM_ADDR_WIDTH       : positive := 10
+    ;IMEM_DATA_WIDTH       : positive := 18
+    ;RESET_CYCLES          : positive := 4
+    );
+  port
+    (clk_i                 : in  std_logic
+    ;arst_b_i              : in  std_logic
+
+    ;sbi_ini_i             : in  sbi_ini_t
+    ;sbi_tgt_o             : out sbi_tgt_t
+
+    ;imem_we_o             : out std_logic
+    ;imem_addr_o           : out std_logic_vector(IMEM_ADDR_WIDTH-1 downto 0)
+    ;imem_data_o           : out std_logic_vector(IMEM_DATA_WIDTH-1 downto 0)
+
+    ;boot_o                : out std_logic
+    ;cpu_arst_b_o          : out std_logic
+    );
+end component sbi_boot;
+
+component sbi_mailbox_it is
+  generic
+    (FIFO0_DEPTH           : positive := 8
+    ;FIFO1_DEPTH           : positive := 8
+    );
+  port
+    (clk_i                 : in  std_logic
+    ;arst_b_i              : in  std_logic
+
+    ;sbi_ini_i             : in  sbi_ini_t
+    ;sbi_tgt_o             : out sbi_tgt_t
+
+    ;it_o                  : out std_logic_vector(2-1 downto 0)
+    );
+end component sbi_mailbox_it;
+
+component sbi_spinlock_mp is
+  generic
+    (NB_PORT               : positive := 1
+    ;MODE                  : string   := "tas"
+    );
+  port
+    (clk_i                 : in  std_logic
+    ;arst_b_i              : in  std_logic
+
+    ;sbi_inis_i            : in  sbi_inis_t
+    ;sbi_tgts_o            : out sbi_tgts_t
+
+    ;it_o                  : out std_logic_vector(NB_PORT-1 downto 0)
+    );
+end component sbi_spinlock_mp;
+
+component sbi_atomic_mp is
+  generic
+    (NB_PORT               : positive := 1
+    ;NB_CELL               : positive := 4
+    );
+  port
+    (clk_i                 : in  std_logic
+    ;arst_b_i              : in  std_logic
+
+    ;sbi_inis_i            : in  sbi_inis_t
+    ;sbi_tgts_o            : out sbi_tgts_t
+    );
+end component sbi_atomic_mp;
+
+component sbi_barrier_mp is
+  generic
+    (NB_PORT               : positive := 1
+    ;HOLD                  : boolean  := False
+    );
+  port
+    (clk_i                 : in  std_logic
+    ;arst_b_i              : in  std_logic
+
+    ;sbi_inis_i            : in  sbi_inis_t
+    ;sbi_tgts_o            : out sbi_tgts_t
+
+    ;cpu_run_o             : out std_logic_vector(NB_PORT-1 downto 0)
+    );
+end component sbi_barrier_mp;
+
+component sbi_arbiter is
+  generic
+    (NB_MASTER             : positive := 2
+    ;ALGO                  : string   := "rr"
+    ;WEIGHT                : integer_vector := (0 => 1)
+    );
+  port
+    (clk_i                 : in  std_logic
+    ;arst_b_i              : in  std_logic
+
+    ;sbi_inis_i            : in  sbi_inis_t
+    ;sbi_tgts_o            : out sbi_tgts_t
+
+    ;sbi_ini_o             : out sbi_ini_t
+    ;sbi_tgt_i             : in  sbi_tgt_t
+    );
+end component sbi_arbiter;
+
+component sbi_xbar is
+  generic
+    (NB_MASTER             : positive := 2
+    ;MASTER_SEL            : string   := "rr"
+    ;MASTER_WEIGHT         : integer_vector := (0 => 1)
+    ;NB_TARGET             : positive := 1
+    ;TARGET_ID             : sbi_addrs_t
+    ;TARGET_ADDR_WIDTH     : naturals_t
+    );
+  port
+    (clk_i                 : in  std_logic
+    ;arst_b_i              : in  std_logic
+
+    ;sbi_inis_i            : in  sbi_inis_t
+    ;sbi_tgts_o            : out sbi_tgts_t
+
+    ;sbi_inis_o            : out sbi_inis_t
+    ;sbi_tgts_i            : in  sbi_tgts_t
+    );
+end component sbi_xbar;
+
+component sbi_slice is
+  port
+    (clk_i                 : in  std_logic
+    ;arst_b_i              : in  std_logic
+
+    ;sbi_ini_i             : in  sbi_ini_t
+    ;sbi_tgt_o             : out sbi_tgt_t
+
+    ;sbi_ini_o             : out sbi_ini_t
+    ;sbi_tgt_i             : in  sbi_tgt_t
+    );
+end component sbi_slice;
+
+component sbi_ram_mp is
+  generic
+    (NB_PORT               : positive := 2
+    ;NB_BANK               : positive := 2
+    ;DEPTH                 : positive := 64
+    ;ALGO                  : string   := "rr"
+    );
+  port
+    (clk_i                 : in  std_logic
+    ;arst_b_i              : in  std_logic
+
+    ;sbi_inis_i            : in  sbi_inis_t
+    ;sbi_tgts_o            : out sbi_tgts_t
+    );
+end component sbi_ram_mp;
+
+component imem_ram is
+  generic
+    (ADDR_WIDTH            : positive := 10
+    ;DATA_WIDTH            : positive := 18
+    );
+  port
+    (clk_i                 : in  std_logic
+    ;cke_i                 : in  std_logic
+    ;address_i             : in  std_logic_vector(ADDR_WIDTH-1 downto 0)
+    ;instruction_o         : out std_logic_vector(DATA_WIDTH-1 downto 0)
+    ;we_i                  : in  std_logic
+    ;waddr_i               : in  std_logic_vector(ADDR_WIDTH-1 downto 0)
+    ;wdata_i               : in  std_logic_vector(DATA_WIDTH-1 downto 0)
+    );
+end component imem_ram;
+
+component icache is
+  generic
+    (ADDR_WIDTH            : positive := 10
+    ;DATA_WIDTH            : positive := 32
+    ;NB_LINE               : positive := 8
+    ;LINE_SIZE             : positive := 4
+    ;CNT_WIDTH             : positive := 16
+    );
+  port
+    (clk_i                 : in  std_logic
+    ;arst_b_i              : in  std_logic
+    ;cs_i                  : in  std_logic
+    ;addr_i                : in  std_logic_vector(ADDR_WIDTH-1 downto 0)
+    ;data_o                : out std_logic_vector(DATA_WIDTH-1 downto 0)
+    ;stall_o               : out std_logic
+    ;mem_cs_o              : out std_logic
+    ;mem_addr_o            : out std_logic_vector(ADDR_WIDTH-1 downto 0)
+    ;mem_ready_i           : in  std_logic
+    ;mem_data_i            : in  std_logic_vector(DATA_WIDTH-1 downto 0)
+    ;hit_o                 : out std_logic_vector(CNT_WIDTH-1 downto 0)
+    ;miss_o                : out std_logic_vector(CNT_WIDTH-1 downto 0)
+    );
+end component icache;
+
 -- [COMPONENT_INSERT][END]
 end package PicoSoC_pkg;
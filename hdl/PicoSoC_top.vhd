@@ -6,7 +6,7 @@
 -- Author     : Mathieu Rosiere
 -- Company    : 
 -- Created    : 2025-01-15
--- Last update: 2026-01-17
+-- Last update: 2026-10-17
 -- Platform   : 
 -- Standard   : VHDL'93/02
 -------------------------------------------------------------------------------
@@ -18,6 +18,25 @@
 -- Date        Version  Author   Description
 -- 2025-01-15  1.0      mrosiere Created
 -- 2025-07-15  2.0      mrosiere Add FIFO depth for UART and SPI
+-- 2026-10-17  2.1      mrosiere Add Generic USER_SPI_QUAD
+-- 2026-10-17  2.2      mrosiere Add Generic USER_IMEM_RAM
+-- 2026-10-17  2.3      mrosiere Add Generic USER_CRC16_MODEL
+-- 2026-10-17  2.4      mrosiere USER_RAM2_DEPTH up to 128 bytes
+-- 2026-10-17  2.5      mrosiere Add Generic USER_SPINLOCK_MODE
+-- 2026-10-17  2.6      mrosiere Add Generic USER_ATOMIC_NB_CELL
+-- 2026-10-17  2.7      mrosiere Add Generic USER_BARRIER_HOLD
+-- 2026-10-17  2.8      mrosiere Add Generic USER_ICN_DMA_WEIGHT
+-- 2026-10-17  2.9      mrosiere Add Generic USER_ICN_XBAR
+-- 2026-10-17  2.10     mrosiere Add Generic USER_ICN_PIPE
+-- 2026-10-17  2.11     mrosiere Add Generic USER_RAM2_NB_BANK
+-- 2026-10-17  2.12     mrosiere Add Generic USER_RAM_SYNC_READ
+-- 2026-10-17  2.13     mrosiere Add Generic USER_ICACHE_NB_LINE, USER_ICACHE_LINE_SIZE
+-- 2026-10-17  2.14     mrosiere Add Generic USER_IMEM_SHARED
+-- 2026-10-17  2.15     mrosiere Add Generic USER_CLUSTER_NB_CPU
+-- 2026-10-17  2.16     mrosiere Add Generic USER_MODBUS_RTU
+-- 2026-10-17  2.17     mrosiere Counters of the instruction caches on debug_o
+-- 2026-10-17  2.18     mrosiere Remove Generic USER_RAM_SYNC_READ
+-- 2026-10-17  2.19     mrosiere debug_mux back on switch_i(2 downto 0), counters of the instruction caches selected by debug_mux_i(3)
 -------------------------------------------------------------------------------
 
 library ieee;
@@ -39,10 +58,15 @@ entity PicoSoC_top is
 
     -- USER SoC
     ;USER_NB_CPU                 : natural  := 1
+    ;USER_CLUSTER_NB_CPU         : natural  := 0           -- CPUs per cluster (0 : one ICN2 master per CPU)
     ;USER_ICN_TARGET_SEL         : string   := "or"
-    ;USER_ICN_MASTER_SEL         : string   := "fix"
+    ;USER_ICN_MASTER_SEL         : string   := "fix"       -- "fix" / "rr" / "wrr"
+    ;USER_ICN_DMA_WEIGHT         : positive := 4           -- "wrr" : accesses of the DMA per turn
+    ;USER_ICN_XBAR               : boolean  := False       -- ICN2 crossbar
+    ;USER_ICN_PIPE               : string   := "none"      -- "none" / "master" / "target" / "all"
     ;USER_RAM1_DEPTH             : natural  := 128         -- Up to 128 bytes
-    ;USER_RAM2_DEPTH             : natural  := 64          -- Up to 64  bytes
+    ;USER_RAM2_DEPTH             : natural  := 64          -- Up to 128 bytes (above 64, USER_RAM1_DEPTH up to 64)
+    ;USER_RAM2_NB_BANK           : positive := 1           -- > 1 : RAM2 interleaved on banks
     ;USER_NB_SWITCH              : positive := 8
     ;USER_NB_LED0                : positive := 8
     ;USER_NB_LED1                : positive := 8
@@ -52,6 +76,16 @@ entity PicoSoC_top is
     ;USER_SPI_DEPTH_CMD          : natural  := 0
     ;USER_SPI_DEPTH_TX           : natural  := 0
     ;USER_SPI_DEPTH_RX           : natural  := 0
+    ;USER_MODBUS_RTU             : boolean  := False       -- Add the Modbus RTU accelerator
+    ;USER_SPI_QUAD               : boolean  := False       -- Dual/Quad SPI on spi_io
+    ;USER_IMEM_RAM               : boolean  := False       -- Instruction RAM loaded by the ROM
+    ;USER_ICACHE_NB_LINE         : natural  := 0           -- Instruction cache lines (0 : without instruction cache)
+    ;USER_ICACHE_LINE_SIZE       : positive := 4           -- Instructions per line of the instruction cache
+    ;USER_IMEM_SHARED            : positive := 1           -- CPUs sharing one instruction memory (> 1 : needs the instruction cache)
+    ;USER_CRC16_MODEL            : string   := "modbus"    -- "modbus" / "xmodem"
+    ;USER_SPINLOCK_MODE          : string   := "tas"       -- "tas" / "ticket"
+    ;USER_ATOMIC_NB_CELL         : positive := 4           -- Up to 64 cells of 32 bits
+    ;USER_BARRIER_HOLD           : boolean  := False       -- CPUs 1 to N-1 in reset until CPU 0 arrives at the barrier
     ;USER_SAFETY                 : string   := "lock-step" -- "none" / "lock-step" / "tmr"
     ;USER_LOCK_STEP_DEPTH        : natural  := 2
     ;USER_FAULT_INJECTION        : boolean  := True  
@@ -89,12 +123,15 @@ entity PicoSoC_top is
     ;spi_cs_b_o       : out std_logic
     ;spi_mosi_o       : out std_logic
     ;spi_miso_i       : in  std_logic
+    ;spi_io_o         : out std_logic_vector(4-1 downto 0) -- IO3..IO0 (USER_SPI_QUAD)
+    ;spi_io_oe_o      : out std_logic_vector(4-1 downto 0)
+    ;spi_io_i         : in  std_logic_vector(4-1 downto 0) := (others => '1')
      
     -- Error Injection Interface
     ;inject_error_i   : in  std_logic_vector(        3-1 downto 0)
 
     -- Debug Interface
-    ;debug_mux_i      : in  std_logic_vector(        3-1 downto 0)
+    ;debug_mux_i      : in  std_logic_vector(        4-1 downto 0) := (others => '0') -- 1xSS : counters of the instruction caches
     ;debug_o          : out std_logic_vector(        8-1 downto 0)
     ;debug_uart_tx_o  : out std_logic
      
@@ -129,6 +166,7 @@ architecture rtl of PicoSoC_top is
   signal   uart_rts_b                   : std_logic;
   
   signal   debug_mux                    : unsigned        (3-1 downto 0);
+  signal   debug_icache                 : std_logic_vector(8-1 downto 0);
   signal   debug_user                   : PicoSoC_user_debug_t      ;
   signal   debug_supervisor             : PicoSoC_supervisor_debug_t;
   
@@ -219,13 +257,28 @@ begin  -- architecture rtl
     ,FAULT_INJECTION        => USER_FAULT_INJECTION
     ,ICN_TARGET_SEL         => USER_ICN_TARGET_SEL
     ,NB_CPU                 => USER_NB_CPU
+    ,CLUSTER_NB_CPU         => USER_CLUSTER_NB_CPU
     ,ICN_MASTER_SEL         => USER_ICN_MASTER_SEL
+    ,ICN_DMA_WEIGHT         => USER_ICN_DMA_WEIGHT
+    ,ICN_XBAR               => USER_ICN_XBAR
+    ,ICN_PIPE               => USER_ICN_PIPE
     ,RAM1_DEPTH             => USER_RAM1_DEPTH
     ,RAM2_DEPTH             => USER_RAM2_DEPTH
+    ,RAM2_NB_BANK           => USER_RAM2_NB_BANK
     ,MAILBOX_FIFO0_DEPTH_TX => USER_MAILBOX_FIFO0_DEPTH_TX
     ,MAILBOX_FIFO0_DEPTH_RX => USER_MAILBOX_FIFO0_DEPTH_RX
     ,MAILBOX_FIFO1_DEPTH_TX => USER_MAILBOX_FIFO1_DEPTH_TX
     ,MAILBOX_FIFO1_DEPTH_RX => USER_MAILBOX_FIFO1_DEPTH_RX
+    ,MODBUS_RTU             => USER_MODBUS_RTU
+    ,SPI_QUAD               => USER_SPI_QUAD
+    ,IMEM_RAM               => USER_IMEM_RAM
+    ,ICACHE_NB_LINE         => USER_ICACHE_NB_LINE
+    ,ICACHE_LINE_SIZE       => USER_ICACHE_LINE_SIZE
+    ,IMEM_SHARED            => USER_IMEM_SHARED
+    ,CRC16_MODEL            => USER_CRC16_MODEL
+    ,SPINLOCK_MODE          => USER_SPINLOCK_MODE
+    ,ATOMIC_NB_CELL         => USER_ATOMIC_NB_CELL
+    ,BARRIER_HOLD           => USER_BARRIER_HOLD
     )
   port map
     (clk_i                => clk
@@ -245,6 +298,9 @@ begin  -- architecture rtl
     ,spi_cs_b_o           => spi_cs_b_o 
     ,spi_mosi_o           => spi_mosi_o 
     ,spi_miso_i           => spi_miso_i 
+    ,spi_io_o             => spi_io_o
+    ,spi_io_oe_o          => spi_io_oe_o
+    ,spi_io_i             => spi_io_i
     );
 
   uart_tx_o    <= uart_tx   ;
@@ -321,7 +377,15 @@ begin  -- architecture rtl
   if DEBUG_ENABLE = True
   generate
     debug_mux      <= unsigned(switch_i(2 downto 0));
-    debug_o        <= led0_user                                      when debug_mux = 0 else
+
+    -- Counters of the instruction caches of all the CPUs
+    debug_icache   <= debug_user      .icache_hit ( 8-1 downto 0)    when debug_mux_i(1 downto 0) = "00" else
+                      debug_user      .icache_hit (16-1 downto 8)    when debug_mux_i(1 downto 0) = "01" else
+                      debug_user      .icache_miss( 8-1 downto 0)    when debug_mux_i(1 downto 0) = "10" else
+                      debug_user      .icache_miss(16-1 downto 8);
+
+    debug_o        <= debug_icache                                   when debug_mux_i(3) = '1' else
+                      led0_user                                      when debug_mux = 0 else
                       std_logic_vector(resize(unsigned(switch_i),8)) when debug_mux = 1 else
                       (0      => debug_user      .arst_b,
                        1      => debug_supervisor.arst_b,
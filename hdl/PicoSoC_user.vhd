@@ -6,7 +6,7 @@
 -- Author     : Mathieu Rosiere
 -- Company    : 
 -- Created    : 2017-03-30
--- Last update: 2026-05-25
+-- Last update: 2026-10-17
 -- Platform   : 
 -- Standard   : VHDL'93/02
 -------------------------------------------------------------------------------
@@ -31,6 +31,27 @@
 -- 2026-05-16  3.6      mrosiere Add RAM
 -- 2026-05-25  3.7      mrosiere Add Spinlock and mailbox
 -- 2026-06-17  3.8      mrosiere Add RAM2
+-- 2026-10-17  3.9      mrosiere Add Modbus RTU accelerator
+-- 2026-10-17  3.10     mrosiere Add DMA
+-- 2026-10-17  3.11     mrosiere Add Generic SPI_QUAD
+-- 2026-10-17  3.12     mrosiere Add Generic IMEM_RAM
+-- 2026-10-17  3.13     mrosiere Add Generic CRC16_MODEL
+-- 2026-10-17  3.14     mrosiere Mailbox with fill level and interruptions
+-- 2026-10-17  3.15     mrosiere RAM2 up to 128 bytes
+-- 2026-10-17  3.16     mrosiere Spinlock on ICN1, Add Generic SPINLOCK_MODE
+-- 2026-10-17  3.17     mrosiere Add atomic operations, Add Generic ATOMIC_NB_CELL
+-- 2026-10-17  3.18     mrosiere Add barrier, Add Generic BARRIER_HOLD
+-- 2026-10-17  3.19     mrosiere ICN2 arbiter "rr" / "wrr", Add Generic ICN_DMA_WEIGHT
+-- 2026-10-17  3.20     mrosiere ICN2 crossbar, Add Generic ICN_XBAR
+-- 2026-10-17  3.21     mrosiere ICN2 register slices, Add Generic ICN_PIPE
+-- 2026-10-17  3.22     mrosiere Banked RAM2, Add Generic RAM2_NB_BANK
+-- 2026-10-17  3.23     mrosiere Add Generic RAM_SYNC_READ
+-- 2026-10-17  3.24     mrosiere Add instruction cache, Add Generic ICACHE_NB_LINE, ICACHE_LINE_SIZE
+-- 2026-10-17  3.25     mrosiere Shared instruction memory, Add Generic IMEM_SHARED
+-- 2026-10-17  3.26     mrosiere Clusters of CPUs on ICN2, Add Generic CLUSTER_NB_CPU
+-- 2026-10-17  3.27     mrosiere Add Generic MODBUS_RTU
+-- 2026-10-17  3.28     mrosiere Counters of the instruction caches of all the CPUs in debug_o
+-- 2026-10-17  3.29     mrosiere Remove Generic RAM_SYNC_READ
 -------------------------------------------------------------------------------
 
 library ieee;
@@ -49,8 +70,6 @@ use     asylum.SPI_csr_pkg.all;
 use     asylum.GIC_csr_pkg.all;
 use     asylum.timer_csr_pkg.all;
 use     asylum.crc_csr_pkg.all;
-use     asylum.spinlock_csr_pkg.all;
-use     asylum.mailbox_csr_pkg.all;
 -- Modules Packages
 use     asylum.PicoSoC_pkg.all;
 use     asylum.gpio_pkg.all;
@@ -59,8 +78,6 @@ use     asylum.spi_pkg.all;
 use     asylum.gic_pkg.all;
 use     asylum.timer_pkg.all;
 use     asylum.crc_pkg.all;
-use     asylum.spinlock_pkg.all;
-use     asylum.mailbox_pkg.all;
 use     asylum.icn_pkg.all;
 use     asylum.ram_pkg.all;
 use     asylum.ROM_user_pkg.all;
@@ -81,15 +98,31 @@ entity PicoSoC_user is
     ;LOCK_STEP_DEPTH        : natural  := 2
     ;FAULT_INJECTION        : boolean  := False
     ;ICN_TARGET_SEL         : string   := "or"
-    ;ICN_MASTER_SEL         : string   := "fix"
+    ;ICN_MASTER_SEL         : string   := "fix"    -- "fix" / "rr" / "wrr" (ICN2)
+    ;ICN_DMA_WEIGHT         : positive := 4        -- "wrr" : accesses of the DMA per turn (1 for each CPU)
+    ;ICN_XBAR               : boolean  := False    -- ICN2 crossbar : concurrent accesses to distinct targets
+    ;ICN_PIPE               : string   := "none"   -- ICN2 register slices : "none" / "master" / "target" / "all"
     ;NB_CPU                 : natural  := 1
+    ;CLUSTER_NB_CPU         : natural  := 0        -- CPUs per cluster, one ICN2 master per cluster (0 : one ICN2 master per CPU)
     ;CPU_MODEL              : string   := "OpenBlaze8"
     ;RAM1_DEPTH             : natural  := 128
     ;RAM2_DEPTH             : natural  := 64
+    ;RAM2_NB_BANK           : positive := 1        -- > 1 : RAM2 interleaved on banks, one port per ICN2 master
     ;MAILBOX_FIFO0_DEPTH_TX : natural  := 4
     ;MAILBOX_FIFO0_DEPTH_RX : natural  := 4
     ;MAILBOX_FIFO1_DEPTH_TX : natural  := 4
     ;MAILBOX_FIFO1_DEPTH_RX : natural  := 4
+    ;MODBUS_RTU             : boolean  := False    -- Add the Modbus RTU accelerator
+    ;MODBUS_RTU_DEPTH       : positive := 32
+    ;SPI_QUAD               : boolean  := False
+    ;IMEM_RAM               : boolean  := False -- Instruction RAM loaded by the boot stub in ROM
+    ;ICACHE_NB_LINE         : natural  := 0        -- Instruction cache lines (0 : without instruction cache)
+    ;ICACHE_LINE_SIZE       : positive := 4        -- Instructions per line of the instruction cache
+    ;IMEM_SHARED            : positive := 1        -- CPUs sharing one instruction memory (> 1 : needs the instruction cache)
+    ;CRC16_MODEL            : string   := "modbus" -- "modbus" / "xmodem"
+    ;SPINLOCK_MODE          : string   := "tas"    -- "tas" / "ticket"
+    ;ATOMIC_NB_CELL         : positive := 4        -- Up to 64 cells of 32 bits
+    ;BARRIER_HOLD           : boolean  := False    -- CPUs 1 to NB_CPU-1 in reset until CPU 0 arrives at the barrier
     );
   port
     (clk_i                 : in  std_logic
@@ -110,6 +143,9 @@ entity PicoSoC_user is
     ;spi_cs_b_o            : out std_logic
     ;spi_mosi_o            : out std_logic
     ;spi_miso_i            : in  std_logic
+    ;spi_io_o              : out std_logic_vector(4-1 downto 0) -- IO3..IO0 (SPI_QUAD)
+    ;spi_io_oe_o           : out std_logic_vector(4-1 downto 0)
+    ;spi_io_i              : in  std_logic_vector(4-1 downto 0) := (others => '1')
                           
     ;it_i                  : in  std_logic
     ;inject_error_i        : in  std_logic_vector(        3-1 downto 0)
@@ -140,24 +176,84 @@ architecture rtl of PicoSoC_user is
   
   constant ICN1_TARGET_GIC            : integer  := 0;
   constant ICN1_TARGET_RAM1           : integer  := 1;
-  constant ICN1_TARGET_ICN2           : integer  := 2;
+  constant ICN1_TARGET_SPINLOCK       : integer  := 2;
+  constant ICN1_TARGET_ATOMIC         : integer  := 3;
+  constant ICN1_TARGET_BARRIER        : integer  := 4;
+  constant ICN1_TARGET_ICN2           : integer  := 5;
   
-  constant ICN1_NB_TARGET             : positive := 3; -- For default target, add 1 to the number of targets
+  constant ICN1_NB_TARGET             : positive := 6; -- For default target, add 1 to the number of targets
   
   constant ICN1_TARGET_ID             : sbi_addrs_t   (ICN1_NB_TARGET-1 downto 0) :=
     ( ICN1_TARGET_GIC                 => PICOSOC_USER_GIC_BA   
      ,ICN1_TARGET_RAM1                => PICOSOC_USER_RAM1_BA
+     ,ICN1_TARGET_SPINLOCK            => PICOSOC_USER_SPINLOCK_BA
+     ,ICN1_TARGET_ATOMIC              => PICOSOC_USER_ATOMIC_BA
+     ,ICN1_TARGET_BARRIER             => PICOSOC_USER_BARRIER_BA
      ,ICN1_TARGET_ICN2                => CST0
       );
 
   constant ICN1_TARGET_ADDR_WIDTH     : naturals_t    (ICN1_NB_TARGET-1 downto 0) :=
     ( ICN1_TARGET_GIC                 => GIC_ADDR_WIDTH
      ,ICN1_TARGET_RAM1                => log2(RAM1_DEPTH)
+     ,ICN1_TARGET_SPINLOCK            => SPINLOCK_MP_ADDR_WIDTH
+     ,ICN1_TARGET_ATOMIC              => ATOMIC_MP_ADDR_WIDTH
+     ,ICN1_TARGET_BARRIER             => BARRIER_MP_ADDR_WIDTH
      ,ICN1_TARGET_ICN2                => CPU_DMEM_DATA_WIDTH
       );
 
   -- ICN2 (System) Configuration
-  constant ICN2_NB_MASTER             : positive := NB_CPU;
+  -- Clusters : the CPUs of a cluster share one ICN2 master (local round-robin arbiter)
+  constant CLUSTER_ENABLE             : boolean  := CLUSTER_NB_CPU > 0;
+  constant NB_CLUSTER                 : natural  := (NB_CPU+maximum(CLUSTER_NB_CPU,1)-1)/maximum(CLUSTER_NB_CPU,1);
+
+  function icn2_nb_cpu_port return natural is
+  begin
+    if CLUSTER_ENABLE
+    then
+      return NB_CLUSTER;
+    end if;
+
+    return NB_CPU;
+  end function icn2_nb_cpu_port;
+
+  constant ICN2_NB_CPU_PORT           : natural  := icn2_nb_cpu_port;
+  constant ICN2_NB_MASTER             : positive := ICN2_NB_CPU_PORT+1;
+  constant ICN2_MASTER_DMA            : natural  := ICN2_NB_CPU_PORT; -- CPU (or clusters) are 0 to ICN2_NB_CPU_PORT-1
+
+  -- "rr" and "wrr" : masters arbitrated by sbi_arbiter, one master on ICN2
+  -- With ICN_XBAR, one sbi_arbiter per target in the crossbar
+  constant ICN2_ARBITER               : boolean  := not ICN_XBAR and (ICN_MASTER_SEL = "rr" or ICN_MASTER_SEL = "wrr");
+
+  -- Register slices (sbi_slice) : "master" between the masters and ICN2,
+  -- "target" between ICN2 and the targets, "all" both
+  constant ICN2_PIPE_MASTER           : boolean  := ICN_PIPE = "master" or ICN_PIPE = "all";
+  constant ICN2_PIPE_TARGET           : boolean  := ICN_PIPE = "target" or ICN_PIPE = "all";
+
+  function icn2_nb_port return positive is
+  begin
+    if ICN2_ARBITER
+    then
+      return 1;
+    end if;
+
+    return ICN2_NB_MASTER;
+  end function icn2_nb_port;
+
+  function icn2_master_sel return string is
+  begin
+    if ICN2_ARBITER
+    then
+      return "fix";
+    end if;
+
+    return ICN_MASTER_SEL;
+  end function icn2_master_sel;
+
+  constant ICN2_NB_PORT               : positive := icn2_nb_port;
+  constant ICN2_MASTER_WEIGHT         : integer_vector(0 to ICN2_NB_MASTER-1) :=
+    (ICN2_MASTER_DMA                  => ICN_DMA_WEIGHT
+    ,others                           => 1
+    );
 
   constant ICN2_TARGET_ADDR_ENCODING  : string   := PICOSOC_USER_ADDR_ENCODING;
   
@@ -168,11 +264,21 @@ architecture rtl of PicoSoC_user is
   constant ICN2_TARGET_SPI            : integer  := 4;
   constant ICN2_TARGET_TIMER          : integer  := 5;
   constant ICN2_TARGET_CRC            : integer  := 6;
-  constant ICN2_TARGET_SPINLOCK       : integer  := 7;
-  constant ICN2_TARGET_MAILBOX        : integer  := 8;
-  constant ICN2_TARGET_RAM2           : integer  := 9;
+  constant ICN2_TARGET_MAILBOX        : integer  := 7;
+  constant ICN2_TARGET_RAM2           : integer  := 8;
+  constant ICN2_TARGET_MODBUS_RTU     : integer  := 9;
+  constant ICN2_TARGET_DMA            : integer  := 10;
+  constant ICN2_TARGET_BOOT           : integer  := 11;
+  constant ICN2_TARGET_RAM2_HI        : integer  := 12;
   
-  constant ICN2_NB_TARGET             : positive := 10;
+  constant ICN2_NB_TARGET             : positive := 13;
+
+  -- RAM2 : 64 bytes at RAM2_BA, the next 64 bytes at RAM2_HI_BA
+  constant RAM2_LO_DEPTH              : natural  := minimum(RAM2_DEPTH,64);
+  constant RAM2_HI_DEPTH              : natural  := RAM2_DEPTH-RAM2_LO_DEPTH;
+
+  -- Banked RAM2 (sbi_ram_mp) : the ICN2 masters access RAM2 without ICN2
+  constant RAM2_BANKED                : boolean  := RAM2_NB_BANK > 1;
   
   constant ICN2_TARGET_ID             : sbi_addrs_t   (ICN2_NB_TARGET-1 downto 0) :=
     ( ICN2_TARGET_SWITCH              => PICOSOC_USER_SWITCH_BA
@@ -182,9 +288,12 @@ architecture rtl of PicoSoC_user is
      ,ICN2_TARGET_SPI                 => PICOSOC_USER_SPI_BA   
      ,ICN2_TARGET_TIMER               => PICOSOC_USER_TIMER_BA 
      ,ICN2_TARGET_CRC                 => PICOSOC_USER_CRC_BA   
-     ,ICN2_TARGET_SPINLOCK            => PICOSOC_USER_SPINLOCK_BA
      ,ICN2_TARGET_MAILBOX             => PICOSOC_USER_MAILBOX_BA
      ,ICN2_TARGET_RAM2                => PICOSOC_USER_RAM2_BA
+     ,ICN2_TARGET_MODBUS_RTU          => PICOSOC_USER_MODBUS_RTU_BA
+     ,ICN2_TARGET_DMA                 => PICOSOC_USER_DMA_BA
+     ,ICN2_TARGET_BOOT                => PICOSOC_USER_BOOT_BA
+     ,ICN2_TARGET_RAM2_HI             => PICOSOC_USER_RAM2_HI_BA
       );
 
   constant ICN2_TARGET_ADDR_WIDTH     : naturals_t    (ICN2_NB_TARGET-1 downto 0) :=
@@ -195,16 +304,40 @@ architecture rtl of PicoSoC_user is
      ,ICN2_TARGET_SPI                 => SPI_ADDR_WIDTH
      ,ICN2_TARGET_TIMER               => TIMER_ADDR_WIDTH
      ,ICN2_TARGET_CRC                 => CRC_ADDR_WIDTH
-     ,ICN2_TARGET_SPINLOCK            => SPINLOCK_ADDR_WIDTH
-     ,ICN2_TARGET_MAILBOX             => MAILBOX_ADDR_WIDTH
-     ,ICN2_TARGET_RAM2                => log2(RAM2_DEPTH)
+     ,ICN2_TARGET_MAILBOX             => MAILBOX_IT_ADDR_WIDTH
+     ,ICN2_TARGET_RAM2                => log2(RAM2_LO_DEPTH)
+     ,ICN2_TARGET_MODBUS_RTU          => MODBUS_RTU_ADDR_WIDTH
+     ,ICN2_TARGET_DMA                 => DMA_ADDR_WIDTH
+     ,ICN2_TARGET_BOOT                => BOOT_ADDR_WIDTH
+     ,ICN2_TARGET_RAM2_HI             => log2(maximum(RAM2_HI_DEPTH,1))
       );
   
+  -- Signals ICN2 - CPU (before the clusters)
+  signal   cpu_icn2_sbi_inis          : sbi_inis_t(NB_CPU-1 downto 0)(addr (CPU_DMEM_ADDR_WIDTH-1 downto 0),
+                                                                      wdata(CPU_DMEM_DATA_WIDTH-1 downto 0));
+  signal   cpu_icn2_sbi_tgts          : sbi_tgts_t(NB_CPU-1 downto 0)(rdata(CPU_DMEM_DATA_WIDTH-1 downto 0));
+
   -- Signals ICN2 - System
   signal   icn2_sbi_inim              : sbi_inis_t(ICN2_NB_MASTER-1 downto 0)(addr (CPU_DMEM_ADDR_WIDTH-1 downto 0),
                                                                               wdata(CPU_DMEM_DATA_WIDTH-1 downto 0));
   signal   icn2_sbi_tgtm              : sbi_tgts_t(ICN2_NB_MASTER-1 downto 0)(rdata(CPU_DMEM_DATA_WIDTH-1 downto 0));
 
+  signal   icn2_sbi_inir              : sbi_inis_t(ICN2_NB_MASTER-1 downto 0)(addr (CPU_DMEM_ADDR_WIDTH-1 downto 0),
+                                                                              wdata(CPU_DMEM_DATA_WIDTH-1 downto 0));
+  signal   icn2_sbi_tgtr              : sbi_tgts_t(ICN2_NB_MASTER-1 downto 0)(rdata(CPU_DMEM_DATA_WIDTH-1 downto 0));
+
+  signal   icn2_sbi_inib              : sbi_inis_t(ICN2_NB_MASTER-1 downto 0)(addr (CPU_DMEM_ADDR_WIDTH-1 downto 0),
+                                                                              wdata(CPU_DMEM_DATA_WIDTH-1 downto 0));
+  signal   icn2_sbi_tgtb              : sbi_tgts_t(ICN2_NB_MASTER-1 downto 0)(rdata(CPU_DMEM_DATA_WIDTH-1 downto 0));
+
+  signal   icn2_sbi_inip              : sbi_inis_t(ICN2_NB_PORT-1 downto 0)(addr (CPU_DMEM_ADDR_WIDTH-1 downto 0),
+                                                                            wdata(CPU_DMEM_DATA_WIDTH-1 downto 0));
+  signal   icn2_sbi_tgtp              : sbi_tgts_t(ICN2_NB_PORT-1 downto 0)(rdata(CPU_DMEM_DATA_WIDTH-1 downto 0));
+
+  signal   icn2_sbi_inio              : sbi_inis_t(ICN2_NB_TARGET-1 downto 0)(addr (CPU_DMEM_ADDR_WIDTH-1 downto 0),
+                                                                              wdata(CPU_DMEM_DATA_WIDTH-1 downto 0));
+  signal   icn2_sbi_tgto              : sbi_tgts_t(ICN2_NB_TARGET-1 downto 0)(rdata(CPU_DMEM_DATA_WIDTH-1 downto 0));
+
   signal   icn2_sbi_inis              : sbi_inis_t(ICN2_NB_TARGET-1 downto 0)(addr (CPU_DMEM_ADDR_WIDTH-1 downto 0),
                                                                               wdata(CPU_DMEM_DATA_WIDTH-1 downto 0));
   signal   icn2_sbi_tgts              : sbi_tgts_t(ICN2_NB_TARGET-1 downto 0)(rdata(CPU_DMEM_DATA_WIDTH-1 downto 0));
@@ -215,17 +348,70 @@ architecture rtl of PicoSoC_user is
 
   -- UART
   signal   uart_it                    : std_logic;
+
+  -- Modbus RTU
+  signal   modbus_rtu_it              : std_logic;
+
+  -- DMA
+  signal   dma_it                     : std_logic;
+
+  -- Mailbox
+  signal   mailbox_it                 : std_logic_vector(2-1 downto 0);
+
+  -- Banked RAM2 (one port per ICN2 master)
+  signal   ram2_sbi_inis              : sbi_inis_t(ICN2_NB_MASTER-1 downto 0)(addr (CPU_DMEM_ADDR_WIDTH-1 downto 0),
+                                                                              wdata(CPU_DMEM_DATA_WIDTH-1 downto 0));
+  signal   ram2_sbi_tgts              : sbi_tgts_t(ICN2_NB_MASTER-1 downto 0)(rdata(CPU_DMEM_DATA_WIDTH-1 downto 0));
+
+  -- Spinlock (one port per CPU)
+  signal   spinlock_sbi_inis          : sbi_inis_t(NB_CPU-1 downto 0)(addr (CPU_DMEM_ADDR_WIDTH-1 downto 0),
+                                                                      wdata(CPU_DMEM_DATA_WIDTH-1 downto 0));
+  signal   spinlock_sbi_tgts          : sbi_tgts_t(NB_CPU-1 downto 0)(rdata(CPU_DMEM_DATA_WIDTH-1 downto 0));
+  signal   spinlock_it                : std_logic_vector(NB_CPU-1 downto 0);
+
+  -- Atomic (one port per CPU)
+  signal   atomic_sbi_inis            : sbi_inis_t(NB_CPU-1 downto 0)(addr (CPU_DMEM_ADDR_WIDTH-1 downto 0),
+                                                                      wdata(CPU_DMEM_DATA_WIDTH-1 downto 0));
+  signal   atomic_sbi_tgts            : sbi_tgts_t(NB_CPU-1 downto 0)(rdata(CPU_DMEM_DATA_WIDTH-1 downto 0));
+
+  -- Barrier (one port per CPU)
+  signal   barrier_sbi_inis           : sbi_inis_t(NB_CPU-1 downto 0)(addr (CPU_DMEM_ADDR_WIDTH-1 downto 0),
+                                                                      wdata(CPU_DMEM_DATA_WIDTH-1 downto 0));
+  signal   barrier_sbi_tgts           : sbi_tgts_t(NB_CPU-1 downto 0)(rdata(CPU_DMEM_DATA_WIDTH-1 downto 0));
+  signal   barrier_cpu_run            : std_logic_vector(NB_CPU-1 downto 0);
+
+  -- Boot
+  signal   boot                       : std_logic; -- 1 : CPU fetch from the instruction RAM
+  signal   cpu_arst_b                 : std_logic;
+  signal   imem_we                    : std_logic;
+  signal   imem_addr                  : std_logic_vector(CPU_IMEM_ADDR_WIDTH-1 downto 0);
+  signal   imem_data                  : std_logic_vector(CPU_IMEM_DATA_WIDTH-1 downto 0);
+
+  -- Shared instruction memory (one port per CPU)
+  constant IMEM_NB_GROUP              : natural  := (NB_CPU+IMEM_SHARED-1)/IMEM_SHARED;
+  signal   imem_sbi_inis              : sbi_inis_t(NB_CPU-1 downto 0)(addr (CPU_IMEM_ADDR_WIDTH-1 downto 0),
+                                                                      wdata(CPU_IMEM_DATA_WIDTH-1 downto 0));
+  signal   imem_sbi_tgts              : sbi_tgts_t(NB_CPU-1 downto 0)(rdata(CPU_IMEM_DATA_WIDTH-1 downto 0));
   
   -- Interruption Vector
   constant GIC_IT_USER                : natural  := PICOSOC_USER_GIC_IT_USER;
   constant GIC_UART                   : natural  := PICOSOC_USER_GIC_UART   ;
   constant GIC_TIMER                  : natural  := PICOSOC_USER_GIC_TIMER  ;
+  constant GIC_MODBUS_RTU             : natural  := PICOSOC_USER_GIC_MODBUS_RTU;
+  constant GIC_DMA                    : natural  := PICOSOC_USER_GIC_DMA;
+  constant GIC_MAILBOX0               : natural  := PICOSOC_USER_GIC_MAILBOX0;
+  constant GIC_MAILBOX1               : natural  := PICOSOC_USER_GIC_MAILBOX1;
+  constant GIC_SPINLOCK               : natural  := PICOSOC_USER_GIC_SPINLOCK;
 
-  constant GIC_WIDTH                  : positive := 3;
+  constant GIC_WIDTH                  : positive := 8;
 
   constant GIC_ITS_SYNC_ENABLE        : std_logic_vector(GIC_WIDTH-1 downto 0) := (GIC_IT_USER => '0',
                                                                                    others      => '0');
 
+  -- Instruction cache counters (one per CPU)
+  signal   icache_hits                : slvs_t(NB_CPU-1 downto 0)(16-1 downto 0);
+  signal   icache_misses              : slvs_t(NB_CPU-1 downto 0)(16-1 downto 0);
+
   -- Timer
   signal   timer_disable              : std_logic;
   signal   timer_clear                : std_logic;
@@ -243,14 +429,28 @@ begin  -- architecture rtl
   -----------------------------------------------------------------------------
   -- CPU with Safety Logic
   -----------------------------------------------------------------------------
+  -- The lock-step delay pipe is not frozen with the CPUs
+  assert ICACHE_NB_LINE = 0 or SAFETY /= "lock-step" or LOCK_STEP_DEPTH = 0
+    report "ICACHE_NB_LINE > 0 needs LOCK_STEP_DEPTH = 0 with lock-step" severity failure;
+
   gen_cpu_cluster : for i in 0 to NB_CPU-1
    
   generate
     -- Signals CPU (post lockstep / TMR)
+  signal   cpu_run_arst_b             : std_logic;
+  signal   cpu_cke                    : std_logic;
   signal   cpu_ics                    : std_logic;
   signal   cpu_iaddr                  : std_logic_vector(CPU_IMEM_ADDR_WIDTH-1 downto 0);
   signal   cpu_idata                  : std_logic_vector(CPU_IMEM_DATA_WIDTH-1 downto 0);
 
+  -- Signals Instruction memory (after the instruction cache)
+  signal   mem_ics                    : std_logic;
+  signal   mem_iaddr                  : std_logic_vector(CPU_IMEM_ADDR_WIDTH-1 downto 0);
+  signal   mem_iready                 : std_logic;
+  signal   mem_idata                  : std_logic_vector(CPU_IMEM_DATA_WIDTH-1 downto 0);
+  signal   icache_hit                 : std_logic_vector(16-1 downto 0);
+  signal   icache_miss                : std_logic_vector(16-1 downto 0);
+
   signal   cpu_sbi_ini                : sbi_ini_t(addr (CPU_DMEM_ADDR_WIDTH-1 downto 0),
                                                   wdata(CPU_DMEM_DATA_WIDTH-1 downto 0));
   signal   cpu_sbi_tgt                : sbi_tgt_t(rdata(CPU_DMEM_DATA_WIDTH-1 downto 0));
@@ -283,6 +483,12 @@ begin  -- architecture rtl
       debug_o.cpu_dready  <= cpu_sbi_tgt.ready                ;
     end generate;
 
+    icache_hits  (i) <= icache_hit ;
+    icache_misses(i) <= icache_miss;
+
+    -- CPU held in reset by the barrier (BARRIER_HOLD)
+    cpu_run_arst_b <= cpu_arst_b and barrier_cpu_run(i);
+
     ins_cpu_safety : cpu_safety
       generic map
       (SAFETY               => SAFETY
@@ -297,8 +503,8 @@ begin  -- architecture rtl
        )
       port map
       (clk_i                => clk         
-      ,cke_i                => '1'         
-      ,arst_b_i             => arst_b
+      ,cke_i                => cpu_cke
+      ,arst_b_i             => cpu_run_arst_b
       ,ics_o                => cpu_ics
       ,iaddr_o              => cpu_iaddr
       ,idata_i              => cpu_idata
@@ -310,19 +516,122 @@ begin  -- architecture rtl
       ,diff_o               => diff_o
       );
 
-    icn1_sbi_inim(0)    <= cpu_sbi_ini;
+    -- No data access while the CPU is frozen
+    p_cpu_sbi_ini: process (all) is
+    begin
+      icn1_sbi_inim(0)    <= cpu_sbi_ini;
+      icn1_sbi_inim(0).cs <= cpu_sbi_ini.cs and cpu_cke;
+    end process p_cpu_sbi_ini;
+
     cpu_sbi_tgt         <= icn1_sbi_tgtm(0);
 
     -----------------------------------------------------------------------------
-    -- CPU ROM
+    -- CPU Instruction Cache
+    -- The CPU is frozen (cpu_cke = 0) during a miss
     -----------------------------------------------------------------------------
-    ins_ROM_user : entity asylum.ROM_user(rom)
-      port map
-      (clk_i                => clk      
-      ,cke_i                => cpu_ics  
-      ,address_i            => cpu_iaddr
-      ,instruction_o        => cpu_idata
-      );
+    gen_icache:
+    if ICACHE_NB_LINE > 0
+    generate
+      signal cpu_stall        : std_logic;
+    begin
+      ins_icache : icache
+        generic map
+        (ADDR_WIDTH           => CPU_IMEM_ADDR_WIDTH
+        ,DATA_WIDTH           => CPU_IMEM_DATA_WIDTH
+        ,NB_LINE              => ICACHE_NB_LINE
+        ,LINE_SIZE            => ICACHE_LINE_SIZE
+        ,CNT_WIDTH            => 16
+        )
+        port map
+        (clk_i                => clk
+        ,arst_b_i             => cpu_run_arst_b
+        ,cs_i                 => cpu_ics
+        ,addr_i               => cpu_iaddr
+        ,data_o               => cpu_idata
+        ,stall_o              => cpu_stall
+        ,mem_cs_o             => mem_ics
+        ,mem_addr_o           => mem_iaddr
+        ,mem_ready_i          => mem_iready
+        ,mem_data_i           => mem_idata
+        ,hit_o                => icache_hit
+        ,miss_o               => icache_miss
+        );
+
+      cpu_cke     <= not cpu_stall;
+    end generate gen_icache;
+
+    gen_icache_b:
+    if ICACHE_NB_LINE = 0
+    generate
+      cpu_cke     <= '1';
+      mem_ics     <= cpu_ics;
+      mem_iaddr   <= cpu_iaddr;
+      cpu_idata   <= mem_idata;
+      icache_hit  <= (others => '0');
+      icache_miss <= (others => '0');
+    end generate gen_icache_b;
+
+    -----------------------------------------------------------------------------
+    -- CPU Instruction Memory
+    -- Private (IMEM_SHARED = 1) or shared by IMEM_SHARED CPUs (gen_imem_shared)
+    -----------------------------------------------------------------------------
+    gen_imem_private:
+    if IMEM_SHARED = 1
+    generate
+      signal rom_idata        : std_logic_vector(CPU_IMEM_DATA_WIDTH-1 downto 0);
+      signal ram_idata        : std_logic_vector(CPU_IMEM_DATA_WIDTH-1 downto 0);
+    begin
+      ins_ROM_user : entity asylum.ROM_user(rom)
+        port map
+        (clk_i                => clk      
+        ,cke_i                => mem_ics  
+        ,address_i            => mem_iaddr
+        ,instruction_o        => rom_idata
+        );
+
+      -- Instruction RAM, written by the boot loader, same content for all CPUs
+      gen_imem_ram:
+      if IMEM_RAM
+      generate
+        ins_imem_ram : imem_ram
+          generic map
+          (ADDR_WIDTH           => CPU_IMEM_ADDR_WIDTH
+          ,DATA_WIDTH           => CPU_IMEM_DATA_WIDTH
+          )
+          port map
+          (clk_i                => clk      
+          ,cke_i                => mem_ics  
+          ,address_i            => mem_iaddr
+          ,instruction_o        => ram_idata
+          ,we_i                 => imem_we
+          ,waddr_i              => imem_addr
+          ,wdata_i              => imem_data
+          );
+      end generate gen_imem_ram;
+
+      gen_imem_ram_b:
+      if not IMEM_RAM
+      generate
+        ram_idata <= (others => '0');
+      end generate gen_imem_ram_b;
+
+      mem_idata  <= ram_idata when boot = '1' else
+                    rom_idata;
+      mem_iready <= '1';
+    end generate gen_imem_private;
+
+    gen_imem_private_b:
+    if IMEM_SHARED > 1
+    generate
+      imem_sbi_inis(i).cs    <= mem_ics;
+      imem_sbi_inis(i).re    <= mem_ics;
+      imem_sbi_inis(i).we    <= '0';
+      imem_sbi_inis(i).addr  <= mem_iaddr;
+      imem_sbi_inis(i).wdata <= (others => '0');
+
+      mem_iready <= imem_sbi_tgts(i).ready;
+      mem_idata  <= imem_sbi_tgts(i).rdata;
+    end generate gen_imem_private_b;
 
     -----------------------------------------------------------------------------
     -- Interconnect
@@ -350,8 +659,17 @@ begin  -- architecture rtl
       ,sbi_tgts_i             => icn1_sbi_tgts
       );
 
-    icn2_sbi_inim(i)                <= icn1_sbi_inis(ICN1_TARGET_ICN2);
-    icn1_sbi_tgts(ICN1_TARGET_ICN2) <= icn2_sbi_tgtm(i);
+    cpu_icn2_sbi_inis(i)            <= icn1_sbi_inis(ICN1_TARGET_ICN2);
+    icn1_sbi_tgts(ICN1_TARGET_ICN2) <= cpu_icn2_sbi_tgts(i);
+
+    spinlock_sbi_inis(i)                <= icn1_sbi_inis(ICN1_TARGET_SPINLOCK);
+    icn1_sbi_tgts(ICN1_TARGET_SPINLOCK) <= spinlock_sbi_tgts(i);
+
+    atomic_sbi_inis(i)                  <= icn1_sbi_inis(ICN1_TARGET_ATOMIC);
+    icn1_sbi_tgts(ICN1_TARGET_ATOMIC)   <= atomic_sbi_tgts(i);
+
+    barrier_sbi_inis(i)                 <= icn1_sbi_inis(ICN1_TARGET_BARRIER);
+    icn1_sbi_tgts(ICN1_TARGET_BARRIER)  <= barrier_sbi_tgts(i);
 
     -----------------------------------------------------------------------------
     -- GIC - Interruption Vector
@@ -360,6 +678,13 @@ begin  -- architecture rtl
     gic_it_vector(GIC_IT_USER) <= it_i   ;
     gic_it_vector(GIC_UART   ) <= uart_it;
     gic_it_vector(GIC_TIMER  ) <= timer_it;
+    gic_it_vector(GIC_MODBUS_RTU) <= modbus_rtu_it;
+    gic_it_vector(GIC_DMA    ) <= dma_it;
+    -- The receiver of a FIFO enables its line in its own GIC
+    gic_it_vector(GIC_MAILBOX0) <= mailbox_it(0);
+    gic_it_vector(GIC_MAILBOX1) <= mailbox_it(1);
+    -- Lock given to this CPU ("ticket")
+    gic_it_vector(GIC_SPINLOCK) <= spinlock_it(i);
   
     ins_sbi_gic : sbi_GIC
       generic map
@@ -380,7 +705,7 @@ begin  -- architecture rtl
     ins_sbi_ram1 : sbi_ram
       generic map
       (DEPTH                => RAM1_DEPTH
-      ,SYNC_READ            => true   
+      ,SYNC_READ            => true
      )
       port map
       (clk_i                => clk         
@@ -392,30 +717,317 @@ begin  -- architecture rtl
   end generate;
 
   -----------------------------------------------------------------------------
-  -- Interconnect
-  -- From 1 Initiator to N Target
+  -- Shared Instruction Memory
+  -- One ROM_user (and imem_ram) per group of IMEM_SHARED CPUs, round-robin
+  -- between the instruction caches of the group
   -----------------------------------------------------------------------------
-  ins_sbi_icn2 : sbi_icn
-    generic map
-    (NAME                   => "ICN2_user"
-    ,NB_MASTER              => ICN2_NB_MASTER
-    ,MASTER_SEL             => ICN_MASTER_SEL
-    ,NB_TARGET              => ICN2_NB_TARGET
-    ,TARGET_SEL             => ICN_TARGET_SEL
-    ,TARGET_ID              => ICN2_TARGET_ID
-    ,TARGET_ADDR_WIDTH      => ICN2_TARGET_ADDR_WIDTH
-    ,TARGET_ADDR_ENCODING   => ICN2_TARGET_ADDR_ENCODING
-    ,INTERNAL_DEFAULT_SLAVE => true
+  assert IMEM_SHARED = 1 or ICACHE_NB_LINE > 0 report "IMEM_SHARED > 1 needs the instruction cache (ICACHE_NB_LINE > 0)" severity failure;
+
+  gen_imem_shared:
+  if IMEM_SHARED > 1
+  generate
+    gen_imem_group: for g in 0 to IMEM_NB_GROUP-1
+    generate
+      constant FIRST          : natural  := g*IMEM_SHARED;
+      constant NB_PORT        : positive := minimum(NB_CPU-FIRST, IMEM_SHARED);
+
+      signal   grp_sbi_inis   : sbi_inis_t(NB_PORT-1 downto 0)(addr (CPU_IMEM_ADDR_WIDTH-1 downto 0),
+                                                               wdata(CPU_IMEM_DATA_WIDTH-1 downto 0));
+      signal   grp_sbi_tgts   : sbi_tgts_t(NB_PORT-1 downto 0)(rdata(CPU_IMEM_DATA_WIDTH-1 downto 0));
+      signal   mem_sbi_ini    : sbi_ini_t (addr (CPU_IMEM_ADDR_WIDTH-1 downto 0),
+                                           wdata(CPU_IMEM_DATA_WIDTH-1 downto 0));
+      signal   mem_sbi_tgt    : sbi_tgt_t (rdata(CPU_IMEM_DATA_WIDTH-1 downto 0));
+      signal   rom_idata      : std_logic_vector(CPU_IMEM_DATA_WIDTH-1 downto 0);
+      signal   ram_idata      : std_logic_vector(CPU_IMEM_DATA_WIDTH-1 downto 0);
+    begin
+
+      gen_port: for p in 0 to NB_PORT-1
+      generate
+        grp_sbi_inis(p)           <= imem_sbi_inis(FIRST+p);
+        imem_sbi_tgts(FIRST+p)    <= grp_sbi_tgts(p);
+      end generate gen_port;
+
+      ins_sbi_arbiter : sbi_arbiter
+        generic map
+        (NB_MASTER              => NB_PORT
+        ,ALGO                   => "rr"
+        )
+        port map
+        (clk_i                  => clk
+        ,arst_b_i               => arst_b
+        ,sbi_inis_i             => grp_sbi_inis
+        ,sbi_tgts_o             => grp_sbi_tgts
+        ,sbi_ini_o              => mem_sbi_ini
+        ,sbi_tgt_i              => mem_sbi_tgt
+        );
+
+      ins_ROM_user : entity asylum.ROM_user(rom)
+        port map
+        (clk_i                => clk      
+        ,cke_i                => mem_sbi_ini.cs
+        ,address_i            => mem_sbi_ini.addr
+        ,instruction_o        => rom_idata
+        );
+
+      -- Instruction RAM, written by the boot loader, same content for all CPUs
+      gen_imem_ram:
+      if IMEM_RAM
+      generate
+        ins_imem_ram : imem_ram
+          generic map
+          (ADDR_WIDTH           => CPU_IMEM_ADDR_WIDTH
+          ,DATA_WIDTH           => CPU_IMEM_DATA_WIDTH
+          )
+          port map
+          (clk_i                => clk      
+          ,cke_i                => mem_sbi_ini.cs
+          ,address_i            => mem_sbi_ini.addr
+          ,instruction_o        => ram_idata
+          ,we_i                 => imem_we
+          ,waddr_i              => imem_addr
+          ,wdata_i              => imem_data
+          );
+      end generate gen_imem_ram;
+
+      gen_imem_ram_b:
+      if not IMEM_RAM
+      generate
+        ram_idata <= (others => '0');
+      end generate gen_imem_ram_b;
+
+      -- One request per cycle, the instruction is read the next cycle
+      -- (broadcast to the caches of the group)
+      mem_sbi_tgt.ready <= '1';
+      mem_sbi_tgt.rdata <= ram_idata when boot = '1' else
+                           rom_idata;
+    end generate gen_imem_group;
+  end generate gen_imem_shared;
+
+  -----------------------------------------------------------------------------
+  -- Clusters of CPUs
+  -- Local interconnect : round-robin between the CPUs of the cluster, one
+  -- ICN2 master per cluster. With RAM2_NB_BANK > 1, each cluster has its own
+  -- port on RAM2 (gen_icn2_ram2)
+  -----------------------------------------------------------------------------
+  gen_cluster:
+  if CLUSTER_ENABLE
+  generate
+    gen_cluster_c: for c in 0 to NB_CLUSTER-1
+    generate
+      constant FIRST          : natural  := c*CLUSTER_NB_CPU;
+      constant NB_PORT        : positive := minimum(NB_CPU-FIRST, CLUSTER_NB_CPU);
+
+      signal   grp_sbi_inis   : sbi_inis_t(NB_PORT-1 downto 0)(addr (CPU_DMEM_ADDR_WIDTH-1 downto 0),
+                                                               wdata(CPU_DMEM_DATA_WIDTH-1 downto 0));
+      signal   grp_sbi_tgts   : sbi_tgts_t(NB_PORT-1 downto 0)(rdata(CPU_DMEM_DATA_WIDTH-1 downto 0));
+    begin
+
+      gen_port: for p in 0 to NB_PORT-1
+      generate
+        grp_sbi_inis(p)            <= cpu_icn2_sbi_inis(FIRST+p);
+        cpu_icn2_sbi_tgts(FIRST+p) <= grp_sbi_tgts(p);
+      end generate gen_port;
+
+      ins_sbi_arbiter : sbi_arbiter
+        generic map
+        (NB_MASTER              => NB_PORT
+        ,ALGO                   => "rr"
+        )
+        port map
+        (clk_i                  => clk
+        ,arst_b_i               => arst_b
+        ,sbi_inis_i             => grp_sbi_inis
+        ,sbi_tgts_o             => grp_sbi_tgts
+        ,sbi_ini_o              => icn2_sbi_inim(c)
+        ,sbi_tgt_i              => icn2_sbi_tgtm(c)
+        );
+    end generate gen_cluster_c;
+  end generate gen_cluster;
+
+  gen_cluster_b:
+  if not CLUSTER_ENABLE
+  generate
+    gen_cpu: for i in 0 to NB_CPU-1
+    generate
+      icn2_sbi_inim(i)     <= cpu_icn2_sbi_inis(i);
+      cpu_icn2_sbi_tgts(i) <= icn2_sbi_tgtm(i);
+    end generate gen_cpu;
+  end generate gen_cluster_b;
+
+  -----------------------------------------------------------------------------
+  -- Register slices of the ICN2 masters
+  -----------------------------------------------------------------------------
+  assert ICN_PIPE = "none" or ICN2_PIPE_MASTER or ICN2_PIPE_TARGET report "ICN_PIPE must be none, master, target or all" severity failure;
+
+  gen_icn2_pipe_master: for i in 0 to ICN2_NB_MASTER-1
+  generate
+    gen_slice:
+    if ICN2_PIPE_MASTER
+    generate
+      ins_sbi_slice : sbi_slice
+        port map
+        (clk_i                  => clk
+        ,arst_b_i               => arst_b
+        ,sbi_ini_i              => icn2_sbi_inim(i)
+        ,sbi_tgt_o              => icn2_sbi_tgtm(i)
+        ,sbi_ini_o              => icn2_sbi_inir(i)
+        ,sbi_tgt_i              => icn2_sbi_tgtr(i)
+        );
+    end generate gen_slice;
+
+    gen_slice_b:
+    if not ICN2_PIPE_MASTER
+    generate
+      icn2_sbi_inir(i) <= icn2_sbi_inim(i);
+      icn2_sbi_tgtm(i) <= icn2_sbi_tgtr(i);
+    end generate gen_slice_b;
+  end generate gen_icn2_pipe_master;
+
+  -----------------------------------------------------------------------------
+  -- Banked RAM2 : accesses of the ICN2 masters in the RAM2 window
+  -----------------------------------------------------------------------------
+  gen_icn2_ram2: for i in 0 to ICN2_NB_MASTER-1
+  generate
+    gen_banked:
+    if RAM2_BANKED
+    generate
+      constant RAM2_ADDR_WIDTH : natural := ICN2_TARGET_ADDR_WIDTH(ICN2_TARGET_RAM2);
+      signal   ram2            : std_logic;
+    begin
+      ram2 <= '1' when icn2_sbi_inir(i).addr(CPU_DMEM_ADDR_WIDTH-1 downto RAM2_ADDR_WIDTH) = ICN2_TARGET_ID(ICN2_TARGET_RAM2)(CPU_DMEM_ADDR_WIDTH-1 downto RAM2_ADDR_WIDTH) else
+              '0';
+
+      p_split: process (all) is
+      begin
+        ram2_sbi_inis(i)    <= icn2_sbi_inir(i);
+        ram2_sbi_inis(i).cs <= icn2_sbi_inir(i).cs and ram2;
+        icn2_sbi_inib(i)    <= icn2_sbi_inir(i);
+        icn2_sbi_inib(i).cs <= icn2_sbi_inir(i).cs and not ram2;
+      end process p_split;
+
+      icn2_sbi_tgtr(i) <= ram2_sbi_tgts(i) when ram2 = '1' else
+                          icn2_sbi_tgtb(i);
+    end generate gen_banked;
+
+    gen_banked_b:
+    if not RAM2_BANKED
+    generate
+      icn2_sbi_inib(i) <= icn2_sbi_inir(i);
+      icn2_sbi_tgtr(i) <= icn2_sbi_tgtb(i);
+    end generate gen_banked_b;
+  end generate gen_icn2_ram2;
+
+  -----------------------------------------------------------------------------
+  -- Interconnect (crossbar)
+  -- From N Initiator to N Target, one arbiter per target
+  -----------------------------------------------------------------------------
+  gen_icn2_xbar:
+  if ICN_XBAR
+  generate
+    ins_sbi_xbar2 : sbi_xbar
+      generic map
+      (NB_MASTER              => ICN2_NB_MASTER
+      ,MASTER_SEL             => ICN_MASTER_SEL
+      ,MASTER_WEIGHT          => ICN2_MASTER_WEIGHT
+      ,NB_TARGET              => ICN2_NB_TARGET
+      ,TARGET_ID              => ICN2_TARGET_ID
+      ,TARGET_ADDR_WIDTH      => ICN2_TARGET_ADDR_WIDTH
       )
-    port map
-    (clk_i                  => clk      
-    ,cke_i                  => '1'         
-    ,arst_b_i               => arst_b      
-    ,sbi_inis_i             => icn2_sbi_inim
-    ,sbi_tgts_o             => icn2_sbi_tgtm
-    ,sbi_inis_o             => icn2_sbi_inis
-    ,sbi_tgts_i             => icn2_sbi_tgts
-    );
+      port map
+      (clk_i                  => clk      
+      ,arst_b_i               => arst_b      
+      ,sbi_inis_i             => icn2_sbi_inib
+      ,sbi_tgts_o             => icn2_sbi_tgtb
+      ,sbi_inis_o             => icn2_sbi_inio
+      ,sbi_tgts_i             => icn2_sbi_tgto
+      );
+  end generate gen_icn2_xbar;
+
+  gen_icn2_bus:
+  if not ICN_XBAR
+  generate
+    ---------------------------------------------------------------------------
+    -- Arbiter of the ICN2 masters
+    ---------------------------------------------------------------------------
+    gen_icn2_arbiter:
+    if ICN2_ARBITER
+    generate
+      ins_sbi_arbiter : sbi_arbiter
+        generic map
+        (NB_MASTER              => ICN2_NB_MASTER
+        ,ALGO                   => ICN_MASTER_SEL
+        ,WEIGHT                 => ICN2_MASTER_WEIGHT
+        )
+        port map
+        (clk_i                  => clk      
+        ,arst_b_i               => arst_b      
+        ,sbi_inis_i             => icn2_sbi_inib
+        ,sbi_tgts_o             => icn2_sbi_tgtb
+        ,sbi_ini_o              => icn2_sbi_inip(0)
+        ,sbi_tgt_i              => icn2_sbi_tgtp(0)
+        );
+    end generate gen_icn2_arbiter;
+
+    gen_icn2_arbiter_b:
+    if not ICN2_ARBITER
+    generate
+      icn2_sbi_inip <= icn2_sbi_inib;
+      icn2_sbi_tgtb <= icn2_sbi_tgtp;
+    end generate gen_icn2_arbiter_b;
+
+    ---------------------------------------------------------------------------
+    -- Interconnect
+    -- From 1 Initiator to N Target
+    ---------------------------------------------------------------------------
+    ins_sbi_icn2 : sbi_icn
+      generic map
+      (NAME                   => "ICN2_user"
+      ,NB_MASTER              => ICN2_NB_PORT
+      ,MASTER_SEL             => icn2_master_sel
+      ,NB_TARGET              => ICN2_NB_TARGET
+      ,TARGET_SEL             => ICN_TARGET_SEL
+      ,TARGET_ID              => ICN2_TARGET_ID
+      ,TARGET_ADDR_WIDTH      => ICN2_TARGET_ADDR_WIDTH
+      ,TARGET_ADDR_ENCODING   => ICN2_TARGET_ADDR_ENCODING
+      ,INTERNAL_DEFAULT_SLAVE => true
+        )
+      port map
+      (clk_i                  => clk      
+      ,cke_i                  => '1'         
+      ,arst_b_i               => arst_b      
+      ,sbi_inis_i             => icn2_sbi_inip
+      ,sbi_tgts_o             => icn2_sbi_tgtp
+      ,sbi_inis_o             => icn2_sbi_inio
+      ,sbi_tgts_i             => icn2_sbi_tgto
+      );
+  end generate gen_icn2_bus;
+
+  -----------------------------------------------------------------------------
+  -- Register slices of the ICN2 targets
+  -----------------------------------------------------------------------------
+  gen_icn2_pipe_target: for i in 0 to ICN2_NB_TARGET-1
+  generate
+    gen_slice:
+    if ICN2_PIPE_TARGET
+    generate
+      ins_sbi_slice : sbi_slice
+        port map
+        (clk_i                  => clk
+        ,arst_b_i               => arst_b
+        ,sbi_ini_i              => icn2_sbi_inio(i)
+        ,sbi_tgt_o              => icn2_sbi_tgto(i)
+        ,sbi_ini_o              => icn2_sbi_inis(i)
+        ,sbi_tgt_i              => icn2_sbi_tgts(i)
+        );
+    end generate gen_slice;
+
+    gen_slice_b:
+    if not ICN2_PIPE_TARGET
+    generate
+      icn2_sbi_inis(i) <= icn2_sbi_inio(i);
+      icn2_sbi_tgto(i) <= icn2_sbi_tgts(i);
+    end generate gen_slice_b;
+  end generate gen_icn2_pipe_target;
 
   -----------------------------------------------------------------------------
   -- GPIO 0 - Switch
@@ -512,6 +1124,9 @@ begin  -- architecture rtl
   -----------------------------------------------------------------------------
   -- SPI
   -----------------------------------------------------------------------------
+  gen_spi:
+  if not SPI_QUAD
+  generate
   ins_sbi_spi : sbi_spi
     generic map
     (USER_DEFINE_PRESCALER=> true
@@ -534,6 +1149,33 @@ begin  -- architecture rtl
     ,miso_i               => spi_miso_i   
      );
 
+    spi_io_o    <= (others => '0');
+    spi_io_oe_o <= (others => '0');
+  end generate gen_spi;
+
+  -- Dual/Quad SPI : the flash is on spi_io (IO0 is also on spi_mosi_o)
+  gen_spi_quad:
+  if SPI_QUAD
+  generate
+  ins_sbi_spi_quad : sbi_spi_quad
+    generic map
+    (PRESCALER_RATIO      => x"00"
+     )
+    port map
+    (clk_i                => clk           
+    ,arst_b_i             => arst_b        
+    ,sbi_ini_i            => icn2_sbi_inis(ICN2_TARGET_SPI)   
+    ,sbi_tgt_o            => icn2_sbi_tgts(ICN2_TARGET_SPI)   
+    ,sclk_o               => spi_sclk_o   
+    ,cs_b_o               => spi_cs_b_o   
+    ,io_o                 => spi_io_o
+    ,io_oe_o              => spi_io_oe_o
+    ,io_i                 => spi_io_i
+     );
+
+    spi_mosi_o  <= spi_io_o(0);
+  end generate gen_spi_quad;
+
   -----------------------------------------------------------------------------
   -- Timer
   -----------------------------------------------------------------------------
@@ -553,7 +1195,12 @@ begin  -- architecture rtl
   
   -----------------------------------------------------------------------------
   -- CRC
+  -- CRC16_MODEL "modbus" : CRC-16/MODBUS (init 0xFFFF by the software)
+  -- CRC16_MODEL "xmodem" : CRC-16/XMODEM (init 0x0000 by the software)
   -----------------------------------------------------------------------------
+  gen_crc_modbus:
+  if CRC16_MODEL /= "xmodem"
+  generate
   ins_sbi_crc : sbi_crc
     generic map
     (NAME             => "CRC16"
@@ -573,49 +1220,258 @@ begin  -- architecture rtl
     ,sbi_ini_i            => icn2_sbi_inis(ICN2_TARGET_CRC)
     ,sbi_tgt_o            => icn2_sbi_tgts(ICN2_TARGET_CRC)
     );
+  end generate gen_crc_modbus;
+
+  gen_crc_xmodem:
+  if CRC16_MODEL = "xmodem"
+  generate
+  ins_sbi_crc : sbi_crc
+    generic map
+    (NAME             => "CRC16"
+    ,WIDTH_CRC        => 16     
+    ,WIDTH_DATA       => 8      
+    ,POLYNOM          => X"1021"
+    ,SHIFT_LEFT       => true   
+    ,LSB_FIRST        => false  
+    ,POLYNOM_REVERSE  => false  
+    ,REFLECT_IN       => false  
+    ,REFLECT_OUT      => false  
+    ,XOR_OUT          => (others => '0')
+      )
+    port map
+    (clk_i                => clk         
+    ,arst_b_i             => arst_b      
+    ,sbi_ini_i            => icn2_sbi_inis(ICN2_TARGET_CRC)
+    ,sbi_tgt_o            => icn2_sbi_tgts(ICN2_TARGET_CRC)
+    );
+  end generate gen_crc_xmodem;
 
   -----------------------------------------------------------------------------
   -- spinlock
+  -- One port per CPU (ICN1) : a CPU spinning on a lock don't use the ICN2
+  -- Reset with the CPUs : no lock is kept after a boot
   -----------------------------------------------------------------------------
-  ins_sbi_spinlock : sbi_spinlock
+  ins_sbi_spinlock : sbi_spinlock_mp
+    generic map
+    (NB_PORT              => NB_CPU
+    ,MODE                 => SPINLOCK_MODE
+    )
     port map
     (clk_i                => clk         
-    ,arst_b_i             => arst_b      
-    ,sbi_ini_i            => icn2_sbi_inis(ICN2_TARGET_SPINLOCK)
-    ,sbi_tgt_o            => icn2_sbi_tgts(ICN2_TARGET_SPINLOCK)
+    ,arst_b_i             => cpu_arst_b
+    ,sbi_inis_i           => spinlock_sbi_inis
+    ,sbi_tgts_o           => spinlock_sbi_tgts
+    ,it_o                 => spinlock_it
+    );
+
+  -----------------------------------------------------------------------------
+  -- Atomic operations
+  -- One port per CPU (ICN1), in the unused addresses of the TIMER
+  -----------------------------------------------------------------------------
+  ins_sbi_atomic : sbi_atomic_mp
+    generic map
+    (NB_PORT              => NB_CPU
+    ,NB_CELL              => ATOMIC_NB_CELL
+    )
+    port map
+    (clk_i                => clk         
+    ,arst_b_i             => cpu_arst_b
+    ,sbi_inis_i           => atomic_sbi_inis
+    ,sbi_tgts_o           => atomic_sbi_tgts
+    );
+
+  -----------------------------------------------------------------------------
+  -- Barrier
+  -- One port per CPU (ICN1), in the unused address of the TIMER
+  -----------------------------------------------------------------------------
+  ins_sbi_barrier : sbi_barrier_mp
+    generic map
+    (NB_PORT              => NB_CPU
+    ,HOLD                 => BARRIER_HOLD
+    )
+    port map
+    (clk_i                => clk         
+    ,arst_b_i             => cpu_arst_b
+    ,sbi_inis_i           => barrier_sbi_inis
+    ,sbi_tgts_o           => barrier_sbi_tgts
+    ,cpu_run_o            => barrier_cpu_run
     );
 
   -----------------------------------------------------------------------------
   -- mailbox
   -----------------------------------------------------------------------------
-  ins_sbi_mailbox : sbi_mailbox
+  -- One FIFO per direction : the depth of a FIFO is DEPTH_TX + DEPTH_RX
+  ins_sbi_mailbox : sbi_mailbox_it
     generic map
-     (FIFO0_DEPTH_TX       => MAILBOX_FIFO0_DEPTH_TX
-     ,FIFO0_DEPTH_RX       => MAILBOX_FIFO0_DEPTH_RX
-     ,FIFO1_DEPTH_TX       => MAILBOX_FIFO1_DEPTH_TX
-     ,FIFO1_DEPTH_RX       => MAILBOX_FIFO1_DEPTH_RX
+     (FIFO0_DEPTH          => MAILBOX_FIFO0_DEPTH_TX + MAILBOX_FIFO0_DEPTH_RX
+     ,FIFO1_DEPTH          => MAILBOX_FIFO1_DEPTH_TX + MAILBOX_FIFO1_DEPTH_RX
       )
     port map
      (clk_i                => clk         
      ,arst_b_i             => arst_b      
      ,sbi_ini_i            => icn2_sbi_inis(ICN2_TARGET_MAILBOX)
      ,sbi_tgt_o            => icn2_sbi_tgts(ICN2_TARGET_MAILBOX)
+     ,it_o                 => mailbox_it
       );
 
   -----------------------------------------------------------------------------
   -- RAM2
   -----------------------------------------------------------------------------
-  ins_sbi_ram2 : sbi_ram
-    generic map
-    (DEPTH                => RAM2_DEPTH
-    ,SYNC_READ            => true   
-   )
+  -- Above 64 bytes, the second half of RAM2 is in the upper half of the
+  -- RAM1 window : RAM1 must be 64 bytes or less
+  assert RAM2_DEPTH <= 64 or RAM1_DEPTH <= 64 report "RAM2_DEPTH above 64 needs RAM1_DEPTH up to 64" severity failure;
+  assert RAM2_DEPTH <= 128                    report "RAM2_DEPTH must be less or equal to 128"        severity failure;
+
+  gen_ram2:
+  if not RAM2_BANKED
+  generate
+    ins_sbi_ram2 : sbi_ram
+      generic map
+      (DEPTH                => RAM2_LO_DEPTH
+      ,SYNC_READ            => true
+     )
+      port map
+      (clk_i                => clk         
+      ,arst_b_i             => arst_b      
+      ,sbi_ini_i            => icn2_sbi_inis(ICN2_TARGET_RAM2)
+      ,sbi_tgt_o            => icn2_sbi_tgts(ICN2_TARGET_RAM2)
+      );
+  end generate gen_ram2;
+
+  -- One port per ICN2 master (CPUs and DMA), the masters accessing distinct
+  -- banks are not waiting each other. The RAM2 target of ICN2 is unused.
+  gen_ram2_b:
+  if RAM2_BANKED
+  generate
+    ins_sbi_ram2 : sbi_ram_mp
+      generic map
+      (NB_PORT              => ICN2_NB_MASTER
+      ,NB_BANK              => RAM2_NB_BANK
+      ,DEPTH                => RAM2_LO_DEPTH
+      ,ALGO                 => "rr"
+      ,SYNC_READ            => true
+      )
+      port map
+      (clk_i                => clk         
+      ,arst_b_i             => arst_b      
+      ,sbi_inis_i           => ram2_sbi_inis
+      ,sbi_tgts_o           => ram2_sbi_tgts
+      );
+
+    icn2_sbi_tgts(ICN2_TARGET_RAM2).ready <= '1';
+    icn2_sbi_tgts(ICN2_TARGET_RAM2).rdata <= (others => '0');
+  end generate gen_ram2_b;
+
+  gen_ram2_hi:
+  if RAM2_HI_DEPTH > 0
+  generate
+    ins_sbi_ram2_hi : sbi_ram
+      generic map
+      (DEPTH                => RAM2_HI_DEPTH
+      ,SYNC_READ            => true
+     )
+      port map
+      (clk_i                => clk         
+      ,arst_b_i             => arst_b      
+      ,sbi_ini_i            => icn2_sbi_inis(ICN2_TARGET_RAM2_HI)
+      ,sbi_tgt_o            => icn2_sbi_tgts(ICN2_TARGET_RAM2_HI)
+      );
+  end generate gen_ram2_hi;
+
+  gen_ram2_hi_b:
+  if RAM2_HI_DEPTH = 0
+  generate
+    icn2_sbi_tgts(ICN2_TARGET_RAM2_HI).ready <= '1';
+    icn2_sbi_tgts(ICN2_TARGET_RAM2_HI).rdata <= (others => '0');
+  end generate gen_ram2_hi_b;
+    
+  -----------------------------------------------------------------------------
+  -- Modbus RTU accelerator
+  -- Snoop the UART RX line
+  -----------------------------------------------------------------------------
+  gen_modbus_rtu:
+  if MODBUS_RTU
+  generate
+    ins_sbi_modbus_rtu : sbi_modbus_rtu
+      generic map
+      (CLOCK_FREQ           => CLOCK_FREQ
+      ,BAUD_RATE            => BAUD_RATE
+      ,DEPTH                => MODBUS_RTU_DEPTH
+       )
+      port map
+      (clk_i                => clk         
+      ,arst_b_i             => arst_b      
+      ,sbi_ini_i            => icn2_sbi_inis(ICN2_TARGET_MODBUS_RTU)
+      ,sbi_tgt_o            => icn2_sbi_tgts(ICN2_TARGET_MODBUS_RTU)
+      ,uart_rx_i            => uart_rx_i
+      ,it_o                 => modbus_rtu_it
+      );
+  end generate gen_modbus_rtu;
+
+  gen_modbus_rtu_b:
+  if not MODBUS_RTU
+  generate
+    icn2_sbi_tgts(ICN2_TARGET_MODBUS_RTU).ready <= '1';
+    icn2_sbi_tgts(ICN2_TARGET_MODBUS_RTU).rdata <= (others => '0');
+    modbus_rtu_it                               <= '0';
+  end generate gen_modbus_rtu_b;
+
+  -----------------------------------------------------------------------------
+  -- DMA
+  -- Target to be configured, Initiator to copy
+  -----------------------------------------------------------------------------
+  ins_sbi_dma : sbi_dma
     port map
     (clk_i                => clk         
     ,arst_b_i             => arst_b      
-    ,sbi_ini_i            => icn2_sbi_inis(ICN2_TARGET_RAM2)
-    ,sbi_tgt_o            => icn2_sbi_tgts(ICN2_TARGET_RAM2)
+    ,sbi_ini_i            => icn2_sbi_inis(ICN2_TARGET_DMA)
+    ,sbi_tgt_o            => icn2_sbi_tgts(ICN2_TARGET_DMA)
+    ,sbi_ini_o            => icn2_sbi_inim(ICN2_MASTER_DMA)
+    ,sbi_tgt_i            => icn2_sbi_tgtm(ICN2_MASTER_DMA)
+    ,it_o                 => dma_it
     );
+
+  -----------------------------------------------------------------------------
+  -- Boot loader
+  -- Write the instruction RAM, then reset the CPUs to fetch in the RAM
+  -----------------------------------------------------------------------------
+  gen_boot:
+  if IMEM_RAM
+  generate
+  signal   boot_arst_b                : std_logic;
+  begin
+    ins_sbi_boot : sbi_boot
+      generic map
+      (IMEM_ADDR_WIDTH      => CPU_IMEM_ADDR_WIDTH
+      ,IMEM_DATA_WIDTH      => CPU_IMEM_DATA_WIDTH
+      )
+      port map
+      (clk_i                => clk         
+      ,arst_b_i             => arst_b      
+      ,sbi_ini_i            => icn2_sbi_inis(ICN2_TARGET_BOOT)
+      ,sbi_tgt_o            => icn2_sbi_tgts(ICN2_TARGET_BOOT)
+      ,imem_we_o            => imem_we
+      ,imem_addr_o          => imem_addr
+      ,imem_data_o          => imem_data
+      ,boot_o               => boot
+      ,cpu_arst_b_o         => boot_arst_b
+      );
+
+    cpu_arst_b <= arst_b and boot_arst_b;
+  end generate gen_boot;
+
+  gen_boot_b:
+  if not IMEM_RAM
+  generate
+    icn2_sbi_tgts(ICN2_TARGET_BOOT).ready <= '1';
+    icn2_sbi_tgts(ICN2_TARGET_BOOT).rdata <= (others => '0');
+
+    imem_we    <= '0';
+    imem_addr  <= (others => '0');
+    imem_data  <= (others => '0');
+    boot       <= '0';
+    cpu_arst_b <= arst_b;
+  end generate gen_boot_b;
     
   -----------------------------------------------------------------------------
   -- Debug
@@ -631,6 +1487,23 @@ begin  -- architecture rtl
   debug_o.uart_ready  <= icn2_sbi_tgts(ICN2_TARGET_UART  ).ready;
   debug_o.spi_cs      <= icn2_sbi_inis(ICN2_TARGET_SPI   ).cs   ;
   debug_o.spi_ready   <= icn2_sbi_tgts(ICN2_TARGET_SPI   ).ready;
+
+  -- Sum of the counters of the instruction caches (wrap around)
+  p_debug_icache: process (all) is
+    variable hit  : unsigned(16-1 downto 0);
+    variable miss : unsigned(16-1 downto 0);
+  begin
+    hit  := (others => '0');
+    miss := (others => '0');
+    for i in 0 to NB_CPU-1
+    loop
+      hit  := hit  + unsigned(icache_hits  (i));
+      miss := miss + unsigned(icache_misses(i));
+    end loop;
+
+    debug_o.icache_hit  <= std_logic_vector(hit );
+    debug_o.icache_miss <= std_logic_vector(miss);
+  end process p_debug_icache;
     
 end architecture rtl;
     
@@ -0,0 +1,270 @@
+-------------------------------------------------------------------------------
+-- Title      : Instruction cache
+-- Project    :
+-------------------------------------------------------------------------------
+-- File       : icache.vhd
+-- Author     : Mathieu Rosière
+-- Company    :
+-- Created    : 2026-10-17
+-- Standard   : VHDL'93/02
+-------------------------------------------------------------------------------
+-- Description: Direct-mapped instruction cache of NB_LINE lines of LINE_SIZE
+--              instructions, between the CPU and the instruction memory.
+--              * CPU side : same interface and same latency than ROM_user
+--                on a hit (instruction the cycle after cs_i). On a miss,
+--                stall_o is set the cycle after cs_i (CPU clock enable) until
+--                the line is loaded.
+--              * Memory side : a request (mem_cs_o) is accepted when
+--                mem_ready_i = 1, the instruction is read the next cycle
+--                (ROM_user : mem_ready_i = 1). The LINE_SIZE instructions of
+--                the line are requested back to back : the next instructions
+--                are prefetched.
+--              The cache is empty after the reset.
+--              hit_o and miss_o count the accesses of the CPU (wrap around).
+--              NB_LINE and LINE_SIZE must be powers of 2.
+-------------------------------------------------------------------------------
+-- Copyright (c) 2026
+-------------------------------------------------------------------------------
+-- Revisions  :
+-- Date        Version  Author   Description
+-- 2026-10-17  1.0      mrosiere Created
+-------------------------------------------------------------------------------
+library ieee;
+use     ieee.std_logic_1164.all;
+use     ieee.numeric_std.all;
+library asylum;
+use     asylum.math_pkg.all;
+
+entity icache is
+  generic
+    (ADDR_WIDTH            : positive := 10
+    ;DATA_WIDTH            : positive := 32
+    ;NB_LINE               : positive := 8
+    ;LINE_SIZE             : positive := 4      -- Instructions per line
+    ;CNT_WIDTH             : positive := 16
+    );
+  port
+    (clk_i                 : in  std_logic
+    ;arst_b_i              : in  std_logic
+
+     -- CPU
+    ;cs_i                  : in  std_logic
+    ;addr_i                : in  std_logic_vector(ADDR_WIDTH-1 downto 0)
+    ;data_o                : out std_logic_vector(DATA_WIDTH-1 downto 0)
+    ;stall_o               : out std_logic
+
+     -- Instruction memory
+    ;mem_cs_o              : out std_logic
+    ;mem_addr_o            : out std_logic_vector(ADDR_WIDTH-1 downto 0)
+    ;mem_ready_i           : in  std_logic
+    ;mem_data_i            : in  std_logic_vector(DATA_WIDTH-1 downto 0)
+
+     -- Counters
+    ;hit_o                 : out std_logic_vector(CNT_WIDTH-1 downto 0)
+    ;miss_o                : out std_logic_vector(CNT_WIDTH-1 downto 0)
+    );
+end entity icache;
+
+architecture rtl of icache is
+
+  constant OFFSET_WIDTH         : natural  := log2(LINE_SIZE);
+  constant INDEX_WIDTH          : natural  := log2(NB_LINE);
+  constant TAG_WIDTH            : natural  := ADDR_WIDTH-OFFSET_WIDTH-INDEX_WIDTH;
+
+  type     tags_t        is array (0 to NB_LINE-1)           of std_logic_vector(TAG_WIDTH -1 downto 0);
+  type     words_t       is array (0 to NB_LINE*LINE_SIZE-1) of std_logic_vector(DATA_WIDTH-1 downto 0);
+  type     state_t       is (IDLE, FILL);
+
+  -- Cache content
+  signal   tags                 : tags_t;
+  signal   valid                : std_logic_vector(NB_LINE-1 downto 0);
+  signal   words                : words_t;
+
+  -- Access of the CPU
+  signal   lookup_r             : std_logic;                                 -- Access the previous cycle
+  signal   hit_r                : std_logic;
+  signal   addr_r               : std_logic_vector(ADDR_WIDTH-1 downto 0);
+  signal   data_r               : std_logic_vector(DATA_WIDTH-1 downto 0);
+  signal   miss                 : std_logic;
+  signal   stall                : std_logic;
+
+  -- Line fill
+  signal   state_r              : state_t;
+  signal   req_cnt_r            : natural range 0 to LINE_SIZE;              -- Next word requested
+  signal   rsp_cnt_r            : natural range 0 to LINE_SIZE-1;            -- Next word received
+  signal   rsp_r                : std_logic;                                 -- Word read this cycle
+  signal   mem_cs               : std_logic;
+  signal   words_we             : std_logic;
+  signal   words_waddr          : natural range 0 to NB_LINE*LINE_SIZE-1;
+
+  signal   hit_cnt_r            : unsigned(CNT_WIDTH-1 downto 0);
+  signal   miss_cnt_r           : unsigned(CNT_WIDTH-1 downto 0);
+
+  function tag   (addr : std_logic_vector) return std_logic_vector is
+  begin
+    return addr(ADDR_WIDTH-1 downto OFFSET_WIDTH+INDEX_WIDTH);
+  end function tag;
+
+  function index (addr : std_logic_vector) return natural is
+  begin
+    if INDEX_WIDTH = 0
+    then
+      return 0;
+    end if;
+    return to_integer(unsigned(addr(OFFSET_WIDTH+INDEX_WIDTH-1 downto OFFSET_WIDTH)));
+  end function index;
+
+  function offset(addr : std_logic_vector) return natural is
+  begin
+    if OFFSET_WIDTH = 0
+    then
+      return 0;
+    end if;
+    return to_integer(unsigned(addr(OFFSET_WIDTH-1 downto 0)));
+  end function offset;
+
+begin  -- architecture rtl
+
+  assert 2**INDEX_WIDTH  = NB_LINE   report "NB_LINE must be a power of 2"              severity failure;
+  assert 2**OFFSET_WIDTH = LINE_SIZE report "LINE_SIZE must be a power of 2"            severity failure;
+  assert TAG_WIDTH > 0               report "NB_LINE*LINE_SIZE must be less than the memory" severity failure;
+
+  -----------------------------------------------------------------------------
+  -- Lookup
+  -----------------------------------------------------------------------------
+  miss            <= lookup_r and not hit_r;
+  stall           <= miss when state_r = IDLE else
+                     '1';
+
+  p_lookup: process (clk_i, arst_b_i) is
+  begin
+    if arst_b_i = '0'
+    then
+      lookup_r    <= '0';
+      hit_r       <= '0';
+      addr_r      <= (others => '0');
+      hit_cnt_r   <= (others => '0');
+      miss_cnt_r  <= (others => '0');
+    elsif rising_edge(clk_i)
+    then
+      -- The CPU is frozen during the stall
+      lookup_r    <= cs_i and not stall;
+
+      if cs_i = '1' and stall = '0'
+      then
+        addr_r    <= addr_i;
+
+        if valid(index(addr_i)) = '1' and tags(index(addr_i)) = tag(addr_i)
+        then
+          hit_r   <= '1';
+        else
+          hit_r   <= '0';
+        end if;
+      end if;
+
+      if lookup_r = '1'
+      then
+        if hit_r = '1'
+        then
+          hit_cnt_r  <= hit_cnt_r  + 1;
+        else
+          miss_cnt_r <= miss_cnt_r + 1;
+        end if;
+      end if;
+    end if;
+  end process p_lookup;
+
+  -----------------------------------------------------------------------------
+  -- Line fill
+  -----------------------------------------------------------------------------
+  mem_cs          <= '1' when state_r = FILL and req_cnt_r < LINE_SIZE else
+                     '0';
+
+  p_fill: process (clk_i, arst_b_i) is
+  begin
+    if arst_b_i = '0'
+    then
+      state_r     <= IDLE;
+      req_cnt_r   <= 0;
+      rsp_cnt_r   <= 0;
+      rsp_r       <= '0';
+      valid       <= (others => '0');
+      tags        <= (others => (others => '0'));
+    elsif rising_edge(clk_i)
+    then
+      rsp_r       <= mem_cs and mem_ready_i;
+
+      case state_r is
+        when IDLE =>
+          if miss = '1'
+          then
+            state_r   <= FILL;
+            req_cnt_r <= 0;
+            rsp_cnt_r <= 0;
+          end if;
+
+        when FILL =>
+          if mem_cs = '1' and mem_ready_i = '1'
+          then
+            req_cnt_r <= req_cnt_r + 1;
+          end if;
+
+          if rsp_r = '1'
+          then
+            if rsp_cnt_r = LINE_SIZE-1
+            then
+              -- Line loaded, the CPU restarts the next cycle
+              state_r                 <= IDLE;
+              valid(index(addr_r))    <= '1';
+              tags (index(addr_r))    <= tag(addr_r);
+            else
+              rsp_cnt_r               <= rsp_cnt_r + 1;
+            end if;
+          end if;
+      end case;
+    end if;
+  end process p_fill;
+
+  -----------------------------------------------------------------------------
+  -- Instructions
+  -----------------------------------------------------------------------------
+  words_we        <= '1' when state_r = FILL and rsp_r = '1' else
+                     '0';
+  words_waddr     <= index(addr_r)*LINE_SIZE + rsp_cnt_r;
+
+  p_words: process (clk_i) is
+  begin
+    if rising_edge(clk_i)
+    then
+      if words_we = '1'
+      then
+        words(words_waddr) <= mem_data_i;
+
+        -- Instruction of the miss
+        if rsp_cnt_r = offset(addr_r)
+        then
+          data_r  <= mem_data_i;
+        end if;
+      end if;
+
+      if cs_i = '1' and stall = '0'
+      then
+        data_r    <= words(index(addr_i)*LINE_SIZE + offset(addr_i));
+      end if;
+    end if;
+  end process p_words;
+
+  -----------------------------------------------------------------------------
+  -- Ports
+  -----------------------------------------------------------------------------
+  data_o          <= data_r;
+  stall_o         <= stall;
+
+  mem_cs_o        <= mem_cs;
+  mem_addr_o      <= tag(addr_r) & std_logic_vector(to_unsigned(index(addr_r),INDEX_WIDTH))
+                                 & std_logic_vector(to_unsigned(req_cnt_r mod LINE_SIZE,OFFSET_WIDTH));
+
+  hit_o           <= std_logic_vector(hit_cnt_r);
+  miss_o          <= std_logic_vector(miss_cnt_r);
+
+end architecture rtl;
@@ -0,0 +1,68 @@
+-------------------------------------------------------------------------------
+-- Title      : Instruction RAM
+-- Project    :
+-------------------------------------------------------------------------------
+-- File       : imem_ram.vhd
+-- Author     : Mathieu Rosière
+-- Company    :
+-- Created    : 2026-10-17
+-- Standard   : VHDL'93/02
+-------------------------------------------------------------------------------
+-- Description: Writable instruction memory.
+--              The read port has the same interface and the same latency
+--              than ROM_user (synchronous read enabled by cke_i).
+--              The write port is driven by the boot loader (sbi_boot).
+-------------------------------------------------------------------------------
+-- Copyright (c) 2026
+-------------------------------------------------------------------------------
+-- Revisions  :
+-- Date        Version  Author   Description
+-- 2026-10-17  1.0      mrosiere Created
+-------------------------------------------------------------------------------
+library ieee;
+use     ieee.std_logic_1164.all;
+use     ieee.numeric_std.all;
+
+entity imem_ram is
+  generic
+    (ADDR_WIDTH            : positive := 10
+    ;DATA_WIDTH            : positive := 18
+    );
+  port
+    (clk_i                 : in  std_logic
+     -- Read port (CPU)
+    ;cke_i                 : in  std_logic
+    ;address_i             : in  std_logic_vector(ADDR_WIDTH-1 downto 0)
+    ;instruction_o         : out std_logic_vector(DATA_WIDTH-1 downto 0)
+     -- Write port (Boot loader)
+    ;we_i                  : in  std_logic
+    ;waddr_i               : in  std_logic_vector(ADDR_WIDTH-1 downto 0)
+    ;wdata_i               : in  std_logic_vector(DATA_WIDTH-1 downto 0)
+    );
+end entity imem_ram;
+
+architecture rtl of imem_ram is
+
+  type     ram_t is array (0 to 2**ADDR_WIDTH-1) of std_logic_vector(DATA_WIDTH-1 downto 0);
+
+  signal   ram                  : ram_t := (others => (others => '0'));
+
+begin  -- architecture rtl
+
+  p_ram: process (clk_i) is
+  begin
+    if rising_edge(clk_i)
+    then
+      if we_i = '1'
+      then
+        ram(to_integer(unsigned(waddr_i))) <= wdata_i;
+      end if;
+
+      if cke_i = '1'
+      then
+        instruction_o <= ram(to_integer(unsigned(address_i)));
+      end if;
+    end if;
+  end process p_ram;
+
+end architecture rtl;
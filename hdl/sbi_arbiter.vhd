@@ -0,0 +1,173 @@
+-------------------------------------------------------------------------------
+-- Title      : Arbiter of N masters to 1 target
+-- Project    :
+-------------------------------------------------------------------------------
+-- File       : sbi_arbiter.vhd
+-- Author     : Mathieu Rosière
+-- Company    :
+-- Created    : 2026-10-17
+-- Standard   : VHDL'93/02
+-------------------------------------------------------------------------------
+-- Description: Select one of the NB_MASTER masters for the target. The
+--              other masters wait (ready = 0). An access waited by the
+--              target (ready = 0) keeps the grant until its end.
+--              Algorithms (ALGO) :
+--              * "fix" : the lowest master has the priority
+--              * "rr"  : round-robin, after an access the master has the
+--                lowest priority
+--              * "wrr" : weighted round-robin, a master keeps the grant
+--                for up to WEIGHT(i) consecutive accesses while it requests
+--              The grant is combinatorial : no latency added on the access.
+-------------------------------------------------------------------------------
+-- Copyright (c) 2026
+-------------------------------------------------------------------------------
+-- Revisions  :
+-- Date        Version  Author   Description
+-- 2026-10-17  1.0      mrosiere Created
+-- 2026-10-17  1.1      mrosiere Check the length of WEIGHT
+-------------------------------------------------------------------------------
+library ieee;
+use     ieee.std_logic_1164.all;
+use     ieee.numeric_std.all;
+library asylum;
+use     asylum.sbi_pkg.all;
+
+entity sbi_arbiter is
+  generic
+    (NB_MASTER             : positive := 2
+    ;ALGO                  : string   := "rr"          -- "fix" / "rr" / "wrr"
+    ;WEIGHT                : integer_vector := (0 => 1) -- "wrr" : accesses per turn of each master (> 0)
+    );
+  port
+    (clk_i                 : in  std_logic
+    ;arst_b_i              : in  std_logic
+
+    -- From the masters
+    ;sbi_inis_i            : in  sbi_inis_t
+    ;sbi_tgts_o            : out sbi_tgts_t
+
+    -- To the target
+    ;sbi_ini_o             : out sbi_ini_t
+    ;sbi_tgt_i             : in  sbi_tgt_t
+    );
+end entity sbi_arbiter;
+
+architecture rtl of sbi_arbiter is
+
+  -- Number of consecutive accesses of a master, "rr" is "wrr" with weights 1
+  function weight_of (i : natural) return positive is
+  begin
+    if ALGO = "wrr"
+    then
+      return WEIGHT(i);
+    end if;
+
+    return 1;
+  end function weight_of;
+
+  signal   req                  : std_logic_vector(NB_MASTER-1 downto 0);
+  signal   grant                : natural range 0 to NB_MASTER-1;
+
+  signal   grant_r              : natural range 0 to NB_MASTER-1; -- Last granted master
+  signal   lock_r               : std_logic;                      -- Access of grant_r waited by the target
+  signal   count_r              : natural range 0 to 255;         -- Accesses of grant_r in its turn
+
+begin  -- architecture rtl
+
+  assert ALGO = "fix" or ALGO = "rr" or ALGO = "wrr" report "ALGO must be fix, rr or wrr" severity failure;
+  assert ALGO /= "wrr" or WEIGHT'length = NB_MASTER report "WEIGHT must have NB_MASTER weights with ALGO wrr" severity failure;
+
+  gen_req: for i in 0 to NB_MASTER-1
+  generate
+    req(i) <= sbi_inis_i(i).cs;
+  end generate gen_req;
+
+  -----------------------------------------------------------------------------
+  -- Grant
+  -----------------------------------------------------------------------------
+  p_grant: process (all) is
+    variable sel : natural range 0 to NB_MASTER-1;
+    variable idx : natural range 0 to NB_MASTER-1;
+  begin
+    sel := grant_r;
+
+    if lock_r = '1'
+    then
+      -- Access in progress
+      sel := grant_r;
+
+    elsif ALGO = "fix"
+    then
+      for i in NB_MASTER-1 downto 0
+      loop
+        if req(i) = '1'
+        then
+          sel := i;
+        end if;
+      end loop;
+
+    elsif req(grant_r) = '1' and count_r < weight_of(grant_r)
+    then
+      -- Turn of grant_r not finished
+      sel := grant_r;
+
+    else
+      -- First requesting master after grant_r, grant_r in last
+      for i in NB_MASTER downto 1
+      loop
+        idx := (grant_r+i) mod NB_MASTER;
+
+        if req(idx) = '1'
+        then
+          sel := idx;
+        end if;
+      end loop;
+    end if;
+
+    grant <= sel;
+  end process p_grant;
+
+  p_reg: process (clk_i, arst_b_i) is
+  begin
+    if arst_b_i = '0'
+    then
+      grant_r <= 0;
+      lock_r  <= '0';
+      count_r <= 0;
+    elsif rising_edge(clk_i)
+    then
+      if req(grant) = '1'
+      then
+        grant_r <= grant;
+        lock_r  <= not sbi_tgt_i.ready;
+
+        -- End of an access
+        if sbi_tgt_i.ready = '1'
+        then
+          if grant = grant_r and count_r < 255
+          then
+            count_r <= count_r+1;
+          elsif grant /= grant_r
+          then
+            count_r <= 1;
+          end if;
+        elsif grant /= grant_r
+        then
+          count_r <= 0;
+        end if;
+      end if;
+    end if;
+  end process p_reg;
+
+  -----------------------------------------------------------------------------
+  -- Ports
+  -----------------------------------------------------------------------------
+  sbi_ini_o <= sbi_inis_i(grant);
+
+  gen_master: for i in 0 to NB_MASTER-1
+  generate
+    sbi_tgts_o(i).ready <= sbi_tgt_i.ready when grant = i else '0';
+    sbi_tgts_o(i).rdata <= sbi_tgt_i.rdata;
+  end generate gen_master;
+
+end architecture rtl;
@@ -0,0 +1,181 @@
+-------------------------------------------------------------------------------
+-- Title      : Atomic operations on 32 bits cells, one port per CPU
+-- Project    :
+-------------------------------------------------------------------------------
+-- File       : sbi_atomic_mp.vhd
+-- Author     : Mathieu Rosière
+-- Company    :
+-- Created    : 2026-10-17
+-- Standard   : VHDL'93/02
+-------------------------------------------------------------------------------
+-- Description: NB_CELL cells of 32 bits shared by all the CPUs.
+--              Each port (one per CPU, on ICN1) has its own operands and
+--              result : a CPU writes its operands, then one write of CMD
+--              does the operation on the cell. The operands are kept, so an
+--              increment of a counter is one access.
+--              The operations of all ports in the same cycle are done in
+--              the order of the ports.
+--
+-- Operations (CMD[7:6]) :
+--   0 LOAD : RESULT = CELL
+--   1 ADD  : RESULT = CELL, CELL = CELL + OPERAND
+--   2 SWAP : RESULT = CELL, CELL = OPERAND
+--   3 CAS  : RESULT = CELL, if CELL = COMPARE then CELL = OPERAND
+--
+-- Register Map (ADDR_WIDTH = 1)
+--   0 DATA     : Write : shift a byte in {COMPARE,OPERAND}, LSB first
+--                        (4 writes : OPERAND, 8 writes : COMPARE then
+--                        OPERAND)
+--                Read  : shift a byte out of RESULT, LSB first
+--   1 CMD      : Write : bits 7-6 operation, bits 5-0 cell
+--                Read  : bit 0 the last CAS has written the cell
+-------------------------------------------------------------------------------
+-- Copyright (c) 2026
+-------------------------------------------------------------------------------
+-- Revisions  :
+-- Date        Version  Author   Description
+-- 2026-10-17  1.0      mrosiere Created
+-------------------------------------------------------------------------------
+library ieee;
+use     ieee.std_logic_1164.all;
+use     ieee.numeric_std.all;
+library asylum;
+use     asylum.sbi_pkg.all;
+
+entity sbi_atomic_mp is
+  generic
+    (NB_PORT               : positive := 1
+    ;NB_CELL               : positive := 4
+    );
+  port
+    (clk_i                 : in  std_logic
+    ;arst_b_i              : in  std_logic
+
+    ;sbi_inis_i            : in  sbi_inis_t
+    ;sbi_tgts_o            : out sbi_tgts_t
+    );
+end entity sbi_atomic_mp;
+
+architecture rtl of sbi_atomic_mp is
+
+  constant REG_DATA             : natural := 0;
+  constant REG_CMD              : natural := 1;
+
+  constant OP_LOAD              : std_logic_vector(2-1 downto 0) := "00";
+  constant OP_ADD               : std_logic_vector(2-1 downto 0) := "01";
+  constant OP_SWAP              : std_logic_vector(2-1 downto 0) := "10";
+  constant OP_CAS               : std_logic_vector(2-1 downto 0) := "11";
+
+  subtype  word_t        is unsigned(32-1 downto 0);
+  type     cells_t       is array (0 to NB_CELL-1) of word_t;
+  type     words_t       is array (0 to NB_PORT-1) of word_t;
+
+  signal   cell_r               : cells_t;
+  signal   cell_n               : cells_t;
+  signal   result_r             : words_t;
+  signal   result_n             : words_t;
+  signal   operand_r            : words_t;
+  signal   operand_n            : words_t;
+  signal   compare_r            : words_t;
+  signal   compare_n            : words_t;
+  signal   done_r               : std_logic_vector(NB_PORT-1 downto 0);
+  signal   done_n               : std_logic_vector(NB_PORT-1 downto 0);
+
+begin  -- architecture rtl
+
+  assert NB_CELL <= 64 report "NB_CELL must be less or equal to 64" severity failure;
+
+  -----------------------------------------------------------------------------
+  -- Accesses of all ports in the same cycle : in the order of the ports
+  -----------------------------------------------------------------------------
+  p_next: process (all) is
+    variable cell_v    : cells_t;
+    variable result_v  : words_t;
+    variable operand_v : words_t;
+    variable compare_v : words_t;
+    variable done_v    : std_logic_vector(NB_PORT-1 downto 0);
+    variable reg       : natural range 0 to 1;
+    variable op        : std_logic_vector(2-1 downto 0);
+    variable idx       : natural range 0 to 64-1;
+  begin
+    cell_v    := cell_r;
+    result_v  := result_r;
+    operand_v := operand_r;
+    compare_v := compare_r;
+    done_v    := done_r;
+
+    for p in 0 to NB_PORT-1
+    loop
+      reg := to_integer(unsigned(sbi_inis_i(p).addr(1-1 downto 0)));
+      op  := sbi_inis_i(p).wdata(8-1 downto 6);
+      idx := to_integer(unsigned(sbi_inis_i(p).wdata(6-1 downto 0)));
+
+      if sbi_inis_i(p).cs = '1' and sbi_inis_i(p).re = '1' and reg = REG_DATA
+      then
+        result_v(p)  := X"00" & result_v(p)(32-1 downto 8);
+      end if;
+
+      if sbi_inis_i(p).cs = '1' and sbi_inis_i(p).we = '1'
+      then
+        if reg = REG_DATA
+        then
+          compare_v(p) := operand_v(p)(8-1 downto 0) & compare_v(p)(32-1 downto 8);
+          operand_v(p) := unsigned(sbi_inis_i(p).wdata(8-1 downto 0)) & operand_v(p)(32-1 downto 8);
+        elsif idx < NB_CELL
+        then
+          result_v(p) := cell_v(idx);
+
+          case op is
+            when OP_ADD  => cell_v(idx) := cell_v(idx) + operand_v(p);
+            when OP_SWAP => cell_v(idx) := operand_v(p);
+            when OP_CAS  =>
+              if cell_v(idx) = compare_v(p)
+              then
+                cell_v(idx) := operand_v(p);
+                done_v(p)   := '1';
+              else
+                done_v(p)   := '0';
+              end if;
+            when others  => null;
+          end case;
+        end if;
+      end if;
+    end loop;
+
+    cell_n    <= cell_v;
+    result_n  <= result_v;
+    operand_n <= operand_v;
+    compare_n <= compare_v;
+    done_n    <= done_v;
+  end process p_next;
+
+  p_reg: process (clk_i, arst_b_i) is
+  begin
+    if arst_b_i = '0'
+    then
+      cell_r    <= (others => (others => '0'));
+      result_r  <= (others => (others => '0'));
+      operand_r <= (others => (others => '0'));
+      compare_r <= (others => (others => '0'));
+      done_r    <= (others => '0');
+    elsif rising_edge(clk_i)
+    then
+      cell_r    <= cell_n   ;
+      result_r  <= result_n ;
+      operand_r <= operand_n;
+      compare_r <= compare_n;
+      done_r    <= done_n   ;
+    end if;
+  end process p_reg;
+
+  -----------------------------------------------------------------------------
+  -- Ports
+  -----------------------------------------------------------------------------
+  gen_port: for p in 0 to NB_PORT-1
+  generate
+    sbi_tgts_o(p).ready <= '1';
+    sbi_tgts_o(p).rdata <= std_logic_vector(result_r(p)(8-1 downto 0)) when sbi_inis_i(p).addr(0) = '0' else
+                           "0000000" & done_r(p);
+  end generate gen_port;
+
+end architecture rtl;
@@ -0,0 +1,130 @@
+-------------------------------------------------------------------------------
+-- Title      : Barrier with one port per CPU
+-- Project    :
+-------------------------------------------------------------------------------
+-- File       : sbi_barrier_mp.vhd
+-- Author     : Mathieu Rosière
+-- Company    :
+-- Created    : 2026-10-17
+-- Standard   : VHDL'93/02
+-------------------------------------------------------------------------------
+-- Description: Barrier of the NB_PORT CPUs (one port per CPU, on ICN1) : a
+--              CPU waiting the other ones don't use the ICN2.
+--              A CPU writes BARRIER when it arrives, then reads BARRIER
+--              until it is 0. When the last CPU arrives, all the CPUs are
+--              released in the same cycle and the barrier can be used again.
+--              With HOLD, the CPUs 1 to NB_PORT-1 are held in reset
+--              (cpu_run_o = 0) until the CPU 0 arrives at the barrier : the
+--              CPU 0 does the setup alone then all the CPUs start together.
+--
+-- Register Map (ADDR_WIDTH = 0)
+--   0 BARRIER  : Write : the CPU arrives at the barrier
+--                Read  : 1 the CPU waits the other CPUs, 0 released
+-------------------------------------------------------------------------------
+-- Copyright (c) 2026
+-------------------------------------------------------------------------------
+-- Revisions  :
+-- Date        Version  Author   Description
+-- 2026-10-17  1.0      mrosiere Created
+-------------------------------------------------------------------------------
+library ieee;
+use     ieee.std_logic_1164.all;
+use     ieee.numeric_std.all;
+library asylum;
+use     asylum.sbi_pkg.all;
+
+entity sbi_barrier_mp is
+  generic
+    (NB_PORT               : positive := 1
+    ;HOLD                  : boolean  := False
+    );
+  port
+    (clk_i                 : in  std_logic
+    ;arst_b_i              : in  std_logic
+
+    ;sbi_inis_i            : in  sbi_inis_t
+    ;sbi_tgts_o            : out sbi_tgts_t
+
+    ;cpu_run_o             : out std_logic_vector(NB_PORT-1 downto 0) -- bit i : 0 hold the CPU i in reset
+    );
+end entity sbi_barrier_mp;
+
+architecture rtl of sbi_barrier_mp is
+
+  constant ALL_ARRIVED          : std_logic_vector(NB_PORT-1 downto 0) := (others => '1');
+
+  -- After reset : only the CPU 0 runs with HOLD
+  function run_init return std_logic_vector is
+    variable run : std_logic_vector(NB_PORT-1 downto 0);
+  begin
+    run := (others => '1');
+
+    if HOLD
+    then
+      run := (0 => '1', others => '0');
+    end if;
+
+    return run;
+  end function run_init;
+
+  signal   arrived_r            : std_logic_vector(NB_PORT-1 downto 0);
+  signal   arrived_n            : std_logic_vector(NB_PORT-1 downto 0);
+  signal   run_r                : std_logic_vector(NB_PORT-1 downto 0);
+  signal   run_n                : std_logic_vector(NB_PORT-1 downto 0);
+
+begin  -- architecture rtl
+
+  p_next: process (all) is
+    variable arrived_v : std_logic_vector(NB_PORT-1 downto 0);
+  begin
+    arrived_v := arrived_r;
+    run_n     <= run_r;
+
+    for p in 0 to NB_PORT-1
+    loop
+      if sbi_inis_i(p).cs = '1' and sbi_inis_i(p).we = '1'
+      then
+        arrived_v(p) := '1';
+      end if;
+    end loop;
+
+    -- The CPU 0 releases the CPUs held in reset
+    if arrived_v(0) = '1'
+    then
+      run_n     <= (others => '1');
+    end if;
+
+    -- The last CPU releases all the CPUs
+    if arrived_v = ALL_ARRIVED
+    then
+      arrived_v := (others => '0');
+    end if;
+
+    arrived_n <= arrived_v;
+  end process p_next;
+
+  p_reg: process (clk_i, arst_b_i) is
+  begin
+    if arst_b_i = '0'
+    then
+      arrived_r <= (others => '0');
+      run_r     <= run_init;
+    elsif rising_edge(clk_i)
+    then
+      arrived_r <= arrived_n;
+      run_r     <= run_n;
+    end if;
+  end process p_reg;
+
+  cpu_run_o <= run_r;
+
+  -----------------------------------------------------------------------------
+  -- Ports
+  -----------------------------------------------------------------------------
+  gen_port: for p in 0 to NB_PORT-1
+  generate
+    sbi_tgts_o(p).ready <= '1';
+    sbi_tgts_o(p).rdata <= (0 => arrived_r(p), others => '0');
+  end generate gen_port;
+
+end architecture rtl;
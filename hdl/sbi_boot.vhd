@@ -0,0 +1,185 @@
+-------------------------------------------------------------------------------
+-- Title      : Boot loader of the instruction RAM
+-- Project    :
+-------------------------------------------------------------------------------
+-- File       : sbi_boot.vhd
+-- Author     : Mathieu Rosière
+-- Company    :
+-- Created    : 2026-10-17
+-- Standard   : VHDL'93/02
+-------------------------------------------------------------------------------
+-- Description: Write port of the instruction RAM (imem_ram) for the boot
+--              stub running in ROM_user.
+--              The instruction is written byte per byte (LSB first). When
+--              the last byte of an instruction is written, the instruction
+--              is written in the RAM and the address is incremented.
+--              Writing BOOT in CTRL resets the CPUs and selects the
+--              instruction RAM (or the ROM) for the instruction fetch.
+--
+-- Register Map (ADDR_WIDTH = 2)
+--   0 ADDR_LSB : Instruction address [7:0] (write restarts the instruction)
+--   1 ADDR_MSB : Instruction address [15:8]
+--   2 DATA     : Write the next byte of the instruction
+--   3 CTRL     : [0] BOOT : 1 fetch from RAM, 0 fetch from ROM.
+--                Write resets the CPUs.
+-------------------------------------------------------------------------------
+-- Copyright (c) 2026
+-------------------------------------------------------------------------------
+-- Revisions  :
+-- Date        Version  Author   Description
+-- 2026-10-17  1.0      mrosiere Created
+-------------------------------------------------------------------------------
+library ieee;
+use     ieee.std_logic_1164.all;
+use     ieee.numeric_std.all;
+library asylum;
+use     asylum.sbi_pkg.all;
+
+entity sbi_boot is
+  generic
+    (IMEM_ADDR_WIDTH       : positive := 10
+    ;IMEM_DATA_WIDTH       : positive := 18
+    ;RESET_CYCLES          : positive := 4
+    );
+  port
+    (clk_i                 : in  std_logic
+    ;arst_b_i              : in  std_logic
+
+    ;sbi_ini_i             : in  sbi_ini_t
+    ;sbi_tgt_o             : out sbi_tgt_t
+
+    -- Instruction RAM write port
+    ;imem_we_o             : out std_logic
+    ;imem_addr_o           : out std_logic_vector(IMEM_ADDR_WIDTH-1 downto 0)
+    ;imem_data_o           : out std_logic_vector(IMEM_DATA_WIDTH-1 downto 0)
+
+    ;boot_o                : out std_logic -- 1 : fetch from RAM
+    ;cpu_arst_b_o          : out std_logic
+    );
+end entity sbi_boot;
+
+architecture rtl of sbi_boot is
+
+  constant REG_ADDR_LSB         : natural := 0;
+  constant REG_ADDR_MSB         : natural := 1;
+  constant REG_DATA             : natural := 2;
+  constant REG_CTRL             : natural := 3;
+
+  constant NB_BYTES             : positive := (IMEM_DATA_WIDTH+8-1)/8;
+
+  signal   addr                 : unsigned(16-1 downto 0);
+  signal   data                 : std_logic_vector(NB_BYTES*8-1 downto 0);
+  signal   data_next            : std_logic_vector(NB_BYTES*8-1 downto 0);
+  signal   byte_cnt             : natural range 0 to NB_BYTES-1;
+  signal   we                   : std_logic;
+  signal   boot                 : std_logic;
+  signal   reset_cnt            : natural range 0 to RESET_CYCLES;
+  signal   cpu_arst_b           : std_logic;
+
+  signal   reg_addr             : natural range 0 to 4-1;
+  signal   reg_we               : std_logic;
+  signal   reg_rdata            : std_logic_vector(SBI_DATA_WIDTH-1 downto 0);
+
+begin  -- architecture rtl
+
+  assert IMEM_ADDR_WIDTH <= 16 report "IMEM_ADDR_WIDTH must be less or equal to 16" severity failure;
+
+  reg_addr <= to_integer(unsigned(sbi_ini_i.addr(2-1 downto 0)));
+  reg_we   <= sbi_ini_i.cs and sbi_ini_i.we;
+
+  -- Instruction with the current byte
+  p_data_next: process (all) is
+  begin
+    data_next <= data;
+    data_next(byte_cnt*8+8-1 downto byte_cnt*8) <= sbi_ini_i.wdata(8-1 downto 0);
+  end process p_data_next;
+
+  -----------------------------------------------------------------------------
+  -- Loader
+  -----------------------------------------------------------------------------
+  p_loader: process (clk_i, arst_b_i) is
+  begin
+    if arst_b_i = '0'
+    then
+      addr      <= (others => '0');
+      data      <= (others => '0');
+      byte_cnt  <= 0;
+      we        <= '0';
+      boot      <= '0';
+      reset_cnt <= 0;
+      cpu_arst_b <= '1';
+    elsif rising_edge(clk_i)
+    then
+      we <= '0';
+
+      -- Increment the address after the write of the instruction
+      if we = '1'
+      then
+        addr <= addr+1;
+      end if;
+
+      -- The CPUs are in reset during RESET_CYCLES after the write of CTRL
+      if reset_cnt /= 0
+      then
+        reset_cnt <= reset_cnt-1;
+      end if;
+
+      if reset_cnt <= 1
+      then
+        cpu_arst_b <= '1';
+      end if;
+
+      if reg_we = '1'
+      then
+        case reg_addr is
+          when REG_ADDR_LSB =>
+            addr(8-1  downto 0) <= unsigned(sbi_ini_i.wdata(8-1 downto 0));
+            byte_cnt            <= 0;
+          when REG_ADDR_MSB =>
+            addr(16-1 downto 8) <= unsigned(sbi_ini_i.wdata(8-1 downto 0));
+            byte_cnt            <= 0;
+          when REG_DATA =>
+            data                <= data_next;
+            if byte_cnt = NB_BYTES-1
+            then
+              byte_cnt          <= 0;
+              we                <= '1';
+            else
+              byte_cnt          <= byte_cnt+1;
+            end if;
+          when others =>
+            boot                <= sbi_ini_i.wdata(0);
+            reset_cnt           <= RESET_CYCLES;
+            cpu_arst_b          <= '0';
+        end case;
+      end if;
+    end if;
+  end process p_loader;
+
+  imem_we_o    <= we;
+  imem_addr_o  <= std_logic_vector(addr(IMEM_ADDR_WIDTH-1 downto 0));
+  imem_data_o  <= data(IMEM_DATA_WIDTH-1 downto 0);
+
+  boot_o       <= boot;
+
+  cpu_arst_b_o <= cpu_arst_b;
+
+  -----------------------------------------------------------------------------
+  -- Registers
+  -----------------------------------------------------------------------------
+  p_rdata: process (all) is
+  begin
+    reg_rdata <= (others => '0');
+
+    case reg_addr is
+      when REG_ADDR_LSB => reg_rdata <= std_logic_vector(addr(8-1  downto 0));
+      when REG_ADDR_MSB => reg_rdata <= std_logic_vector(addr(16-1 downto 8));
+      when REG_DATA     => null;
+      when others       => reg_rdata(0) <= boot;
+    end case;
+  end process p_rdata;
+
+  sbi_tgt_o.ready <= '1';
+  sbi_tgt_o.rdata <= reg_rdata;
+
+end architecture rtl;
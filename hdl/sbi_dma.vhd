@@ -0,0 +1,270 @@
+-------------------------------------------------------------------------------
+-- Title      : DMA
+-- Project    :
+-------------------------------------------------------------------------------
+-- File       : sbi_dma.vhd
+-- Author     : Mathieu Rosière
+-- Company    :
+-- Created    : 2026-10-17
+-- Standard   : VHDL'93/02
+-------------------------------------------------------------------------------
+-- Description: Descriptor based DMA, byte per byte copy between two
+--              addresses of the interconnect.
+--              The chain of descriptors is read by the DMA itself.
+--              The flow control is done by the ready of the target
+--              (like a CPU access).
+--
+-- Descriptor (5 bytes)
+--   +0 SRC      : Source      address
+--   +1 DST      : Destination address
+--   +2 LEN      : Number of bytes (0 : nothing to copy)
+--   +3 CTRL     : [0] Increment SRC, [1] Increment DST,
+--                 [2] Set ISR.DESC at the end of this descriptor
+--   +4 NEXT     : Address of the next descriptor (0x00 : end of chain)
+--
+-- Register Map (ADDR_WIDTH = 2)
+--   0 ISR      : [0] DONE : End of chain, [1] DESC. Write 1 to clear
+--   1 IMR      : Interrupt enable of ISR bits
+--   2 DESC     : Write : start the chain (ignored if busy)
+--                Read  : address of the current descriptor
+--   3 STATUS   : [0] BUSY
+-------------------------------------------------------------------------------
+-- Copyright (c) 2026
+-------------------------------------------------------------------------------
+-- Revisions  :
+-- Date        Version  Author   Description
+-- 2026-10-17  1.0      mrosiere Created
+-------------------------------------------------------------------------------
+library ieee;
+use     ieee.std_logic_1164.all;
+use     ieee.numeric_std.all;
+library asylum;
+use     asylum.sbi_pkg.all;
+
+entity sbi_dma is
+  port
+    (clk_i                 : in  std_logic
+    ;arst_b_i              : in  std_logic
+
+    -- Configuration (target)
+    ;sbi_ini_i             : in  sbi_ini_t
+    ;sbi_tgt_o             : out sbi_tgt_t
+
+    -- Copy (initiator)
+    ;sbi_ini_o             : out sbi_ini_t
+    ;sbi_tgt_i             : in  sbi_tgt_t
+
+    ;it_o                  : out std_logic
+    );
+end entity sbi_dma;
+
+architecture rtl of sbi_dma is
+
+  constant REG_ISR              : natural := 0;
+  constant REG_IMR              : natural := 1;
+  constant REG_DESC             : natural := 2;
+  constant REG_STATUS           : natural := 3;
+
+  constant DESC_SRC             : natural := 0;
+  constant DESC_DST             : natural := 1;
+  constant DESC_LEN             : natural := 2;
+  constant DESC_CTRL            : natural := 3;
+  constant DESC_NEXT            : natural := 4;
+
+  constant ISR_DONE             : natural := 0;
+  constant ISR_DESC             : natural := 1;
+
+  constant CTRL_SRC_INC         : natural := 0;
+  constant CTRL_DST_INC         : natural := 1;
+  constant CTRL_IT              : natural := 2;
+
+  type state_t is (IDLE, DESC_RD, COPY_RD, COPY_WR, DESC_END);
+
+  signal   state                : state_t;
+
+  signal   desc_ptr             : unsigned(SBI_ADDR_WIDTH-1 downto 0);
+  signal   desc_idx             : natural range 0 to DESC_NEXT;
+  signal   src                  : unsigned(SBI_ADDR_WIDTH-1 downto 0);
+  signal   dst                  : unsigned(SBI_ADDR_WIDTH-1 downto 0);
+  signal   len                  : unsigned(8-1 downto 0);
+  signal   ctrl                 : std_logic_vector(8-1 downto 0);
+  signal   next_ptr             : unsigned(SBI_ADDR_WIDTH-1 downto 0);
+  signal   data                 : std_logic_vector(SBI_DATA_WIDTH-1 downto 0);
+
+  signal   isr                  : std_logic_vector(2-1 downto 0);
+  signal   imr                  : std_logic_vector(2-1 downto 0);
+  signal   busy                 : std_logic;
+
+  signal   reg_addr             : natural range 0 to 4-1;
+  signal   reg_we               : std_logic;
+  signal   reg_rdata            : std_logic_vector(SBI_DATA_WIDTH-1 downto 0);
+
+begin  -- architecture rtl
+
+  busy     <= '0' when state = IDLE else '1';
+
+  -----------------------------------------------------------------------------
+  -- Engine
+  -----------------------------------------------------------------------------
+  p_engine: process (clk_i, arst_b_i) is
+  begin
+    if arst_b_i = '0'
+    then
+      state    <= IDLE;
+      desc_ptr <= (others => '0');
+      desc_idx <= 0;
+      src      <= (others => '0');
+      dst      <= (others => '0');
+      len      <= (others => '0');
+      ctrl     <= (others => '0');
+      next_ptr <= (others => '0');
+      data     <= (others => '0');
+      isr      <= (others => '0');
+    elsif rising_edge(clk_i)
+    then
+      case state is
+        when IDLE =>
+          if reg_we = '1' and reg_addr = REG_DESC
+          then
+            desc_ptr <= unsigned(sbi_ini_i.wdata);
+            desc_idx <= 0;
+            state    <= DESC_RD;
+          end if;
+
+        when DESC_RD =>
+          if sbi_tgt_i.ready = '1'
+          then
+            case desc_idx is
+              when DESC_SRC  => src      <= unsigned(sbi_tgt_i.rdata);
+              when DESC_DST  => dst      <= unsigned(sbi_tgt_i.rdata);
+              when DESC_LEN  => len      <= unsigned(sbi_tgt_i.rdata);
+              when DESC_CTRL => ctrl     <= sbi_tgt_i.rdata;
+              when others    => next_ptr <= unsigned(sbi_tgt_i.rdata);
+            end case;
+
+            if desc_idx = DESC_NEXT
+            then
+              if len = 0
+              then
+                state <= DESC_END;
+              else
+                state <= COPY_RD;
+              end if;
+            else
+              desc_idx <= desc_idx+1;
+            end if;
+          end if;
+
+        when COPY_RD =>
+          if sbi_tgt_i.ready = '1'
+          then
+            data  <= sbi_tgt_i.rdata;
+            state <= COPY_WR;
+          end if;
+
+        when COPY_WR =>
+          if sbi_tgt_i.ready = '1'
+          then
+            if ctrl(CTRL_SRC_INC) = '1'
+            then
+              src <= src+1;
+            end if;
+
+            if ctrl(CTRL_DST_INC) = '1'
+            then
+              dst <= dst+1;
+            end if;
+
+            len <= len-1;
+
+            if len = 1
+            then
+              state <= DESC_END;
+            else
+              state <= COPY_RD;
+            end if;
+          end if;
+
+        when DESC_END =>
+          if ctrl(CTRL_IT) = '1'
+          then
+            isr(ISR_DESC) <= '1';
+          end if;
+
+          if next_ptr = 0
+          then
+            isr(ISR_DONE) <= '1';
+            state         <= IDLE;
+          else
+            desc_ptr      <= next_ptr;
+            desc_idx      <= 0;
+            state         <= DESC_RD;
+          end if;
+      end case;
+
+      -- Write 1 to clear
+      if reg_we = '1' and reg_addr = REG_ISR
+      then
+        for i in isr'range loop
+          if sbi_ini_i.wdata(i) = '1'
+          then
+            isr(i) <= '0';
+          end if;
+        end loop;
+      end if;
+    end if;
+  end process p_engine;
+
+  -----------------------------------------------------------------------------
+  -- Initiator
+  -----------------------------------------------------------------------------
+  sbi_ini_o.cs    <= '1' when state = DESC_RD or state = COPY_RD or state = COPY_WR else
+                     '0';
+  sbi_ini_o.re    <= '1' when state = DESC_RD or state = COPY_RD else
+                     '0';
+  sbi_ini_o.we    <= '1' when state = COPY_WR else
+                     '0';
+  sbi_ini_o.addr  <= std_logic_vector(desc_ptr+desc_idx) when state = DESC_RD else
+                     std_logic_vector(src)               when state = COPY_RD else
+                     std_logic_vector(dst);
+  sbi_ini_o.wdata <= data;
+
+  -----------------------------------------------------------------------------
+  -- Registers
+  -----------------------------------------------------------------------------
+  reg_addr <= to_integer(unsigned(sbi_ini_i.addr(2-1 downto 0)));
+  reg_we   <= sbi_ini_i.cs and sbi_ini_i.we;
+
+  p_reg: process (clk_i, arst_b_i) is
+  begin
+    if arst_b_i = '0'
+    then
+      imr <= (others => '0');
+    elsif rising_edge(clk_i)
+    then
+      if reg_we = '1' and reg_addr = REG_IMR
+      then
+        imr <= sbi_ini_i.wdata(imr'range);
+      end if;
+    end if;
+  end process p_reg;
+
+  p_rdata: process (all) is
+  begin
+    reg_rdata <= (others => '0');
+
+    case reg_addr is
+      when REG_ISR    => reg_rdata(isr'range) <= isr;
+      when REG_IMR    => reg_rdata(imr'range) <= imr;
+      when REG_DESC   => reg_rdata            <= std_logic_vector(desc_ptr);
+      when others     => reg_rdata(0)         <= busy;
+    end case;
+  end process p_rdata;
+
+  sbi_tgt_o.ready <= '1';
+  sbi_tgt_o.rdata <= reg_rdata;
+
+  it_o            <= '1' when (isr and imr) /= "00" else
+                     '0';
+
+end architecture rtl;
@@ -0,0 +1,187 @@
+-------------------------------------------------------------------------------
+-- Title      : Mailbox with fill level and interruptions
+-- Project    :
+-------------------------------------------------------------------------------
+-- File       : sbi_mailbox_it.vhd
+-- Author     : Mathieu Rosière
+-- Company    :
+-- Created    : 2026-10-17
+-- Standard   : VHDL'93/02
+-------------------------------------------------------------------------------
+-- Description: Two FIFOs shared by all the CPUs, same FIFO registers as
+--              sbi_mailbox.
+--              A push waits (ready) while the FIFO is full, a pop waits
+--              while the FIFO is empty.
+--              The interruption of a FIFO is set while its level is greater
+--              or equal to its watermark (0 : disabled). The interruption is
+--              a level : the receiver pops until the FIFO is empty then
+--              acks the GIC.
+--
+-- Register Map (ADDR_WIDTH = 2)
+--   0 FIFO0    : Write : push in FIFO0, Read : pop from FIFO0
+--   1 FIFO1    : Write : push in FIFO1, Read : pop from FIFO1
+--   2 LEVEL0   : Read  : number of bytes in FIFO0
+--                Write : watermark of the interruption of FIFO0
+--   3 LEVEL1   : Read  : number of bytes in FIFO1
+--                Write : watermark of the interruption of FIFO1
+-------------------------------------------------------------------------------
+-- Copyright (c) 2026
+-------------------------------------------------------------------------------
+-- Revisions  :
+-- Date        Version  Author   Description
+-- 2026-10-17  1.0      mrosiere Created
+-------------------------------------------------------------------------------
+library ieee;
+use     ieee.std_logic_1164.all;
+use     ieee.numeric_std.all;
+library asylum;
+use     asylum.sbi_pkg.all;
+
+entity sbi_mailbox_it is
+  generic
+    (FIFO0_DEPTH           : positive := 8
+    ;FIFO1_DEPTH           : positive := 8
+    );
+  port
+    (clk_i                 : in  std_logic
+    ;arst_b_i              : in  std_logic
+
+    ;sbi_ini_i             : in  sbi_ini_t
+    ;sbi_tgt_o             : out sbi_tgt_t
+
+    ;it_o                  : out std_logic_vector(2-1 downto 0) -- bit i : FIFO i
+    );
+end entity sbi_mailbox_it;
+
+architecture rtl of sbi_mailbox_it is
+
+  constant NB_FIFO              : positive := 2;
+
+  constant REG_FIFO0            : natural := 0;
+  constant REG_LEVEL0           : natural := 2;
+
+  type     depths_t  is array (0 to NB_FIFO-1) of positive;
+  type     levels_t  is array (0 to NB_FIFO-1) of unsigned(8-1 downto 0);
+  type     datas_t   is array (0 to NB_FIFO-1) of std_logic_vector(8-1 downto 0);
+
+  constant FIFO_DEPTH           : depths_t := (FIFO0_DEPTH, FIFO1_DEPTH);
+
+  signal   level                : levels_t;
+  signal   watermark            : levels_t;
+  signal   head                 : datas_t;
+  signal   push                 : std_logic_vector(NB_FIFO-1 downto 0);
+  signal   pop                  : std_logic_vector(NB_FIFO-1 downto 0);
+  signal   full                 : std_logic_vector(NB_FIFO-1 downto 0);
+  signal   empty                : std_logic_vector(NB_FIFO-1 downto 0);
+
+  signal   reg_addr             : natural range 0 to 4-1;
+  signal   reg_fifo             : natural range 0 to NB_FIFO-1;
+  signal   reg_re               : std_logic;
+  signal   reg_we               : std_logic;
+  signal   reg_rdata            : std_logic_vector(SBI_DATA_WIDTH-1 downto 0);
+  signal   ready                : std_logic;
+
+begin  -- architecture rtl
+
+  assert FIFO0_DEPTH < 256 report "FIFO0_DEPTH must be less than 256" severity failure;
+  assert FIFO1_DEPTH < 256 report "FIFO1_DEPTH must be less than 256" severity failure;
+
+  reg_addr <= to_integer(unsigned(sbi_ini_i.addr(2-1 downto 0)));
+  reg_fifo <= to_integer(unsigned(sbi_ini_i.addr(1-1 downto 0)));
+  reg_re   <= sbi_ini_i.cs and sbi_ini_i.re;
+  reg_we   <= sbi_ini_i.cs and sbi_ini_i.we;
+
+  -----------------------------------------------------------------------------
+  -- FIFOs
+  -----------------------------------------------------------------------------
+  gen_fifo: for i in 0 to NB_FIFO-1
+  generate
+    type     mem_t is array (0 to FIFO_DEPTH(i)-1) of std_logic_vector(8-1 downto 0);
+
+    signal   mem                : mem_t;
+    signal   wr_ptr             : natural range 0 to FIFO_DEPTH(i)-1;
+    signal   rd_ptr             : natural range 0 to FIFO_DEPTH(i)-1;
+  begin
+
+    push (i) <= reg_we and not full (i) when reg_addr = REG_FIFO0+i else '0';
+    pop  (i) <= reg_re and not empty(i) when reg_addr = REG_FIFO0+i else '0';
+    full (i) <= '1' when level(i) = FIFO_DEPTH(i) else '0';
+    empty(i) <= '1' when level(i) = 0             else '0';
+    head (i) <= mem(rd_ptr);
+
+    p_fifo: process (clk_i, arst_b_i) is
+    begin
+      if arst_b_i = '0'
+      then
+        wr_ptr       <= 0;
+        rd_ptr       <= 0;
+        level(i)     <= (others => '0');
+        watermark(i) <= (others => '0');
+      elsif rising_edge(clk_i)
+      then
+        if push(i) = '1'
+        then
+          mem(wr_ptr) <= sbi_ini_i.wdata(8-1 downto 0);
+
+          if wr_ptr = FIFO_DEPTH(i)-1
+          then
+            wr_ptr <= 0;
+          else
+            wr_ptr <= wr_ptr+1;
+          end if;
+        end if;
+
+        if pop(i) = '1'
+        then
+          if rd_ptr = FIFO_DEPTH(i)-1
+          then
+            rd_ptr <= 0;
+          else
+            rd_ptr <= rd_ptr+1;
+          end if;
+        end if;
+
+        if    push(i) = '1' and pop(i) = '0'
+        then
+          level(i) <= level(i)+1;
+        elsif push(i) = '0' and pop(i) = '1'
+        then
+          level(i) <= level(i)-1;
+        end if;
+
+        if reg_we = '1' and reg_addr = REG_LEVEL0+i
+        then
+          watermark(i) <= unsigned(sbi_ini_i.wdata(8-1 downto 0));
+        end if;
+      end if;
+    end process p_fifo;
+
+    it_o(i) <= '1' when watermark(i) /= 0 and level(i) >= watermark(i) else
+               '0';
+
+  end generate gen_fifo;
+
+  -----------------------------------------------------------------------------
+  -- Registers
+  -----------------------------------------------------------------------------
+  -- Wait while the FIFO is full (push) or empty (pop)
+  ready <= not full (reg_fifo) when reg_we = '1' and reg_addr < REG_LEVEL0 else
+           not empty(reg_fifo) when reg_re = '1' and reg_addr < REG_LEVEL0 else
+           '1';
+
+  p_rdata: process (all) is
+  begin
+    reg_rdata <= (others => '0');
+
+    if reg_addr < REG_LEVEL0
+    then
+      reg_rdata(8-1 downto 0) <= head (reg_fifo);
+    else
+      reg_rdata(8-1 downto 0) <= std_logic_vector(level(reg_fifo));
+    end if;
+  end process p_rdata;
+
+  sbi_tgt_o.ready <= ready;
+  sbi_tgt_o.rdata <= reg_rdata;
+
+end architecture rtl;
@@ -0,0 +1,385 @@
+-------------------------------------------------------------------------------
+-- Title      : Modbus RTU frame accelerator
+-- Project    :
+-------------------------------------------------------------------------------
+-- File       : sbi_modbus_rtu.vhd
+-- Author     : Mathieu Rosière
+-- Company    :
+-- Created    : 2026-10-17
+-- Standard   : VHDL'93/02
+-------------------------------------------------------------------------------
+-- Description: Snoop the UART RX line and extract Modbus RTU frames.
+--              - Frame delimitation by T3.5 silence detection
+--              - Filter on slave address (and broadcast)
+--              - On-the-fly CRC16 check (residue must be 0)
+--              - Single frame buffer, released by software
+--              One interrupt is raised per valid frame.
+--
+-- Register Map (ADDR_WIDTH = 3)
+--   0 ISR      : [0] Frame valid. Write 1 to release the frame buffer
+--   1 IMR      : [0] Frame valid interrupt enable
+--   2 CTRL     : [0] Enable, [1] Accept broadcast address (0x00)
+--   3 SLAVE_ID : Slave address
+--   4 LEN      : Number of bytes of the valid frame (CRC included)
+--   5 DATA     : Read the next byte of the valid frame
+--   6 CNT_DROP : Frames dropped (buffer busy or overflow). Write to clear
+--   7 CNT_CRC  : Frames with bad CRC or bad framing.       Write to clear
+-------------------------------------------------------------------------------
+-- Copyright (c) 2026
+-------------------------------------------------------------------------------
+-- Revisions  :
+-- Date        Version  Author   Description
+-- 2026-10-17  1.0      mrosiere Created
+-------------------------------------------------------------------------------
+library ieee;
+use     ieee.std_logic_1164.all;
+use     ieee.numeric_std.all;
+library asylum;
+use     asylum.sbi_pkg.all;
+
+entity sbi_modbus_rtu is
+  generic
+    (CLOCK_FREQ            : integer  := 50000000
+    ;BAUD_RATE             : integer  := 115200
+    ;DEPTH                 : positive := 32
+    ;SLAVE_ID              : std_logic_vector(8-1 downto 0) := x"5A"
+    );
+  port
+    (clk_i                 : in  std_logic
+    ;arst_b_i              : in  std_logic
+
+    ;sbi_ini_i             : in  sbi_ini_t
+    ;sbi_tgt_o             : out sbi_tgt_t
+
+    ;uart_rx_i             : in  std_logic
+    ;it_o                  : out std_logic
+    );
+end entity sbi_modbus_rtu;
+
+architecture rtl of sbi_modbus_rtu is
+
+  constant BIT_CYCLES           : positive := CLOCK_FREQ/BAUD_RATE;
+  constant T35_CYCLES           : positive := BIT_CYCLES*35; -- 3.5 characters of 10 bits
+
+  constant REG_ISR              : natural := 0;
+  constant REG_IMR              : natural := 1;
+  constant REG_CTRL             : natural := 2;
+  constant REG_SLAVE_ID         : natural := 3;
+  constant REG_LEN              : natural := 4;
+  constant REG_DATA             : natural := 5;
+  constant REG_CNT_DROP         : natural := 6;
+  constant REG_CNT_CRC          : natural := 7;
+
+  constant CRC16_POLYNOM        : std_logic_vector(16-1 downto 0) := x"A001";
+
+  type buffer_t is array (natural range <>) of std_logic_vector(8-1 downto 0);
+
+  function crc16_next
+    (crc  : std_logic_vector(16-1 downto 0)
+    ;data : std_logic_vector( 8-1 downto 0)
+    ) return std_logic_vector is
+    variable res : std_logic_vector(16-1 downto 0);
+  begin
+    res := crc xor (x"00" & data);
+    for i in 0 to 8-1 loop
+      if res(0) = '1' then
+        res := ('0' & res(16-1 downto 1)) xor CRC16_POLYNOM;
+      else
+        res := ('0' & res(16-1 downto 1));
+      end if;
+    end loop;
+    return res;
+  end function crc16_next;
+
+  -- UART RX
+  signal   rx_sync              : std_logic_vector(2-1 downto 0);
+  signal   rx_busy              : std_logic;
+  signal   rx_cnt               : natural range 0 to BIT_CYCLES;
+  signal   rx_bit               : natural range 0 to 9;
+  signal   rx_shift             : std_logic_vector(8-1 downto 0);
+  signal   rx_val               : std_logic;
+  signal   rx_err               : std_logic;
+
+  -- Silence detection
+  signal   silence_cnt          : natural range 0 to T35_CYCLES;
+  signal   frame_eof            : std_logic;
+
+  -- Frame
+  signal   frame_active         : std_logic;
+  signal   frame_ignore         : std_logic;
+  signal   frame_drop           : std_logic;
+  signal   frame_err            : std_logic;
+  signal   frame_len            : natural range 0 to DEPTH;
+  signal   frame_crc            : std_logic_vector(16-1 downto 0);
+  signal   frame_buffer         : buffer_t(0 to DEPTH-1);
+
+  -- Registers
+  signal   isr_valid            : std_logic;
+  signal   imr_valid            : std_logic;
+  signal   ctrl_enable          : std_logic;
+  signal   ctrl_broadcast       : std_logic;
+  signal   slave_id_r           : std_logic_vector(8-1 downto 0);
+  signal   valid_len            : natural range 0 to DEPTH;
+  signal   rd_ptr               : natural range 0 to DEPTH;
+  signal   cnt_drop             : unsigned(8-1 downto 0);
+  signal   cnt_crc              : unsigned(8-1 downto 0);
+
+  signal   reg_addr             : natural range 0 to 8-1;
+  signal   reg_re               : std_logic;
+  signal   reg_we               : std_logic;
+  signal   reg_rdata            : std_logic_vector(8-1 downto 0);
+
+begin  -- architecture rtl
+
+  -----------------------------------------------------------------------------
+  -- UART RX : 8N1, sample at the middle of each bit
+  -----------------------------------------------------------------------------
+  p_rx: process (clk_i, arst_b_i) is
+  begin
+    if arst_b_i = '0'
+    then
+      rx_sync  <= (others => '1');
+      rx_busy  <= '0';
+      rx_cnt   <= 0;
+      rx_bit   <= 0;
+      rx_shift <= (others => '0');
+      rx_val   <= '0';
+      rx_err   <= '0';
+    elsif rising_edge(clk_i)
+    then
+      rx_sync  <= rx_sync(0) & uart_rx_i;
+      rx_val   <= '0';
+      rx_err   <= '0';
+
+      if rx_busy = '0'
+      then
+        -- Start bit
+        if rx_sync(1) = '0'
+        then
+          rx_busy <= '1';
+          rx_cnt  <= BIT_CYCLES/2;
+          rx_bit  <= 0;
+        end if;
+      elsif rx_cnt /= 0
+      then
+        rx_cnt  <= rx_cnt-1;
+      else
+        rx_cnt  <= BIT_CYCLES-1;
+
+        if rx_bit = 0
+        then
+          -- Glitch on the start bit
+          if rx_sync(1) = '1'
+          then
+            rx_busy <= '0';
+          end if;
+          rx_bit  <= 1;
+        elsif rx_bit = 9
+        then
+          -- Stop bit
+          rx_busy <= '0';
+          rx_val  <= '1';
+          rx_err  <= not rx_sync(1);
+        else
+          rx_shift <= rx_sync(1) & rx_shift(8-1 downto 1);
+          rx_bit   <= rx_bit+1;
+        end if;
+      end if;
+    end if;
+  end process p_rx;
+
+  -----------------------------------------------------------------------------
+  -- Silence detection : end of frame after T3.5 without character
+  -----------------------------------------------------------------------------
+  p_silence: process (clk_i, arst_b_i) is
+  begin
+    if arst_b_i = '0'
+    then
+      silence_cnt <= 0;
+      frame_eof   <= '0';
+    elsif rising_edge(clk_i)
+    then
+      frame_eof   <= '0';
+
+      if rx_busy = '1'
+      then
+        silence_cnt <= 0;
+      elsif silence_cnt /= T35_CYCLES
+      then
+        silence_cnt <= silence_cnt+1;
+
+        if silence_cnt = T35_CYCLES-1
+        then
+          frame_eof <= frame_active;
+        end if;
+      end if;
+    end if;
+  end process p_silence;
+
+  -----------------------------------------------------------------------------
+  -- Frame reception
+  -----------------------------------------------------------------------------
+  p_frame: process (clk_i, arst_b_i) is
+  begin
+    if arst_b_i = '0'
+    then
+      frame_active <= '0';
+      frame_ignore <= '0';
+      frame_drop   <= '0';
+      frame_err    <= '0';
+      frame_len    <= 0;
+      frame_crc    <= (others => '1');
+      isr_valid    <= '0';
+      valid_len    <= 0;
+      rd_ptr       <= 0;
+      cnt_drop     <= (others => '0');
+      cnt_crc      <= (others => '0');
+    elsif rising_edge(clk_i)
+    then
+      if rx_val = '1'
+      then
+        frame_active <= '1';
+
+        if frame_active = '0'
+        then
+          -- First character : slave address
+          frame_ignore <= '0';
+          frame_drop   <= isr_valid;
+          frame_err    <= rx_err;
+          frame_crc    <= crc16_next(x"FFFF", rx_shift);
+          frame_len    <= 1;
+
+          if isr_valid = '0'
+          then
+            frame_buffer(0) <= rx_shift;
+          end if;
+
+          if ctrl_enable = '0' or
+            (rx_shift /= slave_id_r and (rx_shift /= x"00" or ctrl_broadcast = '0'))
+          then
+            frame_ignore <= '1';
+          end if;
+        else
+          frame_err    <= frame_err or rx_err;
+          frame_crc    <= crc16_next(frame_crc, rx_shift);
+
+          if frame_ignore = '0' and frame_drop = '0'
+          then
+            if frame_len = DEPTH
+            then
+              frame_drop <= '1';
+            else
+              frame_buffer(frame_len) <= rx_shift;
+              frame_len               <= frame_len+1;
+            end if;
+          end if;
+        end if;
+      end if;
+
+      if frame_eof = '1'
+      then
+        frame_active <= '0';
+
+        if frame_ignore = '0'
+        then
+          if frame_drop = '1'
+          then
+            if cnt_drop /= x"FF"
+            then
+              cnt_drop <= cnt_drop+1;
+            end if;
+          elsif frame_err = '1' or frame_len < 4 or frame_crc /= x"0000"
+          then
+            if cnt_crc /= x"FF"
+            then
+              cnt_crc <= cnt_crc+1;
+            end if;
+          else
+            isr_valid <= '1';
+            valid_len <= frame_len;
+            rd_ptr    <= 0;
+          end if;
+        end if;
+      end if;
+
+      -- Software access
+      if reg_re = '1' and reg_addr = REG_DATA and rd_ptr /= valid_len
+      then
+        rd_ptr <= rd_ptr+1;
+      end if;
+
+      if reg_we = '1'
+      then
+        case reg_addr is
+          when REG_ISR      => if sbi_ini_i.wdata(0) = '1' then isr_valid <= '0'; end if;
+          when REG_CNT_DROP => cnt_drop <= (others => '0');
+          when REG_CNT_CRC  => cnt_crc  <= (others => '0');
+          when others       => null;
+        end case;
+      end if;
+    end if;
+  end process p_frame;
+
+  -----------------------------------------------------------------------------
+  -- Registers
+  -----------------------------------------------------------------------------
+  reg_addr <= to_integer(unsigned(sbi_ini_i.addr(3-1 downto 0)));
+  reg_re   <= sbi_ini_i.cs and sbi_ini_i.re;
+  reg_we   <= sbi_ini_i.cs and sbi_ini_i.we;
+
+  p_reg: process (clk_i, arst_b_i) is
+  begin
+    if arst_b_i = '0'
+    then
+      imr_valid      <= '0';
+      ctrl_enable    <= '0';
+      ctrl_broadcast <= '0';
+      slave_id_r     <= SLAVE_ID;
+    elsif rising_edge(clk_i)
+    then
+      if reg_we = '1'
+      then
+        case reg_addr is
+          when REG_IMR      => imr_valid      <= sbi_ini_i.wdata(0);
+          when REG_CTRL     => ctrl_enable    <= sbi_ini_i.wdata(0);
+                               ctrl_broadcast <= sbi_ini_i.wdata(1);
+          when REG_SLAVE_ID => slave_id_r     <= sbi_ini_i.wdata(8-1 downto 0);
+          when others       => null;
+        end case;
+      end if;
+    end if;
+  end process p_reg;
+
+  p_rdata: process (all) is
+  begin
+    reg_rdata <= (others => '0');
+
+    case reg_addr is
+      when REG_ISR      => reg_rdata(0) <= isr_valid;
+      when REG_IMR      => reg_rdata(0) <= imr_valid;
+      when REG_CTRL     => reg_rdata(0) <= ctrl_enable;
+                           reg_rdata(1) <= ctrl_broadcast;
+      when REG_SLAVE_ID => reg_rdata    <= slave_id_r;
+      when REG_LEN      => reg_rdata    <= std_logic_vector(to_unsigned(valid_len, 8));
+      when REG_DATA     => if rd_ptr /= valid_len then
+                             reg_rdata  <= frame_buffer(rd_ptr);
+                           end if;
+      when REG_CNT_DROP => reg_rdata    <= std_logic_vector(cnt_drop);
+      when REG_CNT_CRC  => reg_rdata    <= std_logic_vector(cnt_crc);
+      when others       => null;
+    end case;
+  end process p_rdata;
+
+  sbi_tgt_o.ready <= '1';
+  sbi_tgt_o.rdata <= reg_rdata;
+
+  it_o            <= isr_valid and imr_valid;
+
+  -----------------------------------------------------------------------------
+  -- Check Generics
+  -----------------------------------------------------------------------------
+  assert (DEPTH < 256)
+    report "Invalid DEPTH: must fit in the LEN register"
+    severity failure;
+
+end architecture rtl;
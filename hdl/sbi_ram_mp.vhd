@@ -0,0 +1,165 @@
+-------------------------------------------------------------------------------
+-- Title      : Banked RAM with one port per master
+-- Project    :
+-------------------------------------------------------------------------------
+-- File       : sbi_ram_mp.vhd
+-- Author     : Mathieu Rosière
+-- Company    :
+-- Created    : 2026-10-17
+-- Standard   : VHDL'93/02
+-------------------------------------------------------------------------------
+-- Description: RAM of DEPTH words split in NB_BANK banks (sbi_ram) with the
+--              address interleaved : the word at the address a is in the
+--              bank (a mod NB_BANK) at the address (a / NB_BANK).
+--              Each bank has its own arbiter (sbi_arbiter, ALGO) : the ports
+--              accessing distinct banks are not waiting each other, a table
+--              of consecutive words is spread on all the banks.
+--              DEPTH and NB_BANK must be powers of 2.
+-------------------------------------------------------------------------------
+-- Copyright (c) 2026
+-------------------------------------------------------------------------------
+-- Revisions  :
+-- Date        Version  Author   Description
+-- 2026-10-17  1.0      mrosiere Created
+-- 2026-10-17  1.1      mrosiere Add Generic SYNC_READ
+-- 2026-10-17  1.2      mrosiere Remove Generic SYNC_READ
+-------------------------------------------------------------------------------
+library ieee;
+use     ieee.std_logic_1164.all;
+use     ieee.numeric_std.all;
+library asylum;
+use     asylum.sbi_pkg.all;
+use     asylum.math_pkg.all;
+use     asylum.ram_pkg.all;
+
+entity sbi_ram_mp is
+  generic
+    (NB_PORT               : positive := 2
+    ;NB_BANK               : positive := 2
+    ;DEPTH                 : positive := 64     -- Words of the RAM (all the banks)
+    ;ALGO                  : string   := "rr"   -- Arbiter of each bank : "fix" / "rr"
+    );
+  port
+    (clk_i                 : in  std_logic
+    ;arst_b_i              : in  std_logic
+
+    ;sbi_inis_i            : in  sbi_inis_t
+    ;sbi_tgts_o            : out sbi_tgts_t
+    );
+end entity sbi_ram_mp;
+
+architecture rtl of sbi_ram_mp is
+
+  constant ADDR_WIDTH           : positive := sbi_inis_i(sbi_inis_i'low).addr 'length;
+  constant WDATA_WIDTH          : positive := sbi_inis_i(sbi_inis_i'low).wdata'length;
+  constant RDATA_WIDTH          : positive := sbi_tgts_o(sbi_tgts_o'low).rdata'length;
+
+  constant BANK_SEL_WIDTH       : natural  := log2(NB_BANK);
+  constant BANK_DEPTH           : positive := DEPTH/NB_BANK;
+  constant BANK_ADDR_WIDTH      : natural  := log2(BANK_DEPTH);
+
+  type     banks_t       is array (0 to NB_PORT-1) of natural range 0 to NB_BANK-1;
+
+  signal   bank                 : banks_t;
+
+  -- Response of the bank b to the port p : index b*NB_PORT+p
+  signal   bank_tgts            : sbi_tgts_t(NB_BANK*NB_PORT-1 downto 0)(rdata(RDATA_WIDTH-1 downto 0));
+
+begin  -- architecture rtl
+
+  assert 2**BANK_SEL_WIDTH  = NB_BANK report "NB_BANK must be a power of 2"          severity failure;
+  assert 2**BANK_ADDR_WIDTH = BANK_DEPTH and BANK_DEPTH*NB_BANK = DEPTH
+                                      report "DEPTH must be a power of 2, >= NB_BANK" severity failure;
+
+  -----------------------------------------------------------------------------
+  -- Bank of each port : address LSB
+  -----------------------------------------------------------------------------
+  gen_port: for p in 0 to NB_PORT-1
+  generate
+    gen_bank_sel:
+    if BANK_SEL_WIDTH > 0
+    generate
+      bank(p) <= to_integer(unsigned(sbi_inis_i(p).addr(BANK_SEL_WIDTH-1 downto 0)));
+    end generate gen_bank_sel;
+
+    gen_bank_sel_b:
+    if BANK_SEL_WIDTH = 0
+    generate
+      bank(p) <= 0;
+    end generate gen_bank_sel_b;
+
+    sbi_tgts_o(p) <= bank_tgts(bank(p)*NB_PORT+p);
+  end generate gen_port;
+
+  -----------------------------------------------------------------------------
+  -- Banks
+  -----------------------------------------------------------------------------
+  gen_bank: for b in 0 to NB_BANK-1
+  generate
+    signal   arb_inis           : sbi_inis_t(NB_PORT-1 downto 0)(addr (ADDR_WIDTH -1 downto 0),
+                                                                 wdata(WDATA_WIDTH-1 downto 0));
+    signal   arb_tgts           : sbi_tgts_t(NB_PORT-1 downto 0)(rdata(RDATA_WIDTH-1 downto 0));
+    signal   arb_ini            : sbi_ini_t (addr (ADDR_WIDTH -1 downto 0),
+                                             wdata(WDATA_WIDTH-1 downto 0));
+    signal   ram_ini            : sbi_ini_t (addr (ADDR_WIDTH -1 downto 0),
+                                             wdata(WDATA_WIDTH-1 downto 0));
+    signal   ram_tgt            : sbi_tgt_t (rdata(RDATA_WIDTH-1 downto 0));
+  begin
+
+    gen_port: for p in 0 to NB_PORT-1
+    generate
+      -- Only the ports accessing this bank
+      p_req: process (all) is
+        variable ini : sbi_ini_t(addr (ADDR_WIDTH -1 downto 0),
+                                 wdata(WDATA_WIDTH-1 downto 0));
+      begin
+        ini := sbi_inis_i(p);
+
+        if bank(p) /= b
+        then
+          ini.cs := '0';
+        end if;
+
+        arb_inis(p) <= ini;
+      end process p_req;
+
+      bank_tgts(b*NB_PORT+p) <= arb_tgts(p);
+    end generate gen_port;
+
+    ins_sbi_arbiter : entity asylum.sbi_arbiter(rtl)
+      generic map
+      (NB_MASTER              => NB_PORT
+      ,ALGO                   => ALGO
+      )
+      port map
+      (clk_i                  => clk_i
+      ,arst_b_i               => arst_b_i
+      ,sbi_inis_i             => arb_inis
+      ,sbi_tgts_o             => arb_tgts
+      ,sbi_ini_o              => arb_ini
+      ,sbi_tgt_i              => ram_tgt
+      );
+
+    -- Address in the bank
+    p_addr: process (all) is
+    begin
+      ram_ini      <= arb_ini;
+      ram_ini.addr <= (others => '0');
+      ram_ini.addr(BANK_ADDR_WIDTH-1 downto 0) <= arb_ini.addr(BANK_SEL_WIDTH+BANK_ADDR_WIDTH-1 downto BANK_SEL_WIDTH);
+    end process p_addr;
+
+    ins_sbi_ram : sbi_ram
+      generic map
+      (DEPTH                  => BANK_DEPTH
+      ,SYNC_READ              => true
+      )
+      port map
+      (clk_i                  => clk_i
+      ,arst_b_i               => arst_b_i
+      ,sbi_ini_i              => ram_ini
+      ,sbi_tgt_o              => ram_tgt
+      );
+
+  end generate gen_bank;
+
+end architecture rtl;
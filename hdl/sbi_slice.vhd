@@ -0,0 +1,108 @@
+-------------------------------------------------------------------------------
+-- Title      : Register slice between 1 master and 1 target
+-- Project    :
+-------------------------------------------------------------------------------
+-- File       : sbi_slice.vhd
+-- Author     : Mathieu Rosière
+-- Company    :
+-- Created    : 2026-10-17
+-- Standard   : VHDL'93/02
+-------------------------------------------------------------------------------
+-- Description: Cut the combinatorial paths of an access :
+--              * request  : cs, re, we, addr and wdata of the master are
+--                registered before the target
+--              * response : ready and rdata of the target are registered
+--                before the master
+--              The master sees 2 wait states more (ready = 0), the target
+--              sees exactly one access : no change for the software.
+--              Cycle 0 : request registered
+--              Cycle 1 : access on the target, until its ready = 1
+--              Cycle 2 : response to the master (ready = 1)
+--              Faster when the gain of Fmax is higher than the cost of
+--              the wait states (see README)
+-------------------------------------------------------------------------------
+-- Copyright (c) 2026
+-------------------------------------------------------------------------------
+-- Revisions  :
+-- Date        Version  Author   Description
+-- 2026-10-17  1.0      mrosiere Created
+-- 2026-10-17  1.1      mrosiere Comment on the gain
+-------------------------------------------------------------------------------
+library ieee;
+use     ieee.std_logic_1164.all;
+use     ieee.numeric_std.all;
+library asylum;
+use     asylum.sbi_pkg.all;
+
+entity sbi_slice is
+  port
+    (clk_i                 : in  std_logic
+    ;arst_b_i              : in  std_logic
+
+    -- From the master
+    ;sbi_ini_i             : in  sbi_ini_t
+    ;sbi_tgt_o             : out sbi_tgt_t
+
+    -- To the target
+    ;sbi_ini_o             : out sbi_ini_t
+    ;sbi_tgt_i             : in  sbi_tgt_t
+    );
+end entity sbi_slice;
+
+architecture rtl of sbi_slice is
+
+  constant ADDR_WIDTH           : positive := sbi_ini_i.addr 'length;
+  constant WDATA_WIDTH          : positive := sbi_ini_i.wdata'length;
+  constant RDATA_WIDTH          : positive := sbi_tgt_i.rdata'length;
+
+  signal   ini_r                : sbi_ini_t(addr (ADDR_WIDTH -1 downto 0),
+                                            wdata(WDATA_WIDTH-1 downto 0)); -- cs = 1 : access on the target
+  signal   rsp_r                : std_logic;                                -- Response to the master
+  signal   rdata_r              : std_logic_vector(RDATA_WIDTH-1 downto 0);
+
+begin  -- architecture rtl
+
+  p_reg: process (clk_i, arst_b_i) is
+  begin
+    if arst_b_i = '0'
+    then
+      ini_r.cs    <= '0';
+      ini_r.re    <= '0';
+      ini_r.we    <= '0';
+      ini_r.addr  <= (others => '0');
+      ini_r.wdata <= (others => '0');
+      rsp_r       <= '0';
+      rdata_r     <= (others => '0');
+    elsif rising_edge(clk_i)
+    then
+      rsp_r       <= '0';
+
+      if ini_r.cs = '1'
+      then
+        -- End of the access on the target
+        if sbi_tgt_i.ready = '1'
+        then
+          ini_r.cs <= '0';
+          ini_r.re <= '0';
+          ini_r.we <= '0';
+          rsp_r    <= '1';
+          rdata_r  <= sbi_tgt_i.rdata;
+        end if;
+
+      -- The master keeps cs during the response : next access after
+      elsif rsp_r = '0' and sbi_ini_i.cs = '1'
+      then
+        ini_r     <= sbi_ini_i;
+      end if;
+    end if;
+  end process p_reg;
+
+  -----------------------------------------------------------------------------
+  -- Ports
+  -----------------------------------------------------------------------------
+  sbi_ini_o       <= ini_r;
+
+  sbi_tgt_o.ready <= rsp_r;
+  sbi_tgt_o.rdata <= rdata_r;
+
+end architecture rtl;
@@ -0,0 +1,413 @@
+-------------------------------------------------------------------------------
+-- Title      : SPI master with Dual and Quad I/O
+-- Project    :
+-------------------------------------------------------------------------------
+-- File       : sbi_spi_quad.vhd
+-- Author     : Mathieu Rosière
+-- Company    :
+-- Created    : 2026-10-17
+-- Standard   : VHDL'93/02
+-------------------------------------------------------------------------------
+-- Description: SPI master with the register map of sbi_spi (see spi.h)
+--              and a bus width for each command :
+--              - Single : IO0 is MOSI, IO1 is MISO
+--              - Dual   : IO1..IO0 (bit 7 on IO1)
+--              - Quad   : IO3..IO0 (bit 7 on IO3)
+--              In Dual and Quad, a command with TX drives the IOs and
+--              a command without TX samples the IOs.
+--              The width is taken from CFG when the command is written,
+--              so each phase (instruction, address, dummy, data) of a
+--              flash access is a command with its own width.
+--              In Single and Dual, IO3..IO2 (HOLD#, WP#) are driven to 1.
+--              While CS is asserted, the IOs are only driven during a
+--              command : between two commands (ex : after the dummy
+--              bytes, between two RX bursts) the IOs are tri-stated,
+--              the flash can drive them. IO3..IO2 need a pull-up.
+--
+--              The command, TX and RX buffers have one entry : an access
+--              is stalled (ready = 0) until the entry is free (CMD, TX)
+--              or full (RX).
+--
+-- Register Map (ADDR_WIDTH = 2)
+--   0 DATA     : Write : TX byte, Read : RX byte
+--   1 CMD      : [7] TX, [6] RX, [5] LAST (release CS), [4:0] LEN-1
+--   2 CFG      : [0] Enable, [1] CPOL, [2] CPHA, [3] Loopback,
+--                [5:4] Width (0 : Single, 1 : Dual, 2 : Quad)
+--   3 PRESCALER: Half period of SCLK is PRESCALER+1 clock cycles
+-------------------------------------------------------------------------------
+-- Copyright (c) 2026
+-------------------------------------------------------------------------------
+-- Revisions  :
+-- Date        Version  Author   Description
+-- 2026-10-17  1.0      mrosiere Created
+-- 2026-10-17  1.1      mrosiere Tri-state the IOs between two commands
+-------------------------------------------------------------------------------
+library ieee;
+use     ieee.std_logic_1164.all;
+use     ieee.numeric_std.all;
+library asylum;
+use     asylum.sbi_pkg.all;
+
+entity sbi_spi_quad is
+  generic
+    (PRESCALER_RATIO       : std_logic_vector(8-1 downto 0) := x"00"
+    );
+  port
+    (clk_i                 : in  std_logic
+    ;arst_b_i              : in  std_logic
+
+    ;sbi_ini_i             : in  sbi_ini_t
+    ;sbi_tgt_o             : out sbi_tgt_t
+
+    ;sclk_o                : out std_logic
+    ;cs_b_o                : out std_logic
+    ;io_o                  : out std_logic_vector(4-1 downto 0)
+    ;io_oe_o               : out std_logic_vector(4-1 downto 0)
+    ;io_i                  : in  std_logic_vector(4-1 downto 0)
+    );
+end entity sbi_spi_quad;
+
+architecture rtl of sbi_spi_quad is
+
+  constant REG_DATA             : natural := 0;
+  constant REG_CMD              : natural := 1;
+  constant REG_CFG              : natural := 2;
+  constant REG_PRESCALER        : natural := 3;
+
+  constant CFG_ENABLE           : natural := 0;
+  constant CFG_CPOL             : natural := 1;
+  constant CFG_CPHA             : natural := 2;
+  constant CFG_LOOPBACK         : natural := 3;
+
+  constant WIDTH_SINGLE         : std_logic_vector(2-1 downto 0) := "00";
+  constant WIDTH_DUAL           : std_logic_vector(2-1 downto 0) := "01";
+  constant WIDTH_QUAD           : std_logic_vector(2-1 downto 0) := "10";
+
+  type state_t is (IDLE, LOAD, SHIFT, STORE, CS_END);
+
+  signal   state                : state_t;
+
+  signal   cfg                  : std_logic_vector(6-1 downto 0);
+  signal   prescaler            : unsigned(8-1 downto 0);
+
+  -- Command buffer
+  signal   cmd_valid            : std_logic;
+  signal   cmd                  : std_logic_vector(8-1 downto 0);
+  signal   cmd_width            : std_logic_vector(2-1 downto 0);
+
+  -- TX / RX buffers
+  signal   tx_valid             : std_logic;
+  signal   tx_data              : std_logic_vector(8-1 downto 0);
+  signal   rx_valid             : std_logic;
+  signal   rx_data              : std_logic_vector(8-1 downto 0);
+
+  -- Current command
+  signal   cur_tx               : std_logic;
+  signal   cur_rx               : std_logic;
+  signal   cur_last             : std_logic;
+  signal   cur_len              : unsigned(5-1 downto 0);
+  signal   cur_width            : std_logic_vector(2-1 downto 0);
+
+  signal   shift_out            : std_logic_vector(8-1 downto 0);
+  signal   shift_in             : std_logic_vector(8-1 downto 0);
+  signal   step                 : unsigned(3-1 downto 0);
+  signal   step_first           : std_logic;
+  signal   half                 : std_logic;
+  signal   tick_cnt             : unsigned(8-1 downto 0);
+  signal   tick                 : std_logic;
+  signal   sclk                 : std_logic;
+  signal   cs_b                 : std_logic;
+
+  signal   io_in                : std_logic_vector(4-1 downto 0);
+
+  signal   reg_addr             : natural range 0 to 4-1;
+  signal   reg_we               : std_logic;
+  signal   reg_re               : std_logic;
+  signal   reg_ready            : std_logic;
+  signal   reg_rdata            : std_logic_vector(SBI_DATA_WIDTH-1 downto 0);
+
+  -- Shift of "width" bits
+  function shift
+    (data  : std_logic_vector(8-1 downto 0)
+    ;bits  : std_logic_vector(4-1 downto 0)
+    ;width : std_logic_vector(2-1 downto 0)
+    ) return std_logic_vector is
+  begin
+    case width is
+      when WIDTH_QUAD => return data(8-4-1 downto 0) & bits(4-1 downto 0);
+      when WIDTH_DUAL => return data(8-2-1 downto 0) & bits(2-1 downto 0);
+      when others     => return data(8-1-1 downto 0) & bits(0);
+    end case;
+  end function shift;
+
+begin  -- architecture rtl
+
+  -----------------------------------------------------------------------------
+  -- Inputs
+  -- In Single, the input bit is MISO (IO1)
+  -----------------------------------------------------------------------------
+  io_in    <= shift_out(8-1 downto 4)                  when cfg(CFG_LOOPBACK) = '1' and cur_width = WIDTH_QUAD else
+              "00" & shift_out(8-1 downto 6)           when cfg(CFG_LOOPBACK) = '1' and cur_width = WIDTH_DUAL else
+              "000" & shift_out(8-1)                   when cfg(CFG_LOOPBACK) = '1'                            else
+              io_i                                     when cur_width = WIDTH_QUAD                             else
+              "00" & io_i(2-1 downto 0)                when cur_width = WIDTH_DUAL                             else
+              "000" & io_i(1);
+
+  -----------------------------------------------------------------------------
+  -- SCLK half period
+  -----------------------------------------------------------------------------
+  tick     <= '1' when tick_cnt = 0 else
+              '0';
+
+  -----------------------------------------------------------------------------
+  -- Engine
+  -----------------------------------------------------------------------------
+  p_engine: process (clk_i, arst_b_i) is
+  begin
+    if arst_b_i = '0'
+    then
+      state      <= IDLE;
+      cmd_valid  <= '0';
+      cmd        <= (others => '0');
+      cmd_width  <= WIDTH_SINGLE;
+      tx_valid   <= '0';
+      tx_data    <= (others => '0');
+      rx_valid   <= '0';
+      rx_data    <= (others => '0');
+      cur_tx     <= '0';
+      cur_rx     <= '0';
+      cur_last   <= '0';
+      cur_len    <= (others => '0');
+      cur_width  <= WIDTH_SINGLE;
+      shift_out  <= (others => '0');
+      shift_in   <= (others => '0');
+      step       <= (others => '0');
+      step_first <= '0';
+      half       <= '0';
+      tick_cnt   <= (others => '0');
+      sclk       <= '0';
+      cs_b       <= '1';
+    elsif rising_edge(clk_i)
+    then
+      -- SCLK half period
+      if tick = '1' or state = LOAD
+      then
+        tick_cnt <= prescaler;
+      else
+        tick_cnt <= tick_cnt-1;
+      end if;
+
+      case state is
+        when IDLE =>
+          sclk <= cfg(CFG_CPOL);
+
+          if cmd_valid = '1' and cfg(CFG_ENABLE) = '1'
+          then
+            cmd_valid <= '0';
+            cur_tx    <= cmd(7);
+            cur_rx    <= cmd(6);
+            cur_last  <= cmd(5);
+            cur_len   <= unsigned(cmd(5-1 downto 0));
+            cur_width <= cmd_width;
+            cs_b      <= '0';
+            state     <= LOAD;
+          end if;
+
+        when LOAD =>
+          if cur_tx = '0' or tx_valid = '1'
+          then
+            if cur_tx = '1'
+            then
+              shift_out <= tx_data;
+              tx_valid  <= '0';
+            else
+              shift_out <= (others => '0');
+            end if;
+
+            case cur_width is
+              when WIDTH_QUAD => step <= to_unsigned(2-1,step'length);
+              when WIDTH_DUAL => step <= to_unsigned(4-1,step'length);
+              when others     => step <= to_unsigned(8-1,step'length);
+            end case;
+
+            step_first <= '1';
+            half       <= '0';
+            state      <= SHIFT;
+          end if;
+
+        when SHIFT =>
+          if tick = '1'
+          then
+            half <= not half;
+
+            if half = '0'
+            then
+              -- Leading edge
+              sclk <= not cfg(CFG_CPOL);
+
+              if cfg(CFG_CPHA) = '0'
+              then
+                shift_in  <= shift(shift_in ,io_in,cur_width);
+              elsif step_first = '0'
+              then
+                shift_out <= shift(shift_out,"0000",cur_width);
+              end if;
+            else
+              -- Trailing edge
+              sclk       <= cfg(CFG_CPOL);
+              step_first <= '0';
+
+              if cfg(CFG_CPHA) = '0'
+              then
+                shift_out <= shift(shift_out,"0000",cur_width);
+              else
+                shift_in  <= shift(shift_in ,io_in,cur_width);
+              end if;
+
+              if step = 0
+              then
+                state <= STORE;
+              else
+                step  <= step-1;
+              end if;
+            end if;
+          end if;
+
+        when STORE =>
+          if cur_rx = '0' or rx_valid = '0'
+          then
+            if cur_rx = '1'
+            then
+              rx_data  <= shift_in;
+              rx_valid <= '1';
+            end if;
+
+            if cur_len = 0
+            then
+              if cur_last = '1'
+              then
+                state <= CS_END;
+              else
+                -- Keep CS for the next command
+                state <= IDLE;
+              end if;
+            else
+              cur_len <= cur_len-1;
+              state   <= LOAD;
+            end if;
+          end if;
+
+        when CS_END =>
+          if tick = '1'
+          then
+            cs_b  <= '1';
+            state <= IDLE;
+          end if;
+      end case;
+
+      -- Registers access
+      if reg_ready = '1'
+      then
+        if reg_we = '1' and reg_addr = REG_CMD
+        then
+          cmd_valid <= '1';
+          cmd       <= sbi_ini_i.wdata(cmd'range);
+          cmd_width <= cfg(5 downto 4);
+        end if;
+
+        if reg_we = '1' and reg_addr = REG_DATA
+        then
+          tx_valid  <= '1';
+          tx_data   <= sbi_ini_i.wdata(tx_data'range);
+        end if;
+
+        if reg_re = '1' and reg_addr = REG_DATA
+        then
+          rx_valid  <= '0';
+        end if;
+      end if;
+    end if;
+  end process p_engine;
+
+  -----------------------------------------------------------------------------
+  -- Outputs
+  -----------------------------------------------------------------------------
+  sclk_o   <= sclk;
+  cs_b_o   <= cs_b;
+
+  p_io: process (all) is
+  begin
+    -- Single : IO0 is MOSI, IO1 is MISO, WP# and HOLD# are inactive
+    io_o    <= "11" & '0' & shift_out(8-1);
+    io_oe_o <= "1101";
+
+    if cs_b = '0'
+    then
+      if state = IDLE or state = CS_END
+      then
+        -- CS asserted between two commands
+        io_oe_o <= "0000";
+      else
+        case cur_width is
+          when WIDTH_QUAD =>
+            io_o    <= shift_out(8-1 downto 4);
+            io_oe_o <= (others => cur_tx);
+          when WIDTH_DUAL =>
+            io_o    <= "11" & shift_out(8-1 downto 6);
+            io_oe_o <= "11" & cur_tx & cur_tx;
+          when others =>
+            null;
+        end case;
+      end if;
+    end if;
+  end process p_io;
+
+  -----------------------------------------------------------------------------
+  -- Registers
+  -----------------------------------------------------------------------------
+  reg_addr <= to_integer(unsigned(sbi_ini_i.addr(2-1 downto 0)));
+  reg_we   <= sbi_ini_i.cs and sbi_ini_i.we;
+  reg_re   <= sbi_ini_i.cs and sbi_ini_i.re;
+
+  -- Stall while the buffer is busy (CMD, TX) or empty (RX)
+  reg_ready <= '0' when reg_we = '1' and reg_addr = REG_CMD  and cmd_valid = '1' else
+               '0' when reg_we = '1' and reg_addr = REG_DATA and tx_valid  = '1' else
+               '0' when reg_re = '1' and reg_addr = REG_DATA and rx_valid  = '0' else
+               '1';
+
+  p_reg: process (clk_i, arst_b_i) is
+  begin
+    if arst_b_i = '0'
+    then
+      cfg       <= (others => '0');
+      prescaler <= unsigned(PRESCALER_RATIO);
+    elsif rising_edge(clk_i)
+    then
+      if reg_we = '1' and reg_addr = REG_CFG
+      then
+        cfg       <= sbi_ini_i.wdata(cfg'range);
+      end if;
+
+      if reg_we = '1' and reg_addr = REG_PRESCALER
+      then
+        prescaler <= unsigned(sbi_ini_i.wdata(prescaler'range));
+      end if;
+    end if;
+  end process p_reg;
+
+  p_rdata: process (all) is
+  begin
+    reg_rdata <= (others => '0');
+
+    case reg_addr is
+      when REG_DATA      => reg_rdata(rx_data'range) <= rx_data;
+      when REG_CMD       => reg_rdata(cmd'range)     <= cmd;
+      when REG_CFG       => reg_rdata(cfg'range)     <= cfg;
+      when others        => reg_rdata                <= std_logic_vector(prescaler);
+    end case;
+  end process p_rdata;
+
+  sbi_tgt_o.ready <= reg_ready;
+  sbi_tgt_o.rdata <= reg_rdata;
+
+end architecture rtl;
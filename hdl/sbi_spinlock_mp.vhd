@@ -0,0 +1,215 @@
+-------------------------------------------------------------------------------
+-- Title      : Spinlock with one port per CPU
+-- Project    :
+-------------------------------------------------------------------------------
+-- File       : sbi_spinlock_mp.vhd
+-- Author     : Mathieu Rosière
+-- Company    :
+-- Created    : 2026-10-17
+-- Standard   : VHDL'93/02
+-------------------------------------------------------------------------------
+-- Description: Spinlocks with one port per CPU (on ICN1) : a CPU spinning
+--              on a lock don't use the ICN2. Same registers as sbi_spinlock.
+--              Two modes :
+--              * "tas"    : test and set, the first read gets the lock
+--              * "ticket" : a read of a CPU that don't wait the lock takes
+--                a ticket. The lock is given in the order of the tickets :
+--                the next reads of the CPU return 0 only when its ticket is
+--                served. it_o(i) is set while the lock is given to the CPU
+--                i and not yet read : the CPU can wait the interruption
+--                instead of spinning.
+--
+-- Register Map (ADDR_WIDTH = 1)
+--   0 LOCK0    : Read  : 0 lock acquired, 1 lock not acquired (in "ticket"
+--                        mode, the CPU is in the queue)
+--                Write : 0 release the lock
+--   1 LOCK1    : Same for the lock 1
+-------------------------------------------------------------------------------
+-- Copyright (c) 2026
+-------------------------------------------------------------------------------
+-- Revisions  :
+-- Date        Version  Author   Description
+-- 2026-10-17  1.0      mrosiere Created
+-------------------------------------------------------------------------------
+library ieee;
+use     ieee.std_logic_1164.all;
+use     ieee.numeric_std.all;
+library asylum;
+use     asylum.sbi_pkg.all;
+
+entity sbi_spinlock_mp is
+  generic
+    (NB_PORT               : positive := 1
+    ;MODE                  : string   := "tas" -- "tas" / "ticket"
+    );
+  port
+    (clk_i                 : in  std_logic
+    ;arst_b_i              : in  std_logic
+
+    ;sbi_inis_i            : in  sbi_inis_t
+    ;sbi_tgts_o            : out sbi_tgts_t
+
+    ;it_o                  : out std_logic_vector(NB_PORT-1 downto 0) -- bit i : lock given to the port i
+    );
+end entity sbi_spinlock_mp;
+
+architecture rtl of sbi_spinlock_mp is
+
+  constant NB_LOCK              : positive := 2;
+
+  subtype  ticket_t      is unsigned(8-1 downto 0);
+  type     tickets_t     is array (0 to NB_PORT-1) of ticket_t;
+  type     lock_tickets_t is array (0 to NB_LOCK-1) of tickets_t;
+  type     counters_t    is array (0 to NB_LOCK-1) of ticket_t;
+  type     flags_t       is array (0 to NB_LOCK-1) of std_logic_vector(NB_PORT-1 downto 0);
+
+  -- "tas"
+  signal   locked_r             : std_logic_vector(NB_LOCK-1 downto 0);
+  signal   locked_n             : std_logic_vector(NB_LOCK-1 downto 0);
+
+  -- "ticket"
+  signal   next_r               : counters_t;      -- Next ticket
+  signal   next_n               : counters_t;
+  signal   serving_r            : counters_t;      -- Ticket of the owner
+  signal   serving_n            : counters_t;
+  signal   ticket_r             : lock_tickets_t;  -- Ticket of each port
+  signal   ticket_n             : lock_tickets_t;
+  signal   waiting_r            : flags_t;         -- The port has a ticket
+  signal   waiting_n            : flags_t;
+  signal   owner_r              : flags_t;         -- The port has the lock
+  signal   owner_n              : flags_t;
+
+  signal   busy                 : std_logic_vector(NB_PORT-1 downto 0);
+
+begin  -- architecture rtl
+
+  assert MODE = "tas" or MODE = "ticket" report "MODE must be tas or ticket" severity failure;
+
+  -----------------------------------------------------------------------------
+  -- Accesses of all ports in the same cycle : in the order of the ports
+  -----------------------------------------------------------------------------
+  p_next: process (all) is
+    variable locked_v  : std_logic_vector(NB_LOCK-1 downto 0);
+    variable next_v    : counters_t;
+    variable serving_v : counters_t;
+    variable ticket_v  : lock_tickets_t;
+    variable waiting_v : flags_t;
+    variable owner_v   : flags_t;
+    variable lock      : natural range 0 to NB_LOCK-1;
+  begin
+    locked_v  := locked_r;
+    next_v    := next_r;
+    serving_v := serving_r;
+    ticket_v  := ticket_r;
+    waiting_v := waiting_r;
+    owner_v   := owner_r;
+    busy      <= (others => '0');
+
+    for p in 0 to NB_PORT-1
+    loop
+      lock := to_integer(unsigned(sbi_inis_i(p).addr(1-1 downto 0)));
+
+      if sbi_inis_i(p).cs = '1' and sbi_inis_i(p).re = '1'
+      then
+        if MODE = "tas"
+        then
+          busy(p)        <= locked_v(lock);
+          locked_v(lock) := '1';
+
+        elsif owner_v(lock)(p) = '1'
+        then
+          busy(p)        <= '1';
+
+        elsif waiting_v(lock)(p) = '1'
+        then
+          if ticket_v(lock)(p) = serving_v(lock)
+          then
+            waiting_v(lock)(p) := '0';
+            owner_v  (lock)(p) := '1';
+          else
+            busy(p)            <= '1';
+          end if;
+
+        else
+          ticket_v(lock)(p) := next_v(lock);
+          next_v  (lock)    := next_v(lock)+1;
+
+          if ticket_v(lock)(p) = serving_v(lock)
+          then
+            owner_v  (lock)(p) := '1';
+          else
+            waiting_v(lock)(p) := '1';
+            busy(p)            <= '1';
+          end if;
+        end if;
+      end if;
+
+      if sbi_inis_i(p).cs = '1' and sbi_inis_i(p).we = '1' and sbi_inis_i(p).wdata(0) = '0'
+      then
+        if MODE = "tas"
+        then
+          locked_v(lock) := '0';
+
+        elsif owner_v(lock)(p) = '1'
+        then
+          owner_v  (lock)(p) := '0';
+          serving_v(lock)    := serving_v(lock)+1;
+        end if;
+      end if;
+    end loop;
+
+    locked_n  <= locked_v;
+    next_n    <= next_v;
+    serving_n <= serving_v;
+    ticket_n  <= ticket_v;
+    waiting_n <= waiting_v;
+    owner_n   <= owner_v;
+  end process p_next;
+
+  p_reg: process (clk_i, arst_b_i) is
+  begin
+    if arst_b_i = '0'
+    then
+      locked_r  <= (others => '0');
+      next_r    <= (others => (others => '0'));
+      serving_r <= (others => (others => '0'));
+      ticket_r  <= (others => (others => (others => '0')));
+      waiting_r <= (others => (others => '0'));
+      owner_r   <= (others => (others => '0'));
+    elsif rising_edge(clk_i)
+    then
+      locked_r  <= locked_n ;
+      next_r    <= next_n   ;
+      serving_r <= serving_n;
+      ticket_r  <= ticket_n ;
+      waiting_r <= waiting_n;
+      owner_r   <= owner_n  ;
+    end if;
+  end process p_reg;
+
+  -----------------------------------------------------------------------------
+  -- Ports
+  -----------------------------------------------------------------------------
+  gen_port: for p in 0 to NB_PORT-1
+  generate
+    sbi_tgts_o(p).ready <= '1';
+    sbi_tgts_o(p).rdata <= (0 => busy(p), others => '0');
+
+    p_it: process (all) is
+      variable it : std_logic;
+    begin
+      it := '0';
+
+      for l in 0 to NB_LOCK-1
+      loop
+        if waiting_r(l)(p) = '1' and ticket_r(l)(p) = serving_r(l)
+        then
+          it := '1';
+        end if;
+      end loop;
+
+      it_o(p) <= it;
+    end process p_it;
+  end generate gen_port;
+
+end architecture rtl;
@@ -0,0 +1,151 @@
+-------------------------------------------------------------------------------
+-- Title      : Crossbar of N masters to M targets
+-- Project    :
+-------------------------------------------------------------------------------
+-- File       : sbi_xbar.vhd
+-- Author     : Mathieu Rosière
+-- Company    :
+-- Created    : 2026-10-17
+-- Standard   : VHDL'93/02
+-------------------------------------------------------------------------------
+-- Description: Same decoding as sbi_icn ("binary" encoding) : the target t
+--              is selected when the address and TARGET_ID(t) are equal
+--              except the TARGET_ADDR_WIDTH(t) LSB, the lowest target has
+--              the priority.
+--              Each target has its own arbiter (sbi_arbiter, MASTER_SEL) :
+--              masters accessing distinct targets are not waiting each other.
+--              An address without target is answered by an internal default
+--              slave (ready = 1, rdata = 0).
+-------------------------------------------------------------------------------
+-- Copyright (c) 2026
+-------------------------------------------------------------------------------
+-- Revisions  :
+-- Date        Version  Author   Description
+-- 2026-10-17  1.0      mrosiere Created
+-------------------------------------------------------------------------------
+library ieee;
+use     ieee.std_logic_1164.all;
+use     ieee.numeric_std.all;
+library asylum;
+use     asylum.sbi_pkg.all;
+use     asylum.logic_pkg.all;
+use     asylum.math_pkg.all;
+
+entity sbi_xbar is
+  generic
+    (NB_MASTER             : positive := 2
+    ;MASTER_SEL            : string   := "rr"          -- "fix" / "rr" / "wrr"
+    ;MASTER_WEIGHT         : integer_vector := (0 => 1) -- "wrr" : accesses per turn of each master
+    ;NB_TARGET             : positive := 1
+    ;TARGET_ID             : sbi_addrs_t
+    ;TARGET_ADDR_WIDTH     : naturals_t
+    );
+  port
+    (clk_i                 : in  std_logic
+    ;arst_b_i              : in  std_logic
+
+    -- From the masters
+    ;sbi_inis_i            : in  sbi_inis_t
+    ;sbi_tgts_o            : out sbi_tgts_t
+
+    -- To the targets
+    ;sbi_inis_o            : out sbi_inis_t
+    ;sbi_tgts_i            : in  sbi_tgts_t
+    );
+end entity sbi_xbar;
+
+architecture rtl of sbi_xbar is
+
+  constant ADDR_WIDTH           : positive := sbi_inis_i(sbi_inis_i'low).addr 'length;
+  constant WDATA_WIDTH          : positive := sbi_inis_i(sbi_inis_i'low).wdata'length;
+  constant RDATA_WIDTH          : positive := sbi_tgts_i(sbi_tgts_i'low).rdata'length;
+
+  constant TARGET_NONE          : natural  := NB_TARGET; -- Default slave
+
+  type     targets_t     is array (0 to NB_MASTER-1) of natural range 0 to TARGET_NONE;
+
+  -- Target of an address
+  function decode (addr : std_logic_vector) return natural is
+    variable t : natural range 0 to TARGET_NONE;
+  begin
+    t := TARGET_NONE;
+
+    for i in NB_TARGET-1 downto 0
+    loop
+      if addr(ADDR_WIDTH-1 downto TARGET_ADDR_WIDTH(i)) = TARGET_ID(i)(ADDR_WIDTH-1 downto TARGET_ADDR_WIDTH(i))
+      then
+        t := i;
+      end if;
+    end loop;
+
+    return t;
+  end function decode;
+
+  signal   target               : targets_t;
+
+  -- Response of the target t to the master m : index t*NB_MASTER+m
+  signal   xbar_tgts            : sbi_tgts_t(NB_TARGET*NB_MASTER-1 downto 0)(rdata(RDATA_WIDTH-1 downto 0));
+
+begin  -- architecture rtl
+
+  -----------------------------------------------------------------------------
+  -- Decoding
+  -----------------------------------------------------------------------------
+  gen_decode: for m in 0 to NB_MASTER-1
+  generate
+    target(m) <= decode(sbi_inis_i(m).addr);
+
+    sbi_tgts_o(m).ready <= '1'             when target(m) = TARGET_NONE else
+                           xbar_tgts(target(m)*NB_MASTER+m).ready;
+    sbi_tgts_o(m).rdata <= (others => '0') when target(m) = TARGET_NONE else
+                           xbar_tgts(target(m)*NB_MASTER+m).rdata;
+  end generate gen_decode;
+
+  -----------------------------------------------------------------------------
+  -- Arbiter of each target
+  -----------------------------------------------------------------------------
+  gen_target: for t in 0 to NB_TARGET-1
+  generate
+    signal   arb_inis           : sbi_inis_t(NB_MASTER-1 downto 0)(addr (ADDR_WIDTH -1 downto 0),
+                                                                   wdata(WDATA_WIDTH-1 downto 0));
+    signal   arb_tgts           : sbi_tgts_t(NB_MASTER-1 downto 0)(rdata(RDATA_WIDTH-1 downto 0));
+  begin
+
+    gen_master: for m in 0 to NB_MASTER-1
+    generate
+      -- Only the masters accessing this target
+      p_req: process (all) is
+        variable ini : sbi_ini_t(addr (ADDR_WIDTH -1 downto 0),
+                                 wdata(WDATA_WIDTH-1 downto 0));
+      begin
+        ini := sbi_inis_i(m);
+
+        if target(m) /= t
+        then
+          ini.cs := '0';
+        end if;
+
+        arb_inis(m) <= ini;
+      end process p_req;
+
+      xbar_tgts(t*NB_MASTER+m) <= arb_tgts(m);
+    end generate gen_master;
+
+    ins_sbi_arbiter : entity asylum.sbi_arbiter(rtl)
+      generic map
+      (NB_MASTER              => NB_MASTER
+      ,ALGO                   => MASTER_SEL
+      ,WEIGHT                 => MASTER_WEIGHT
+      )
+      port map
+      (clk_i                  => clk_i
+      ,arst_b_i               => arst_b_i
+      ,sbi_inis_i             => arb_inis
+      ,sbi_tgts_o             => arb_tgts
+      ,sbi_ini_o              => sbi_inis_o(t)
+      ,sbi_tgt_i              => sbi_tgts_i(t)
+      );
+
+  end generate gen_target;
+
+end architecture rtl;
@@ -6,7 +6,7 @@
 -- Author     : Mathieu Rosiere
 -- Company    : 
 -- Created    : 2017-03-30
--- Last update: 2026-01-10
+-- Last update: 2026-10-17
 -- Platform   : 
 -- Standard   : VHDL'93/02
 -------------------------------------------------------------------------------
@@ -18,6 +18,8 @@
 -- Date        Version  Author  Description
 -- 2017-03-30  1.0      mrosiere Created
 -- 2025-01-11  1.1      mrosiere Add fault test
+-- 2026-10-17  1.2      mrosiere Add Generic USER_SPI_QUAD, USER_IMEM_RAM
+-- 2026-10-17  1.3      mrosiere debug_mux_i on 4 bits
 -------------------------------------------------------------------------------
 
 library ieee;
@@ -49,6 +51,8 @@ entity tb_PicoSoC is
   --;USER_FAULT_POLARITY   : string   := "low"       -- "high" / "low"
     ;DEBUG_ENABLE          : boolean  := True 
     ;CPU_MODEL             : string   := ""          -- "OpenBlaze8" / "WardRV_fsm"
+    ;USER_SPI_QUAD         : boolean  := False
+    ;USER_IMEM_RAM         : boolean  := False
 
     -- TB Parameters
     ;TB_WATCHDOG           : natural  := 10_000
@@ -154,6 +158,8 @@ begin  -- architecture tb
     ,USER_IT_POLARITY      => USER_IT_POLARITY
     ,USER_FAULT_POLARITY   => USER_FAULT_POLARITY  
     ,CPU_MODEL             => CPU_MODEL
+    ,USER_SPI_QUAD         => USER_SPI_QUAD
+    ,USER_IMEM_RAM         => USER_IMEM_RAM
      )  
     port map
     (clk_i            => clk_i           
@@ -172,7 +178,7 @@ begin  -- architecture tb
     ,spi_cs_b_o       => spi_cs_b_o 
     ,spi_mosi_o       => spi_mosi_o 
     ,spi_miso_i       => spi_miso_i
-    ,debug_mux_i      => "000"
+    ,debug_mux_i      => "0000"
     ,debug_o          => open 
     ,debug_uart_tx_o  => open
     );
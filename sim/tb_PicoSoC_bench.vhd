@@ -0,0 +1,275 @@
+-------------------------------------------------------------------------------
+-- Title      : tb_PicoSoC_bench
+-- Project    : 
+-------------------------------------------------------------------------------
+-- File       : tb_PicoSoC_bench.vhd
+-- Author     : Mathieu Rosiere
+-- Company    : 
+-- Created    : 2026-10-17
+-- Last update: 2026-10-17
+-- Platform   : 
+-- Standard   : VHDL'93/02
+-------------------------------------------------------------------------------
+-- Description: Run a benchmark firmware (see esw/include/bench.h)
+--              * LED0 /= 0    : section LED0 is running
+--              * LED0 =  0xFF : end of benchmark, LED1 is the number of errors
+--              Report the number of cycles (FSYS_INT) of each section
+--              and with the instruction cache, its hits and misses (CPU 0)
+-------------------------------------------------------------------------------
+-- Copyright (c) 2026
+-------------------------------------------------------------------------------
+-- Revisions  :
+-- Date        Version  Author  Description
+-- 2026-10-17  1.0      mrosiere Created
+-- 2026-10-17  1.1      mrosiere Add Generic USER_RAM_SYNC_READ
+-- 2026-10-17  1.2      mrosiere Add Generic USER_ICACHE_NB_LINE, USER_ICACHE_LINE_SIZE
+-- 2026-10-17  1.3      mrosiere Add Generic USER_RAM1_DEPTH, USER_RAM2_DEPTH
+-- 2026-10-17  1.4      mrosiere Remove Generic USER_RAM_SYNC_READ
+-- 2026-10-17  1.5      mrosiere debug_mux_i on 4 bits
+-------------------------------------------------------------------------------
+
+library ieee;
+use     ieee.std_logic_1164.all;
+use     ieee.numeric_std.all;
+use     std.textio.all;
+library asylum;
+use     asylum.PicoSoC_pkg.all;
+library work;
+  
+entity tb_PicoSoC_bench is
+  generic
+    (FSYS                  : positive := 50_000_000
+    ;FSYS_INT              : positive := 50_000_000
+    ;USER_NB_CPU           : positive  := 1
+    ;USER_BAUD_RATE        : integer  := 115200
+    ;SUPERVISOR            : boolean  := False
+    ;USER_SAFETY           : string   := "none"      -- "none" / "lock-step" / "tmr"
+    ;USER_FAULT_INJECTION  : boolean  := False
+    ;USER_RAM1_DEPTH       : natural  := 128
+    ;USER_RAM2_DEPTH       : natural  := 64
+    ;USER_ICACHE_NB_LINE   : natural  := 0
+    ;USER_ICACHE_LINE_SIZE : positive := 4
+    ;DEBUG_ENABLE          : boolean  := False
+    ;CPU_MODEL             : string   := ""          -- "OpenBlaze8" / "WardRV_fsm"
+
+    -- TB Parameters
+    ;TB_WATCHDOG           : natural  := 10_000
+     );
+  
+end entity tb_PicoSoC_bench;
+
+architecture tb of tb_PicoSoC_bench is
+  -- =====[ Parameters ]==========================
+  constant TB_PERIOD               : time    := (1e9 / FSYS    ) * 1 ns;
+  constant TB_PERIOD_INT           : time    := (1e9 / FSYS_INT) * 1 ns;
+  constant TB_WATCHDOG_TIME        : time    := TB_WATCHDOG * TB_PERIOD;
+
+  constant USER_NB_SWITCH          : positive :=  8;
+  constant USER_NB_LED0            : positive :=  8;
+  constant USER_NB_LED1            : positive :=  8;
+
+  constant RESET_POLARITY          : string   := "low";  -- "high" / "low"
+  constant USER_IT_POLARITY        : string   := "high"; -- "high" / "low"
+  constant USER_FAULT_POLARITY     : string   := "high"; -- "high" / "low"
+
+  constant BENCH_ID_NONE           : std_logic_vector(USER_NB_LED0-1 downto 0) := (others => '0');
+  constant BENCH_ID_EXIT           : std_logic_vector(USER_NB_LED0-1 downto 0) := (others => '1');
+  
+  -- =====[ Dut Signals ]=========================
+  signal  clk_i                    : std_logic := '0';
+  signal  arst_b_i                 : std_logic;
+  signal  switch_i                 : std_logic_vector(USER_NB_SWITCH-1 downto 0) := (others => '0');
+  signal  led0_o                   : std_logic_vector(USER_NB_LED0  -1 downto 0);
+  signal  led1_o                   : std_logic_vector(USER_NB_LED1  -1 downto 0);
+  signal  led_diff_o               : std_logic_vector(             3-1 downto 0);
+  signal  it_user_i                : std_logic;
+  signal  inject_error_i           : std_logic_vector(             3-1 downto 0);
+
+  alias   bench_id                 : std_logic_vector(USER_NB_LED0  -1 downto 0) is led0_o;
+  alias   bench_errors             : std_logic_vector(USER_NB_LED1  -1 downto 0) is led1_o;
+
+  -- =====[ Test Signals ]========================
+  signal  test_begin               : std_logic := '0';
+  signal  test_done                : std_logic := '0';
+  
+  -- =====[ Functions ]===========================
+  
+  -------------------------------------------------------
+  -- xrun
+  -------------------------------------------------------
+  procedure xrun
+    (constant n     : in positive;           -- nb cycle
+     constant pol   : in string;
+     signal   clk   : in std_logic
+     ) is
+    
+  begin
+    for i in 0 to n-1
+    loop
+      if (pol="pos")
+      then
+        wait until rising_edge(clk);
+      else
+        wait until falling_edge(clk);
+      end if;
+      
+    end loop;  -- i
+  end xrun;
+
+  -------------------------------------------------------
+  -- run
+  -------------------------------------------------------
+  procedure run
+    (constant n     : in positive;          -- nb cycle
+     constant pol   : in string := "pos"
+     ) is
+    
+  begin
+    xrun(n,"pos",clk_i);
+  end run;
+
+begin  -- architecture tb
+
+  -----------------------------------------------------
+  -- Design Under Test
+  -----------------------------------------------------
+  dut : PicoSoC_top
+    generic map
+    (FSYS                  => FSYS            
+    ,FSYS_INT              => FSYS_INT        
+    ,USER_NB_CPU           => USER_NB_CPU
+    ,USER_BAUD_RATE        => USER_BAUD_RATE
+    ,USER_NB_SWITCH        => USER_NB_SWITCH       
+    ,USER_NB_LED0          => USER_NB_LED0        
+    ,USER_NB_LED1          => USER_NB_LED1        
+    ,RESET_POLARITY        => RESET_POLARITY  
+    ,SUPERVISOR            => SUPERVISOR      
+    ,USER_SAFETY           => USER_SAFETY          
+    ,USER_FAULT_INJECTION  => USER_FAULT_INJECTION 
+    ,USER_IT_POLARITY      => USER_IT_POLARITY
+    ,USER_FAULT_POLARITY   => USER_FAULT_POLARITY  
+    ,USER_RAM1_DEPTH       => USER_RAM1_DEPTH
+    ,USER_RAM2_DEPTH       => USER_RAM2_DEPTH
+    ,USER_ICACHE_NB_LINE   => USER_ICACHE_NB_LINE
+    ,USER_ICACHE_LINE_SIZE => USER_ICACHE_LINE_SIZE
+    ,CPU_MODEL             => CPU_MODEL
+     )  
+    port map
+    (clk_i            => clk_i           
+    ,arst_i           => arst_b_i        
+    ,switch_i         => switch_i        
+    ,led0_o           => led0_o
+    ,led1_o           => led1_o
+    ,led_diff_o       => led_diff_o
+    ,it_user_i        => it_user_i     
+    ,inject_error_i   => inject_error_i
+    ,uart_tx_o        => open
+    ,uart_rx_i        => '1'
+    ,uart_cts_b_i     => '0'
+    ,uart_rts_b_o     => open
+    ,spi_sclk_o       => open
+    ,spi_cs_b_o       => open
+    ,spi_mosi_o       => open
+    ,spi_miso_i       => '0'
+    ,debug_mux_i      => "0000"
+    ,debug_o          => open 
+    ,debug_uart_tx_o  => open
+    );
+
+  -----------------------------------------------------
+  -- Clock Tree
+  -----------------------------------------------------
+  clk_i <= not test_done and not clk_i after TB_PERIOD/2;
+
+  -----------------------------------------------------------------------------
+  -- Watchdog
+  -----------------------------------------------------------------------------
+  p_watchdog: process is
+  begin
+    while (test_begin = '0')
+    loop
+      run(1);
+    end loop;
+
+    wait until test_done = '1' for TB_WATCHDOG_TIME;
+
+    assert (test_done = '1') report "[TESTBENCH] Test KO : Maximum cycle is reached" severity failure;
+
+    -- end of process
+    wait;
+  end process;
+  
+  -----------------------------------------------------------------------------
+  -- Bench Monitor
+  -----------------------------------------------------------------------------
+  p_bench: process is
+    -- Counters of the instruction cache (debug of PicoSoC_user)
+    alias    debug_user  is << signal .tb_PicoSoC_bench.dut.debug_user : PicoSoC_user_debug_t >>;
+
+    variable id          : std_logic_vector(USER_NB_LED0-1 downto 0);
+    variable time_begin  : time;
+    variable nb_cycle    : natural;
+    variable hit_begin   : unsigned(16-1 downto 0);
+    variable miss_begin  : unsigned(16-1 downto 0);
+  begin
+    id := BENCH_ID_NONE;
+
+    wait until test_begin = '1';
+
+    loop
+      wait on bench_id;
+
+      exit when bench_id = BENCH_ID_EXIT;
+      
+      if (bench_id /= BENCH_ID_NONE)
+      then
+        id         := bench_id;
+        time_begin := now;
+        hit_begin  := unsigned(debug_user.icache_hit );
+        miss_begin := unsigned(debug_user.icache_miss);
+      elsif (id /= BENCH_ID_NONE)
+      then
+        nb_cycle   := (now - time_begin) / TB_PERIOD_INT;
+        report "[TESTBENCH] Bench 0x" & to_hstring(id) & " : " & integer'image(nb_cycle) & " cycles";
+        if USER_ICACHE_NB_LINE > 0
+        then
+          report "[TESTBENCH] Bench 0x" & to_hstring(id) & " : " &
+            integer'image(to_integer(unsigned(debug_user.icache_hit ) - hit_begin )) & " icache hits, " &
+            integer'image(to_integer(unsigned(debug_user.icache_miss) - miss_begin)) & " icache misses";
+        end if;
+        id         := BENCH_ID_NONE;
+      end if;
+    end loop;
+
+    assert (unsigned(bench_errors) = 0) report "[TESTBENCH] Test KO : " & integer'image(to_integer(unsigned(bench_errors))) & " error(s)" severity error;
+
+    report "[TESTBENCH] Test Done";
+    test_done <= '1';
+
+    -- end of process
+    wait;
+  end process;
+
+  -----------------------------------------------------
+  -- Test suite
+  -----------------------------------------------------
+  process is
+  begin  -- process
+
+      run(10);
+
+      report "[TESTBENCH] Init signals";
+      it_user_i      <= '0';             -- active low
+      inject_error_i <= (others => '0'); -- active low
+
+      report "[TESTBENCH] Reset Sequence"; 
+      arst_b_i       <= '0';
+
+      run(1);
+
+      test_begin     <= '1';
+      arst_b_i       <= '1';
+      wait;
+  end process;
+
+end architecture tb;
@@ -6,7 +6,7 @@
 -- Author     : Mathieu Rosiere
 -- Company    : 
 -- Created    : 2025-10-23
--- Last update: 2026-05-24
+-- Last update: 2026-10-17
 -- Platform   : 
 -- Standard   : VHDL'93/02
 -------------------------------------------------------------------------------
@@ -17,6 +17,9 @@
 -- Revisions  :
 -- Date        Version  Author  Description
 -- 2025-10-23  1.0      mrosiere Created
+-- 2026-10-17  1.1      mrosiere Add Write Multiple and Read/Write Multiple Registers
+-- 2026-10-17  1.2      mrosiere Add Generic USER_MODBUS_RTU, test case with bad frames
+-- 2026-10-17  1.3      mrosiere debug_mux_i on 4 bits
 -------------------------------------------------------------------------------
 
 library ieee;
@@ -40,6 +43,7 @@ entity tb_PicoSoC_modbus_rtu is
     ;USER_BAUD_RATE        : integer  := 115200
     ;USER_UART_DEPTH_TX    : natural  := 8
     ;USER_UART_DEPTH_RX    : natural  := 8
+    ;USER_MODBUS_RTU       : boolean  := False
   --;USER_SPI_DEPTH_CMD    : natural  := 0
   --;USER_SPI_DEPTH_TX     : natural  := 0
   --;USER_SPI_DEPTH_RX     : natural  := 0
@@ -68,6 +72,7 @@ architecture tb of tb_PicoSoC_modbus_rtu is
   constant TEST_CASE_BASIC         : boolean   := true;
   constant TEST_CASE_FAULT         : boolean   := USER_FAULT_INJECTION;
   constant TEST_CASE_SEQUENCE      : boolean   := true;
+  constant TEST_CASE_BAD_FRAME     : boolean   := true;
 
   -- =====[ Parameters ]==========================
   constant TB_PERIOD               : time    := (1e9 / FSYS) * 1 ns;
@@ -132,6 +137,8 @@ architecture tb of tb_PicoSoC_modbus_rtu is
   constant C_MODBUS_SLAVE_ID       : std_logic_vector(8-1 downto 0) := x"5A";
   constant C_MODBUS_READ           : std_logic_vector(8-1 downto 0) := x"03";
   constant C_MODBUS_WRITE          : std_logic_vector(8-1 downto 0) := x"06";
+  constant C_MODBUS_WRITE_MULTIPLE : std_logic_vector(8-1 downto 0) := x"10";
+  constant C_MODBUS_READ_WRITE     : std_logic_vector(8-1 downto 0) := x"17";
 
   -- =====[ SOC ADDRMAP ]=========================
   constant C_SWITCH_BA             : std_logic_vector(8-1 downto 0) := PICOSOC_USER_SWITCH_BA;
@@ -142,6 +149,12 @@ architecture tb of tb_PicoSoC_modbus_rtu is
   constant C_GIC_BA                : std_logic_vector(8-1 downto 0) := PICOSOC_USER_GIC_BA   ;
   constant C_TIMER_BA              : std_logic_vector(8-1 downto 0) := PICOSOC_USER_TIMER_BA ;
   constant C_CRC_BA                : std_logic_vector(8-1 downto 0) := PICOSOC_USER_CRC_BA   ;
+  constant C_MODBUS_RTU_BA         : std_logic_vector(8-1 downto 0) := PICOSOC_USER_MODBUS_RTU_BA;
+
+  -- =====[ MODBUS RTU ACCELERATOR ]==============
+  constant C_MODBUS_RTU_CNT_DROP   : std_logic_vector(8-1 downto 0) := std_logic_vector(unsigned(C_MODBUS_RTU_BA)+6);
+  constant C_MODBUS_RTU_CNT_CRC    : std_logic_vector(8-1 downto 0) := std_logic_vector(unsigned(C_MODBUS_RTU_BA)+7);
+  constant C_MODBUS_RTU_DEPTH      : positive := 32; -- Default MODBUS_RTU_DEPTH
 
   -- =====[ Function ]============================
   -- Fonction CRC16 (Modbus, polynôme 0xA001)
@@ -192,6 +205,7 @@ begin  -- architecture tb
     ,USER_FAULT_POLARITY   => USER_FAULT_POLARITY  
     ,USER_UART_DEPTH_TX    => USER_UART_DEPTH_TX
     ,USER_UART_DEPTH_RX    => USER_UART_DEPTH_RX
+    ,USER_MODBUS_RTU       => USER_MODBUS_RTU
     ,CPU_MODEL             => CPU_MODEL
      )  
     port map
@@ -211,7 +225,7 @@ begin  -- architecture tb
     ,spi_cs_b_o       => open
     ,spi_mosi_o       => open
     ,spi_miso_i       => '0'
-    ,debug_mux_i      => "000"
+    ,debug_mux_i      => "0000"
     ,debug_o          => open 
     ,debug_uart_tx_o  => open
     );
@@ -357,6 +371,107 @@ begin  -- architecture tb
       modbus_rx_end("MODBUS RX CRC");
     end procedure;      
 
+    procedure modbus_write_multiple(
+      constant addr       : in std_logic_vector;
+      constant data_array : in t_data_array;
+      constant msg        : in string
+      ) is
+
+      variable len : natural := data_array'length;
+    begin
+      modbus_tx_begin(msg);    
+      modbus_tx      (C_MODBUS_SLAVE_ID,       "MODBUS TX Slave ID");
+      modbus_tx      (C_MODBUS_WRITE_MULTIPLE, "MODBUS TX Write Multiple");
+      modbus_tx      (x"00",                   "MODBUS TX Addr MSB (Ignored)");
+      modbus_tx      (addr,                    "MODBUS TX Addr LSB");
+      modbus_tx      (x"00",                   "MODBUS TX Len MSB (Ignored)");
+      modbus_tx      (std_logic_vector(to_unsigned(len    , 8)), "MODBUS TX Len LSB");
+      modbus_tx      (std_logic_vector(to_unsigned(len * 2, 8)), "MODBUS TX Byte Count");
+
+      for i in 0 to len - 1 loop
+        modbus_tx(x"00",          "MODBUS TX Data MSB (Ignored)");
+        modbus_tx(data_array(i),  "MODBUS TX Data LSB");
+      end loop;
+
+      modbus_tx_end  ("MODBUS TX CRC");
+
+      modbus_rx_begin(msg);    
+      modbus_rx      (C_MODBUS_SLAVE_ID,       "MODBUS RX Slave ID");
+      modbus_rx      (C_MODBUS_WRITE_MULTIPLE, "MODBUS RX Write Multiple");
+      modbus_rx      (x"00",                   "MODBUS RX Addr MSB (Ignored)");
+      modbus_rx      (addr,                    "MODBUS RX Addr LSB");
+      modbus_rx      (x"00",                   "MODBUS RX Len MSB (Ignored)");
+      modbus_rx      (std_logic_vector(to_unsigned(len    , 8)), "MODBUS RX Len LSB");
+      modbus_rx_end  ("MODBUS RX CRC");
+    end procedure;      
+
+    procedure modbus_read_write(
+      constant read_addr        : in std_logic_vector;
+      constant read_data_array  : in t_data_array;
+      constant write_addr       : in std_logic_vector;
+      constant write_data_array : in t_data_array;
+      constant msg              : in string
+      ) is
+
+      variable read_len  : natural := read_data_array'length;
+      variable write_len : natural := write_data_array'length;
+    begin
+      modbus_tx_begin(msg);    
+      modbus_tx      (C_MODBUS_SLAVE_ID,   "MODBUS TX Slave ID");
+      modbus_tx      (C_MODBUS_READ_WRITE, "MODBUS TX Read/Write");
+      modbus_tx      (x"00",               "MODBUS TX Read Addr MSB (Ignored)");
+      modbus_tx      (read_addr,           "MODBUS TX Read Addr LSB");
+      modbus_tx      (x"00",               "MODBUS TX Read Len MSB (Ignored)");
+      modbus_tx      (std_logic_vector(to_unsigned(read_len     , 8)), "MODBUS TX Read Len LSB");
+      modbus_tx      (x"00",               "MODBUS TX Write Addr MSB (Ignored)");
+      modbus_tx      (write_addr,          "MODBUS TX Write Addr LSB");
+      modbus_tx      (x"00",               "MODBUS TX Write Len MSB (Ignored)");
+      modbus_tx      (std_logic_vector(to_unsigned(write_len    , 8)), "MODBUS TX Write Len LSB");
+      modbus_tx      (std_logic_vector(to_unsigned(write_len * 2, 8)), "MODBUS TX Byte Count");
+
+      for i in 0 to write_len - 1 loop
+        modbus_tx(x"00",                "MODBUS TX Data MSB (Ignored)");
+        modbus_tx(write_data_array(i),  "MODBUS TX Data LSB");
+      end loop;
+
+      modbus_tx_end  ("MODBUS TX CRC");
+
+      modbus_rx_begin(msg);    
+      modbus_rx      (C_MODBUS_SLAVE_ID,   "MODBUS RX Slave ID");
+      modbus_rx      (C_MODBUS_READ_WRITE, "MODBUS RX Read/Write");
+      modbus_rx      (std_logic_vector(to_unsigned(read_len * 2, 8)), "MODBUS RX Byte Count");
+
+      for i in 0 to read_len - 1 loop
+        modbus_rx(x"00",               "MODBUS RX Data MSB (Ignored)");
+        modbus_rx(read_data_array(i),  "MODBUS RX Data LSB");
+      end loop;
+
+      modbus_rx_end("MODBUS RX CRC");
+    end procedure;      
+
+    -- Send a frame without response
+    -- crc_error : the CRC is inverted
+    procedure modbus_bad_frame(
+      constant frame      : in t_data_array;
+      constant crc_error  : in boolean;
+      constant msg        : in string
+      ) is
+    begin
+      modbus_tx_begin(msg);    
+      for i in frame'range loop
+        modbus_tx(frame(i), "MODBUS TX Byte " & integer'image(i));
+      end loop;
+
+      if crc_error
+      then
+        modbus_crc := not modbus_crc;
+      end if;
+      modbus_tx_end  ("MODBUS TX CRC");
+
+      -- No response expected
+      wait for 200 us;
+    end procedure;      
+
     procedure set_inputs_passive(
       dummy   : t_void) is
     begin
@@ -442,6 +557,24 @@ begin  -- architecture tb
 
       wait for 35 us;
       modbus_read (C_LED0_BA  ,(0 => x"15"), "Read  LED0 Data");
+
+      -- Write LED0 Data & OE in one request
+      wait for 35 us;
+      modbus_write_multiple(C_LED0_BA,(0 => x"96",
+                                       1 => x"FF"), "Write LED0 Data & OE <= 0x96 0xFF");
+      await_value (led_switch, x"96", 0 ns, C_CLK_PERIOD, ERROR, "LED0 <= 0x96", C_SCOPE);
+
+      -- Write LED0 and read SWITCH in one request
+      wait for 35 us;
+      switch_i <= x"C3";
+      modbus_read_write(C_SWITCH_BA,(0 => x"C3"),
+                        C_LED0_BA  ,(0 => x"69"), "Read SWITCH Data, Write LED0 Data <= 0x69");
+      await_value (led_switch, x"69", 0 ns, C_CLK_PERIOD, ERROR, "LED0 <= 0x69", C_SCOPE);
+
+      -- The write is done before the read
+      wait for 35 us;
+      modbus_read_write(C_LED0_BA  ,(0 => x"5A"),
+                        C_LED0_BA  ,(0 => x"5A"), "Write LED0 Data <= 0x5A, Read LED0 Data");
     end if;
       
     -- Check ERROR
@@ -577,12 +710,64 @@ begin  -- architecture tb
     
     -- Checks modbus error
     -- 1) bad slave id
-    -- 2) bad function code
-    -- 3) write addr msb
-    -- 4) write data msb
-    -- 5) read addr msb
-    -- 6) read data msb
-    -- 7) bad crc
+    -- 2) bad crc
+    -- 3) frame too long for the accelerator buffer (USER_MODBUS_RTU)
+    if TEST_CASE_BAD_FRAME
+    then
+      log(ID_LOG_HDR, "Bad frames", C_SCOPE);
+
+      -- Clear the accelerator counters
+      if USER_MODBUS_RTU
+      then
+        wait for 35 us;
+        modbus_write(C_MODBUS_RTU_CNT_DROP,x"00", "Clear Modbus RTU CNT_DROP");
+        wait for 35 us;
+        modbus_write(C_MODBUS_RTU_CNT_CRC ,x"00", "Clear Modbus RTU CNT_CRC");
+      end if;
+
+      wait for 35 us;
+      modbus_write(C_LED0_BA  ,x"A5",        "Write LED0 Data <= 0xA5");
+      await_value (led_switch, x"A5", 0 ns, C_CLK_PERIOD, ERROR, "LED0 <= 0xA5", C_SCOPE);
+
+      -- Bad slave id : frame ignored by the address filter
+      wait for 35 us;
+      modbus_write(C_LED0_BA  ,x"C3",        "Write LED0 Data <= 0xC3, with another ID"
+                   ,id => x"A5"
+                   );
+      await_value (led_switch, x"A5", 0 ns, C_CLK_PERIOD, ERROR, "LED0 <= 0xA5", C_SCOPE);
+
+      -- Bad CRC : frame without response and LED0 unchanged
+      wait for 35 us;
+      modbus_bad_frame((C_MODBUS_SLAVE_ID,
+                        C_MODBUS_WRITE,
+                        x"00", C_LED0_BA,
+                        x"00", x"C3"),
+                       true, "Write LED0 Data <= 0xC3, with bad CRC");
+      await_value (led_switch, x"A5", 0 ns, C_CLK_PERIOD, ERROR, "LED0 <= 0xA5", C_SCOPE);
+
+      if USER_MODBUS_RTU
+      then
+        -- Write Multiple longer than the accelerator buffer : frame dropped
+        wait for 35 us;
+        modbus_bad_frame((C_MODBUS_SLAVE_ID,
+                          C_MODBUS_WRITE_MULTIPLE,
+                          x"00", C_LED0_BA,
+                          x"00", std_logic_vector(to_unsigned(C_MODBUS_RTU_DEPTH/2    , 8)),
+                                 std_logic_vector(to_unsigned(C_MODBUS_RTU_DEPTH/2 * 2, 8)))
+                         & t_data_array'(0 to C_MODBUS_RTU_DEPTH-1 => x"00"),
+                         false, "Write Multiple LED0 Data <= 0x00, longer than the buffer");
+        await_value (led_switch, x"A5", 0 ns, C_CLK_PERIOD, ERROR, "LED0 <= 0xA5", C_SCOPE);
+
+        -- One dropped frame, one bad CRC, the frame with another ID is not counted
+        wait for 35 us;
+        modbus_read (C_MODBUS_RTU_CNT_DROP,(0 => x"01",
+                                            1 => x"01"), "Read  Modbus RTU CNT_DROP & CNT_CRC");
+      end if;
+
+      -- The server still answers
+      wait for 35 us;
+      modbus_read (C_LED0_BA  ,(0 => x"A5"), "Read  LED0 Data");
+    end if;
         
     --==================================================================================================
     -- Ending the simulation
@@ -6,11 +6,13 @@
 -- Author     : Mathieu Rosiere
 -- Company    : 
 -- Created    : 2017-03-30
--- Last update: 2026-01-10
+-- Last update: 2026-10-17
 -- Platform   : 
 -- Standard   : VHDL'93/02
 -------------------------------------------------------------------------------
--- Description: 
+-- Description: Run the firmware until TB_WATCHDOG
+--              With TB_LED1_END >= 0, LED1 must be TB_LED1_END at the end
+--              (the first cycle with LED1 = TB_LED1_END is reported)
 -------------------------------------------------------------------------------
 -- Copyright (c) 2017 
 -------------------------------------------------------------------------------
@@ -18,6 +20,21 @@
 -- Date        Version  Author  Description
 -- 2017-03-30  1.0      mrosiere Created
 -- 2025-01-11  1.1      mrosiere Add fault test
+-- 2026-10-17  1.2      mrosiere Add Generic USER_SPINLOCK_MODE
+-- 2026-10-17  1.3      mrosiere Add Generic USER_BARRIER_HOLD
+-- 2026-10-17  1.4      mrosiere Add Generic USER_ICN_MASTER_SEL and USER_ICN_DMA_WEIGHT
+-- 2026-10-17  1.5      mrosiere Add Generic USER_ICN_XBAR
+-- 2026-10-17  1.6      mrosiere Add Generic USER_ICN_PIPE
+-- 2026-10-17  1.7      mrosiere Add Generic USER_RAM2_NB_BANK
+-- 2026-10-17  1.8      mrosiere Add Generic USER_RAM_SYNC_READ
+-- 2026-10-17  1.9      mrosiere Add Generic USER_ICACHE_NB_LINE, USER_ICACHE_LINE_SIZE
+-- 2026-10-17  1.10     mrosiere Add Generic USER_IMEM_SHARED
+-- 2026-10-17  1.11     mrosiere Add Generic USER_CLUSTER_NB_CPU
+-- 2026-10-17  1.12     mrosiere Add Generic USER_CRC16_MODEL
+-- 2026-10-17  1.13     mrosiere Add Generic TB_LED1_END
+-- 2026-10-17  1.14     mrosiere Remove Generic USER_RAM_SYNC_READ
+-- 2026-10-17  1.15     mrosiere Report the cycle of LED1 = TB_LED1_END
+-- 2026-10-17  1.16     mrosiere debug_mux_i on 4 bits
 -------------------------------------------------------------------------------
 
 library ieee;
@@ -33,6 +50,7 @@ entity tb_PicoSoC_run is
     (FSYS                  : positive := 50_000_000
     ;FSYS_INT              : positive := 50_000_000
     ;USER_NB_CPU           : positive  := 1
+    ;USER_CLUSTER_NB_CPU   : natural   := 0
     ;USER_BAUD_RATE        : integer  := 115200
   --;USER_UART_DEPTH_TX    : natural  := 0
   --;USER_UART_DEPTH_RX    : natural  := 0
@@ -50,10 +68,22 @@ entity tb_PicoSoC_run is
   --;USER_FAULT_POLARITY   : string   := "low"       -- "high" / "low"
     ;DEBUG_ENABLE          : boolean  := True 
     ;CPU_MODEL             : string   := ""          -- "OpenBlaze8" / "WardRV_fsm"
+    ;USER_SPINLOCK_MODE    : string   := "tas"       -- "tas" / "ticket"
+    ;USER_BARRIER_HOLD     : boolean  := False
+    ;USER_ICN_MASTER_SEL   : string   := "fix"       -- "fix" / "rr" / "wrr"
+    ;USER_ICN_DMA_WEIGHT   : positive := 4
+    ;USER_ICN_XBAR         : boolean  := False
+    ;USER_ICN_PIPE         : string   := "none"
+    ;USER_RAM2_NB_BANK     : positive := 1
+    ;USER_ICACHE_NB_LINE   : natural  := 0
+    ;USER_ICACHE_LINE_SIZE : positive := 4
+    ;USER_IMEM_SHARED      : positive := 1
+    ;USER_CRC16_MODEL      : string   := "modbus"    -- "modbus" / "xmodem"
 
     -- TB Parameters
     ;TB_WATCHDOG           : natural  := 10_000
     ;HAVE_SPI_MEMORY       : boolean  := False
+    ;TB_LED1_END           : integer  := -1        -- LED1 at the end (-1 : not checked)
      );
   
 end entity tb_PicoSoC_run;
@@ -145,6 +175,7 @@ begin  -- architecture tb
     (FSYS                  => FSYS            
     ,FSYS_INT              => FSYS_INT        
     ,USER_NB_CPU           => USER_NB_CPU
+    ,USER_CLUSTER_NB_CPU   => USER_CLUSTER_NB_CPU
     ,USER_BAUD_RATE        => USER_BAUD_RATE
     ,USER_NB_SWITCH        => USER_NB_SWITCH       
     ,USER_NB_LED0          => USER_NB_LED0        
@@ -156,6 +187,17 @@ begin  -- architecture tb
     ,USER_IT_POLARITY      => USER_IT_POLARITY
     ,USER_FAULT_POLARITY   => USER_FAULT_POLARITY  
     ,CPU_MODEL             => CPU_MODEL
+    ,USER_SPINLOCK_MODE    => USER_SPINLOCK_MODE
+    ,USER_BARRIER_HOLD     => USER_BARRIER_HOLD
+    ,USER_ICN_MASTER_SEL   => USER_ICN_MASTER_SEL
+    ,USER_ICN_DMA_WEIGHT   => USER_ICN_DMA_WEIGHT
+    ,USER_ICN_XBAR         => USER_ICN_XBAR
+    ,USER_ICN_PIPE         => USER_ICN_PIPE
+    ,USER_RAM2_NB_BANK     => USER_RAM2_NB_BANK
+    ,USER_ICACHE_NB_LINE   => USER_ICACHE_NB_LINE
+    ,USER_ICACHE_LINE_SIZE => USER_ICACHE_LINE_SIZE
+    ,USER_IMEM_SHARED      => USER_IMEM_SHARED
+    ,USER_CRC16_MODEL      => USER_CRC16_MODEL
      )  
     port map
     (clk_i            => clk_i           
@@ -174,7 +216,7 @@ begin  -- architecture tb
     ,spi_cs_b_o       => spi_cs_b_o 
     ,spi_mosi_o       => spi_mosi_o 
     ,spi_miso_i       => spi_miso_i
-    ,debug_mux_i      => "000"
+    ,debug_mux_i      => "0000"
     ,debug_o          => open 
     ,debug_uart_tx_o  => open
     );
@@ -225,6 +267,11 @@ begin  -- architecture tb
     wait for TB_WATCHDOG_TIME;
 
     -- No testsuite just run
+    if (TB_LED1_END >= 0)
+    then
+      assert (to_integer(unsigned(led1_o)) = TB_LED1_END) report "[TESTBENCH] Test KO : LED1 is " & integer'image(to_integer(unsigned(led1_o))) & ", expected " & integer'image(TB_LED1_END) severity failure;
+    end if;
+
     test_done <= '1';
     run(1);
     
@@ -233,6 +280,32 @@ begin  -- architecture tb
     -- end of process
     wait;
   end process;
+
+  -----------------------------------------------------------------------------
+  -- Cycles until LED1 = TB_LED1_END (duration of the firmware)
+  -----------------------------------------------------------------------------
+  p_led1_end: process is
+    variable cycle : natural := 0;
+  begin
+    if (TB_LED1_END >= 0)
+    then
+      while (test_begin = '0')
+      loop
+        run(1);
+      end loop;
+
+      while (led1_o /= std_logic_vector(to_unsigned(TB_LED1_END, USER_NB_LED1)))
+      loop
+        run(1);
+        cycle := cycle+1;
+      end loop;
+
+      report "[TESTBENCH] LED1 is " & integer'image(TB_LED1_END) & " after " & integer'image(cycle) & " cycles";
+    end if;
+
+    -- end of process
+    wait;
+  end process;
   
   -----------------------------------------------------
   -- Test suite
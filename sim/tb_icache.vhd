@@ -0,0 +1,317 @@
+-------------------------------------------------------------------------------
+-- Title      : tb_icache
+-- Project    :
+-------------------------------------------------------------------------------
+-- File       : tb_icache.vhd
+-- Author     : Mathieu Rosiere
+-- Company    :
+-- Created    : 2026-10-17
+-- Last update: 2026-10-17
+-- Platform   :
+-- Standard   : VHDL'93/02
+-------------------------------------------------------------------------------
+-- Description: Test of icache
+--              * Instruction memory model : a request is accepted when
+--                mem_ready_i = 1 (one cycle out of READY_PERIOD), the
+--                instruction is given the next cycle. Check that the
+--                requests of a fill are the LINE_SIZE addresses of the line
+--                in order, and that the requests are held while mem_ready_i = 0.
+--              * CPU model : one fetch per cycle, frozen while stall_o = 1
+--                (cs_i and addr_i hold). Check the instruction of each fetch.
+--              * Miss on the first word and on a word in the middle of a
+--                line (restart with the missed instruction), hits on the
+--                prefetched words, eviction by another tag on the same index
+--              * Hit and miss counters
+-------------------------------------------------------------------------------
+-- Copyright (c) 2026
+-------------------------------------------------------------------------------
+-- Revisions  :
+-- Date        Version  Author  Description
+-- 2026-10-17  1.0      mrosiere Created
+-------------------------------------------------------------------------------
+
+library ieee;
+use     ieee.std_logic_1164.all;
+use     ieee.numeric_std.all;
+library asylum;
+use     asylum.PicoSoC_pkg.all;
+library work;
+
+entity tb_icache is
+  generic
+    (NB_LINE               : positive := 4
+    ;LINE_SIZE             : positive := 4
+    ;READY_PERIOD          : positive := 3           -- mem_ready_i = 1 one cycle out of READY_PERIOD (1 : ROM_user)
+     );
+
+end entity tb_icache;
+
+architecture tb of tb_icache is
+  -- =====[ Parameters ]==========================
+  constant TB_PERIOD               : time     := 10 ns;
+
+  constant ADDR_WIDTH              : positive := 8;
+  constant DATA_WIDTH              : positive := 32;
+  constant CNT_WIDTH               : positive := 16;
+
+  -- Instruction at an address of the memory model
+  function mem_word (addr : natural) return std_logic_vector is
+  begin
+    return x"A5" & std_logic_vector(to_unsigned(addr*16#10101#, DATA_WIDTH-8));
+  end function mem_word;
+
+  -- =====[ Dut Signals ]=========================
+  signal  clk_i                    : std_logic := '0';
+  signal  arst_b_i                 : std_logic;
+
+  signal  cs_i                     : std_logic;
+  signal  addr_i                   : std_logic_vector(ADDR_WIDTH-1 downto 0);
+  signal  data_o                   : std_logic_vector(DATA_WIDTH-1 downto 0);
+  signal  stall_o                  : std_logic;
+
+  signal  mem_cs_o                 : std_logic;
+  signal  mem_addr_o               : std_logic_vector(ADDR_WIDTH-1 downto 0);
+  signal  mem_ready_i              : std_logic;
+  signal  mem_data_i               : std_logic_vector(DATA_WIDTH-1 downto 0);
+
+  signal  hit_o                    : std_logic_vector(CNT_WIDTH-1 downto 0);
+  signal  miss_o                   : std_logic_vector(CNT_WIDTH-1 downto 0);
+
+  -- =====[ Test Signals ]========================
+  signal  test_done                : std_logic := '0';
+  signal  ready_cnt                : natural range 0 to READY_PERIOD-1 := 0;
+  signal  mem_req                  : natural   := 0;           -- Requests accepted by the memory
+  signal  mem_wait                 : natural   := 0;           -- Cycles with a request and mem_ready_i = 0
+  signal  mem_addr_r               : std_logic_vector(ADDR_WIDTH-1 downto 0);
+  signal  mem_error                : natural   := 0;
+
+begin  -- architecture tb
+
+  -----------------------------------------------------
+  -- Design Under Test
+  -----------------------------------------------------
+  dut : icache
+    generic map
+    (ADDR_WIDTH            => ADDR_WIDTH
+    ,DATA_WIDTH            => DATA_WIDTH
+    ,NB_LINE               => NB_LINE
+    ,LINE_SIZE             => LINE_SIZE
+    ,CNT_WIDTH             => CNT_WIDTH
+     )
+    port map
+    (clk_i                 => clk_i
+    ,arst_b_i              => arst_b_i
+    ,cs_i                  => cs_i
+    ,addr_i                => addr_i
+    ,data_o                => data_o
+    ,stall_o               => stall_o
+    ,mem_cs_o              => mem_cs_o
+    ,mem_addr_o            => mem_addr_o
+    ,mem_ready_i           => mem_ready_i
+    ,mem_data_i            => mem_data_i
+    ,hit_o                 => hit_o
+    ,miss_o                => miss_o
+    );
+
+  -----------------------------------------------------
+  -- Clock Tree
+  -----------------------------------------------------
+  clk_i <= not test_done and not clk_i after TB_PERIOD/2;
+
+  -----------------------------------------------------
+  -- Instruction memory with wait states
+  -----------------------------------------------------
+  mem_ready_i <= '1' when ready_cnt = READY_PERIOD-1 else
+                 '0';
+
+  p_mem: process (clk_i) is
+  begin
+    if rising_edge(clk_i)
+    then
+      if ready_cnt = READY_PERIOD-1
+      then
+        ready_cnt <= 0;
+      else
+        ready_cnt <= ready_cnt+1;
+      end if;
+
+      if mem_cs_o = '1' and mem_ready_i = '0'
+      then
+        mem_wait <= mem_wait+1;
+      end if;
+
+      if mem_cs_o = '1' and mem_ready_i = '1'
+      then
+        mem_data_i <= mem_word(to_integer(unsigned(mem_addr_o)));
+        mem_req    <= mem_req+1;
+        mem_addr_r <= mem_addr_o;
+
+        -- The line is requested from its first word, in order
+        if  (to_integer(unsigned(mem_addr_o)) mod LINE_SIZE /= 0)
+        and (to_integer(unsigned(mem_addr_o)) /= to_integer(unsigned(mem_addr_r))+1)
+        then
+          report "[TESTBENCH] Memory request at " & integer'image(to_integer(unsigned(mem_addr_o))) & " after " & integer'image(to_integer(unsigned(mem_addr_r))) severity error;
+          mem_error <= mem_error+1;
+        end if;
+      else
+        mem_data_i <= (others => 'X');
+      end if;
+    end if;
+  end process p_mem;
+
+  -----------------------------------------------------
+  -- Test suite
+  -- The CPU model drives and samples on the falling edge
+  -----------------------------------------------------
+  process is
+    variable nb_ko    : natural;
+    variable nb_hit   : natural;
+    variable nb_miss  : natural;
+    variable req_beg  : natural;
+    variable stall    : natural;
+
+    procedure check
+      (constant cond  : in  boolean
+      ;constant msg   : in  string
+      ) is
+    begin
+      if not cond
+      then
+        report "[TESTBENCH] " & msg severity error;
+        nb_ko := nb_ko+1;
+      end if;
+    end procedure check;
+
+    -- Fetch of one instruction, hit or miss expected
+    procedure fetch
+      (constant addr  : in  natural
+      ;constant hit   : in  boolean
+      ) is
+    begin
+      req_beg := mem_req;
+      stall   := 0;
+
+      cs_i    <= '1';
+      addr_i  <= std_logic_vector(to_unsigned(addr, ADDR_WIDTH));
+      wait until falling_edge(clk_i);
+
+      -- CPU frozen during the miss
+      while stall_o = '1'
+      loop
+        wait until falling_edge(clk_i);
+        stall := stall+1;
+      end loop;
+
+      check(data_o = mem_word(addr), "Fetch " & integer'image(addr) & " : instruction 0x" & to_hstring(data_o) & " (expected 0x" & to_hstring(mem_word(addr)) & ")");
+
+      if hit
+      then
+        nb_hit  := nb_hit +1;
+        check(stall = 0                   , "Fetch " & integer'image(addr) & " : hit with " & integer'image(stall) & " stall cycles");
+        check(mem_req = req_beg           , "Fetch " & integer'image(addr) & " : hit with memory requests");
+      else
+        nb_miss := nb_miss+1;
+        check(stall >= LINE_SIZE          , "Fetch " & integer'image(addr) & " : miss with " & integer'image(stall) & " stall cycles");
+        check(READY_PERIOD /= 1 or stall = LINE_SIZE+2, "Fetch " & integer'image(addr) & " : miss with " & integer'image(stall) & " stall cycles without wait state");
+        check(mem_req = req_beg+LINE_SIZE , "Fetch " & integer'image(addr) & " : miss with " & integer'image(mem_req-req_beg) & " memory requests");
+      end if;
+    end procedure fetch;
+
+    -- Fetch the words of a line
+    procedure fetch_line
+      (constant line_id : in  natural
+      ;constant hit     : in  boolean
+      ) is
+    begin
+      for w in 0 to LINE_SIZE-1
+      loop
+        fetch(line_id*LINE_SIZE+w, hit);
+      end loop;
+    end procedure fetch_line;
+
+  begin  -- process
+      nb_ko          := 0;
+      nb_hit         := 0;
+      nb_miss        := 0;
+
+      cs_i           <= '0';
+      addr_i         <= (others => '0');
+
+      report "[TESTBENCH] Reset Sequence";
+      arst_b_i       <= '0';
+
+      wait for 10*TB_PERIOD;
+      wait until falling_edge(clk_i);
+
+      arst_b_i       <= '1';
+
+      wait until falling_edge(clk_i);
+      check(stall_o = '0' and mem_cs_o = '0', "Stall or memory request after the reset");
+
+      -------------------------------------------------
+      -- Miss on the first word of the line, then hits
+      -------------------------------------------------
+      report "[TESTBENCH] Miss on the first word";
+      fetch(0, false);
+      for w in 1 to LINE_SIZE-1
+      loop
+        fetch(w, true);
+      end loop;
+
+      -------------------------------------------------
+      -- Miss in the middle of a line : restart with the
+      -- missed instruction, the other words are hits
+      -------------------------------------------------
+      report "[TESTBENCH] Miss in the middle of a line";
+      fetch(1*LINE_SIZE+LINE_SIZE/2, false);
+      fetch_line(1, true);
+
+      -- Miss on the last word of the line
+      fetch(2*LINE_SIZE+LINE_SIZE-1, false);
+      fetch_line(2, true);
+
+      -------------------------------------------------
+      -- Loop on the lines in the cache : only hits
+      -------------------------------------------------
+      report "[TESTBENCH] Loop in the cache";
+      for l in 0 to 2
+      loop
+        fetch_line(l, true);
+      end loop;
+
+      -------------------------------------------------
+      -- Another tag on the index 0 : the line 0 is evicted
+      -------------------------------------------------
+      report "[TESTBENCH] Eviction";
+      fetch(NB_LINE*LINE_SIZE, false);
+      fetch(1*LINE_SIZE      , true );
+      fetch(0                , false);
+      fetch(NB_LINE*LINE_SIZE, false);
+
+      -- Stall and restart after an idle cycle
+      cs_i           <= '0';
+      wait until falling_edge(clk_i);
+      check(stall_o = '0' and mem_cs_o = '0', "Stall or memory request without fetch");
+      fetch(2*LINE_SIZE, true);
+
+      cs_i           <= '0';
+      wait until falling_edge(clk_i);
+      wait until falling_edge(clk_i);
+
+      -------------------------------------------------
+      -- Counters
+      -------------------------------------------------
+      check(to_integer(unsigned(hit_o )) = nb_hit , integer'image(to_integer(unsigned(hit_o ))) & " hits counted (expected "   & integer'image(nb_hit ) & ")");
+      check(to_integer(unsigned(miss_o)) = nb_miss, integer'image(to_integer(unsigned(miss_o))) & " misses counted (expected " & integer'image(nb_miss) & ")");
+
+      check(mem_error = 0, integer'image(mem_error) & " memory requests out of order");
+      check(READY_PERIOD = 1 or mem_wait > 0, "No memory request with mem_ready_i = 0");
+
+      assert (nb_ko = 0) report "[TESTBENCH] Test KO" severity error;
+
+      report "[TESTBENCH] Test Done";
+      test_done      <= '1';
+      wait;
+  end process;
+
+end architecture tb;
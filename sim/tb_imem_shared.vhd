@@ -0,0 +1,310 @@
+-------------------------------------------------------------------------------
+-- Title      : tb_imem_shared
+-- Project    :
+-------------------------------------------------------------------------------
+-- File       : tb_imem_shared.vhd
+-- Author     : Mathieu Rosiere
+-- Company    :
+-- Created    : 2026-10-17
+-- Last update: 2026-10-17
+-- Platform   :
+-- Standard   : VHDL'93/02
+-------------------------------------------------------------------------------
+-- Description: Test of the shared instruction memory of PicoSoC_user
+--              (IMEM_SHARED > 1) : NB_CPU instruction caches on one
+--              instruction memory through a round-robin sbi_arbiter.
+--              * Instruction memory model : as ROM_user, one request per
+--                cycle (ready = 1), the instruction is given the next cycle
+--                to all the caches
+--              * CPU models : one fetch per cycle, frozen while stall_o = 1.
+--                The CPUs run loops on overlapping addresses (the misses of
+--                the CPUs are at the same time) then jump to evict their
+--                lines. Check the instruction of each fetch.
+--              * Counters : hits + misses = fetches of each CPU, and the
+--                requests of the memory are LINE_SIZE per miss
+-------------------------------------------------------------------------------
+-- Copyright (c) 2026
+-------------------------------------------------------------------------------
+-- Revisions  :
+-- Date        Version  Author  Description
+-- 2026-10-17  1.0      mrosiere Created
+-------------------------------------------------------------------------------
+
+library ieee;
+use     ieee.std_logic_1164.all;
+use     ieee.numeric_std.all;
+library asylum;
+use     asylum.sbi_pkg.all;
+use     asylum.logic_pkg.all;
+use     asylum.PicoSoC_pkg.all;
+library work;
+
+entity tb_imem_shared is
+  generic
+    (NB_CPU                : positive := 3
+    ;NB_LINE               : positive := 4
+    ;LINE_SIZE             : positive := 4
+    ;NB_LOOP               : positive := 3           -- Iterations of each loop of the CPUs
+     );
+
+end entity tb_imem_shared;
+
+architecture tb of tb_imem_shared is
+  -- =====[ Parameters ]==========================
+  constant TB_PERIOD               : time     := 10 ns;
+
+  constant ADDR_WIDTH              : positive := 8;
+  constant DATA_WIDTH              : positive := 32;
+  constant CNT_WIDTH               : positive := 16;
+
+  -- Loop of LOOP_SIZE instructions at LOOP_BASE*i of the CPU i : the loops
+  -- of the CPUs share lines
+  constant LOOP_SIZE               : positive := 3*LINE_SIZE;
+  constant LOOP_BASE               : positive := 2*LINE_SIZE;
+  -- Loop far from the first one (same indexes of the cache : eviction)
+  constant FAR_BASE                : positive := 4*NB_LINE*LINE_SIZE;
+
+  constant ALL_DONE                : std_logic_vector(NB_CPU-1 downto 0) := (others => '1');
+
+  -- Instruction at an address of the memory model
+  function mem_word (addr : natural) return std_logic_vector is
+  begin
+    return x"A5" & std_logic_vector(to_unsigned(addr*16#10101#, DATA_WIDTH-8));
+  end function mem_word;
+
+  -- =====[ Dut Signals ]=========================
+  signal  clk_i                    : std_logic := '0';
+  signal  arst_b_i                 : std_logic;
+
+  signal  cs_i                     : std_logic_vector(NB_CPU-1 downto 0);
+  signal  addr_i                   : slvs_t(NB_CPU-1 downto 0)(ADDR_WIDTH-1 downto 0);
+  signal  data_o                   : slvs_t(NB_CPU-1 downto 0)(DATA_WIDTH-1 downto 0);
+  signal  stall_o                  : std_logic_vector(NB_CPU-1 downto 0);
+
+  signal  hit_o                    : slvs_t(NB_CPU-1 downto 0)(CNT_WIDTH-1 downto 0);
+  signal  miss_o                   : slvs_t(NB_CPU-1 downto 0)(CNT_WIDTH-1 downto 0);
+
+  signal  sbi_inis                 : sbi_inis_t(NB_CPU-1 downto 0)(addr (ADDR_WIDTH-1 downto 0),
+                                                                   wdata(DATA_WIDTH-1 downto 0));
+  signal  sbi_tgts                 : sbi_tgts_t(NB_CPU-1 downto 0)(rdata(DATA_WIDTH-1 downto 0));
+  signal  mem_sbi_ini              : sbi_ini_t (addr (ADDR_WIDTH-1 downto 0),
+                                                wdata(DATA_WIDTH-1 downto 0));
+  signal  mem_sbi_tgt              : sbi_tgt_t (rdata(DATA_WIDTH-1 downto 0));
+
+  -- =====[ Test Signals ]========================
+  signal  test_begin               : std_logic := '0';
+  signal  test_done                : std_logic := '0';
+  signal  cpu_done                 : std_logic_vector(NB_CPU-1 downto 0) := (others => '0');
+  signal  nb_fetch                 : integer_vector(0 to NB_CPU-1) := (others => 0);
+  signal  nb_error                 : integer_vector(0 to NB_CPU-1) := (others => 0);
+  signal  mem_req                  : natural   := 0;           -- Requests accepted by the memory
+
+begin  -- architecture tb
+
+  -----------------------------------------------------
+  -- Design Under Test : the caches, the arbiter and
+  -- the memory as gen_imem_shared of PicoSoC_user
+  -----------------------------------------------------
+  gen_cpu: for i in 0 to NB_CPU-1
+  generate
+    signal mem_cs                  : std_logic;
+    signal mem_addr                : std_logic_vector(ADDR_WIDTH-1 downto 0);
+  begin
+    ins_icache : icache
+      generic map
+      (ADDR_WIDTH            => ADDR_WIDTH
+      ,DATA_WIDTH            => DATA_WIDTH
+      ,NB_LINE               => NB_LINE
+      ,LINE_SIZE             => LINE_SIZE
+      ,CNT_WIDTH             => CNT_WIDTH
+       )
+      port map
+      (clk_i                 => clk_i
+      ,arst_b_i              => arst_b_i
+      ,cs_i                  => cs_i     (i)
+      ,addr_i                => addr_i   (i)
+      ,data_o                => data_o   (i)
+      ,stall_o               => stall_o  (i)
+      ,mem_cs_o              => mem_cs
+      ,mem_addr_o            => mem_addr
+      ,mem_ready_i           => sbi_tgts (i).ready
+      ,mem_data_i            => sbi_tgts (i).rdata
+      ,hit_o                 => hit_o    (i)
+      ,miss_o                => miss_o   (i)
+      );
+
+    sbi_inis(i).cs    <= mem_cs;
+    sbi_inis(i).re    <= mem_cs;
+    sbi_inis(i).we    <= '0';
+    sbi_inis(i).addr  <= mem_addr;
+    sbi_inis(i).wdata <= (others => '0');
+  end generate gen_cpu;
+
+  ins_sbi_arbiter : sbi_arbiter
+    generic map
+    (NB_MASTER             => NB_CPU
+    ,ALGO                  => "rr"
+     )
+    port map
+    (clk_i                 => clk_i
+    ,arst_b_i              => arst_b_i
+    ,sbi_inis_i            => sbi_inis
+    ,sbi_tgts_o            => sbi_tgts
+    ,sbi_ini_o             => mem_sbi_ini
+    ,sbi_tgt_i             => mem_sbi_tgt
+    );
+
+  -----------------------------------------------------
+  -- Clock Tree
+  -----------------------------------------------------
+  clk_i <= not test_done and not clk_i after TB_PERIOD/2;
+
+  -----------------------------------------------------
+  -- Instruction memory : as ROM_user, read the next cycle
+  -----------------------------------------------------
+  mem_sbi_tgt.ready <= '1';
+
+  p_mem: process (clk_i) is
+  begin
+    if rising_edge(clk_i)
+    then
+      if mem_sbi_ini.cs = '1'
+      then
+        mem_sbi_tgt.rdata <= mem_word(to_integer(unsigned(mem_sbi_ini.addr)));
+        mem_req           <= mem_req+1;
+      end if;
+    end if;
+  end process p_mem;
+
+  -----------------------------------------------------
+  -- CPU models
+  -- A CPU drives and samples on the falling edge
+  -----------------------------------------------------
+  gen_cpu_model: for i in 0 to NB_CPU-1
+  generate
+    p_cpu: process is
+      variable fetches  : natural;
+      variable errors   : natural;
+
+      -- Fetch of one instruction
+      procedure fetch
+        (constant addr  : in  natural
+        ) is
+      begin
+        cs_i  (i) <= '1';
+        addr_i(i) <= std_logic_vector(to_unsigned(addr, ADDR_WIDTH));
+        wait until falling_edge(clk_i);
+
+        -- CPU frozen during the miss
+        while stall_o(i) = '1'
+        loop
+          wait until falling_edge(clk_i);
+        end loop;
+
+        fetches := fetches+1;
+
+        if data_o(i) /= mem_word(addr)
+        then
+          report "[TESTBENCH] CPU " & integer'image(i) & " fetch " & integer'image(addr) & " : instruction 0x" & to_hstring(data_o(i)) & " (expected 0x" & to_hstring(mem_word(addr)) & ")" severity error;
+          errors := errors+1;
+        end if;
+      end procedure fetch;
+
+      -- NB_LOOP iterations of a loop of LOOP_SIZE instructions
+      procedure fetch_loop
+        (constant base  : in  natural
+        ) is
+      begin
+        for l in 1 to NB_LOOP
+        loop
+          for a in base to base+LOOP_SIZE-1
+          loop
+            fetch(a);
+          end loop;
+        end loop;
+      end procedure fetch_loop;
+
+    begin
+      fetches   := 0;
+      errors    := 0;
+      cs_i  (i) <= '0';
+      addr_i(i) <= (others => '0');
+
+      wait until test_begin = '1';
+      wait until falling_edge(clk_i);
+
+      fetch_loop(i*LOOP_BASE);
+      fetch_loop(FAR_BASE+i*LOOP_BASE);
+      fetch_loop(i*LOOP_BASE);
+
+      cs_i  (i) <= '0';
+      nb_fetch(i) <= fetches;
+      nb_error(i) <= errors;
+      cpu_done(i) <= '1';
+      wait;
+    end process p_cpu;
+  end generate gen_cpu_model;
+
+  -----------------------------------------------------
+  -- Test suite
+  -----------------------------------------------------
+  process is
+    variable nb_ko    : natural;
+    variable nb_miss  : natural;
+    variable hits     : natural;
+    variable misses   : natural;
+  begin  -- process
+      nb_ko          := 0;
+      nb_miss        := 0;
+
+      report "[TESTBENCH] Reset Sequence";
+      arst_b_i       <= '0';
+
+      wait for 10*TB_PERIOD;
+      wait until falling_edge(clk_i);
+
+      arst_b_i       <= '1';
+      test_begin     <= '1';
+
+      report "[TESTBENCH] " & integer'image(NB_CPU) & " CPUs on one instruction memory";
+      wait until cpu_done = ALL_DONE;
+      wait until falling_edge(clk_i);
+
+      -------------------------------------------------
+      -- Instructions and counters
+      -------------------------------------------------
+      for i in 0 to NB_CPU-1
+      loop
+        hits   := to_integer(unsigned(hit_o (i)));
+        misses := to_integer(unsigned(miss_o(i)));
+        nb_miss:= nb_miss+misses;
+
+        report "[TESTBENCH] CPU " & integer'image(i) & " : " & integer'image(nb_fetch(i)) & " fetches, " & integer'image(hits) & " hits, " & integer'image(misses) & " misses";
+
+        if nb_error(i) /= 0
+        then
+          report "[TESTBENCH] CPU " & integer'image(i) & " : " & integer'image(nb_error(i)) & " wrong instructions" severity error;
+          nb_ko := nb_ko+1;
+        end if;
+
+        if hits+misses /= nb_fetch(i)
+        then
+          report "[TESTBENCH] CPU " & integer'image(i) & " : " & integer'image(hits+misses) & " hits and misses for " & integer'image(nb_fetch(i)) & " fetches" severity error;
+          nb_ko := nb_ko+1;
+        end if;
+      end loop;
+
+      if mem_req /= nb_miss*LINE_SIZE
+      then
+        report "[TESTBENCH] " & integer'image(mem_req) & " memory requests for " & integer'image(nb_miss) & " misses" severity error;
+        nb_ko := nb_ko+1;
+      end if;
+
+      assert (nb_ko = 0) report "[TESTBENCH] Test KO" severity error;
+
+      report "[TESTBENCH] Test Done";
+      test_done      <= '1';
+      wait;
+  end process;
+
+end architecture tb;
@@ -0,0 +1,290 @@
+-------------------------------------------------------------------------------
+-- Title      : tb_sbi_arbiter
+-- Project    :
+-------------------------------------------------------------------------------
+-- File       : tb_sbi_arbiter.vhd
+-- Author     : Mathieu Rosiere
+-- Company    :
+-- Created    : 2026-10-17
+-- Last update: 2026-10-17
+-- Platform   :
+-- Standard   : VHDL'93/02
+-------------------------------------------------------------------------------
+-- Description: NB_MASTER masters always requesting (random idle between two
+--              accesses) on a target with a random latency.
+--              Report for each master the number of grants and the worst
+--              wait (cycles between the request and the end of the access).
+--              With "rr" and "wrr", check the worst wait is bounded by the
+--              accesses of the other masters in one turn.
+--              The last master has the weight WEIGHT_LAST (DMA of the SoC),
+--              the other ones 1.
+-------------------------------------------------------------------------------
+-- Copyright (c) 2026
+-------------------------------------------------------------------------------
+-- Revisions  :
+-- Date        Version  Author  Description
+-- 2026-10-17  1.0      mrosiere Created
+-------------------------------------------------------------------------------
+
+library ieee;
+use     ieee.std_logic_1164.all;
+use     ieee.numeric_std.all;
+use     ieee.math_real.all;
+library asylum;
+use     asylum.sbi_pkg.all;
+use     asylum.PicoSoC_pkg.all;
+library work;
+
+entity tb_sbi_arbiter is
+  generic
+    (NB_MASTER             : positive := 5
+    ;ALGO                  : string   := "rr"        -- "fix" / "rr" / "wrr"
+    ;WEIGHT_LAST           : positive := 4
+    ;IDLE_MAX              : natural  := 1           -- Cycles between two accesses of a master
+    ;LATENCY_MAX           : natural  := 2           -- Wait cycles of the target
+
+    -- TB Parameters
+    ;TB_CYCLES             : positive := 20_000
+     );
+
+end entity tb_sbi_arbiter;
+
+architecture tb of tb_sbi_arbiter is
+  -- =====[ Parameters ]==========================
+  constant TB_PERIOD               : time    := 10 ns;
+
+  constant ADDR_WIDTH              : positive := 8;
+  constant DATA_WIDTH              : positive := 8;
+
+  constant WEIGHT                  : integer_vector(0 to NB_MASTER-1) :=
+    (NB_MASTER-1 => WEIGHT_LAST
+    ,others      => 1
+    );
+
+  -- Worst wait of the master i with "rr" / "wrr" : one turn of the other
+  -- masters then its own access
+  function wait_max (i : natural) return natural is
+    variable nb_access : natural;
+  begin
+    nb_access := 0;
+
+    for j in 0 to NB_MASTER-1
+    loop
+      if j /= i
+      then
+        if ALGO = "wrr"
+        then
+          nb_access := nb_access + WEIGHT(j);
+        else
+          nb_access := nb_access + 1;
+        end if;
+      end if;
+    end loop;
+
+    return nb_access*(LATENCY_MAX+1) + LATENCY_MAX;
+  end function wait_max;
+
+  -- =====[ Dut Signals ]=========================
+  signal  clk_i                    : std_logic := '0';
+  signal  arst_b_i                 : std_logic;
+
+  signal  sbi_inis                 : sbi_inis_t(NB_MASTER-1 downto 0)(addr (ADDR_WIDTH-1 downto 0),
+                                                                      wdata(DATA_WIDTH-1 downto 0));
+  signal  sbi_tgts                 : sbi_tgts_t(NB_MASTER-1 downto 0)(rdata(DATA_WIDTH-1 downto 0));
+  signal  sbi_ini                  : sbi_ini_t (addr (ADDR_WIDTH-1 downto 0),
+                                                wdata(DATA_WIDTH-1 downto 0));
+  signal  sbi_tgt                  : sbi_tgt_t (rdata(DATA_WIDTH-1 downto 0));
+
+  -- =====[ Test Signals ]========================
+  signal  test_begin               : std_logic := '0';
+  signal  test_done                : std_logic := '0';
+  signal  latency                  : natural   := 0;
+
+  signal  nb_grant                 : integer_vector(0 to NB_MASTER-1) := (others => 0);
+  signal  nb_wait                  : integer_vector(0 to NB_MASTER-1) := (others => 0);
+  signal  nb_error                 : integer_vector(0 to NB_MASTER-1) := (others => 0);
+
+begin  -- architecture tb
+
+  -----------------------------------------------------
+  -- Design Under Test
+  -----------------------------------------------------
+  dut : sbi_arbiter
+    generic map
+    (NB_MASTER             => NB_MASTER
+    ,ALGO                  => ALGO
+    ,WEIGHT                => WEIGHT
+     )
+    port map
+    (clk_i                 => clk_i
+    ,arst_b_i              => arst_b_i
+    ,sbi_inis_i            => sbi_inis
+    ,sbi_tgts_o            => sbi_tgts
+    ,sbi_ini_o             => sbi_ini
+    ,sbi_tgt_i             => sbi_tgt
+    );
+
+  -----------------------------------------------------
+  -- Clock Tree
+  -----------------------------------------------------
+  clk_i <= not test_done and not clk_i after TB_PERIOD/2;
+
+  -----------------------------------------------------
+  -- Target : random latency (0 to LATENCY_MAX wait cycles per access),
+  -- read data is the address
+  -----------------------------------------------------
+  p_target: process is
+    variable seed1   : positive := 1;
+    variable seed2   : positive := 2;
+    variable rnd     : real;
+  begin
+    latency <= 0;
+
+    loop
+      wait until rising_edge(clk_i);
+
+      if sbi_ini.cs = '1'
+      then
+        if latency = 0
+        then
+          -- Latency of the next access
+          uniform(seed1, seed2, rnd);
+          latency <= integer(floor(rnd*real(LATENCY_MAX+1)));
+        else
+          latency <= latency-1;
+        end if;
+      end if;
+    end loop;
+  end process p_target;
+
+  sbi_tgt.ready <= '1' when latency = 0 else '0';
+  sbi_tgt.rdata <= sbi_ini.addr(DATA_WIDTH-1 downto 0);
+
+  -----------------------------------------------------
+  -- Masters
+  -----------------------------------------------------
+  gen_master: for i in 0 to NB_MASTER-1
+  generate
+    p_master: process is
+      variable seed1   : positive := 3+i;
+      variable seed2   : positive := 4+2*i;
+      variable rnd     : real;
+      variable cycles  : natural;
+    begin
+      sbi_inis(i).cs    <= '0';
+      sbi_inis(i).re    <= '0';
+      sbi_inis(i).we    <= '0';
+      sbi_inis(i).addr  <= std_logic_vector(to_unsigned(i, ADDR_WIDTH));
+      sbi_inis(i).wdata <= (others => '0');
+
+      wait until test_begin = '1';
+
+      loop
+        -- Idle
+        uniform(seed1, seed2, rnd);
+        for c in 1 to integer(floor(rnd*real(IDLE_MAX+1)))
+        loop
+          wait until rising_edge(clk_i);
+        end loop;
+
+        -- Access
+        sbi_inis(i).cs    <= '1';
+        sbi_inis(i).re    <= '1';
+        cycles            := 0;
+
+        loop
+          wait until rising_edge(clk_i);
+          exit when sbi_tgts(i).ready = '1';
+          cycles := cycles+1;
+
+          -- Updated while waiting : a starved master has no end of access
+          if cycles > nb_wait(i)
+          then
+            nb_wait(i)    <= cycles;
+          end if;
+        end loop;
+
+        if sbi_tgts(i).rdata /= std_logic_vector(to_unsigned(i, DATA_WIDTH))
+        then
+          nb_error(i) <= nb_error(i)+1;
+        end if;
+
+        nb_grant(i)       <= nb_grant(i)+1;
+
+        sbi_inis(i).cs    <= '0';
+        sbi_inis(i).re    <= '0';
+      end loop;
+    end process p_master;
+  end generate gen_master;
+
+  -----------------------------------------------------
+  -- Only one master at the end of an access
+  -----------------------------------------------------
+  p_check: process (clk_i) is
+    variable nb_ready : natural;
+  begin
+    if rising_edge(clk_i)
+    then
+      nb_ready := 0;
+
+      for i in 0 to NB_MASTER-1
+      loop
+        if sbi_inis(i).cs = '1' and sbi_tgts(i).ready = '1'
+        then
+          nb_ready := nb_ready+1;
+        end if;
+      end loop;
+
+      assert nb_ready <= 1 report "[TESTBENCH] Test KO : " & integer'image(nb_ready) & " masters granted" severity error;
+    end if;
+  end process p_check;
+
+  -----------------------------------------------------
+  -- Test suite
+  -----------------------------------------------------
+  process is
+    variable nb_ko : natural;
+  begin  -- process
+
+      report "[TESTBENCH] Reset Sequence";
+      arst_b_i       <= '0';
+
+      wait for 10*TB_PERIOD;
+      wait until rising_edge(clk_i);
+
+      arst_b_i       <= '1';
+      test_begin     <= '1';
+
+      for c in 1 to TB_CYCLES
+      loop
+        wait until rising_edge(clk_i);
+      end loop;
+
+      nb_ko := 0;
+
+      report "[TESTBENCH] Algo " & ALGO & " : " & integer'image(NB_MASTER) & " masters, " & integer'image(TB_CYCLES) & " cycles";
+      for i in 0 to NB_MASTER-1
+      loop
+        report "[TESTBENCH] Master " & integer'image(i) & " : " & integer'image(nb_grant(i)) & " grants, worst wait " & integer'image(nb_wait(i)) & " cycles";
+
+        if nb_error(i) /= 0
+        then
+          report "[TESTBENCH] Master " & integer'image(i) & " : " & integer'image(nb_error(i)) & " bad read data" severity error;
+          nb_ko := nb_ko+1;
+        end if;
+
+        if ALGO /= "fix" and nb_wait(i) > wait_max(i)
+        then
+          report "[TESTBENCH] Master " & integer'image(i) & " : worst wait greater than " & integer'image(wait_max(i)) & " cycles" severity error;
+          nb_ko := nb_ko+1;
+        end if;
+      end loop;
+
+      assert (nb_ko = 0) report "[TESTBENCH] Test KO" severity error;
+
+      report "[TESTBENCH] Test Done";
+      test_done      <= '1';
+      wait;
+  end process;
+
+end architecture tb;
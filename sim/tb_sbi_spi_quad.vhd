@@ -0,0 +1,367 @@
+-------------------------------------------------------------------------------
+-- Title      : tb_sbi_spi_quad
+-- Project    :
+-------------------------------------------------------------------------------
+-- File       : tb_sbi_spi_quad.vhd
+-- Author     : Mathieu Rosiere
+-- Company    :
+-- Created    : 2026-10-17
+-- Last update: 2026-10-17
+-- Platform   :
+-- Standard   : VHDL'93/02
+-------------------------------------------------------------------------------
+-- Description: Test of sbi_spi_quad
+--              * Loopback (CFG[3]) : TX and RX command of 4 bytes in Single,
+--                Dual and Quad, check the RX bytes and the SCLK periods
+--                (8, 4 and 2 per byte)
+--              * Sequence of a flash read (see spi_flash_read) : TX in
+--                Single (instruction, address, dummy) then RX bursts in
+--                Dual and Quad, CS asserted between the commands. The IOs
+--                (io_i) are driven by the testbench. Check the output
+--                enables at each SCLK edge, check the IOs are tri-stated
+--                between two commands and driven (WP#, HOLD#, MOSI) after
+--                the release of CS.
+-------------------------------------------------------------------------------
+-- Copyright (c) 2026
+-------------------------------------------------------------------------------
+-- Revisions  :
+-- Date        Version  Author  Description
+-- 2026-10-17  1.0      mrosiere Created
+-------------------------------------------------------------------------------
+
+library ieee;
+use     ieee.std_logic_1164.all;
+use     ieee.numeric_std.all;
+library asylum;
+use     asylum.sbi_pkg.all;
+use     asylum.PicoSoC_pkg.all;
+library work;
+
+entity tb_sbi_spi_quad is
+  generic
+    (PRESCALER             : natural  := 1           -- Half period of SCLK is PRESCALER+1 cycles
+    ;GAP                   : positive := 50          -- Cycles between two commands with CS asserted
+     );
+
+end entity tb_sbi_spi_quad;
+
+architecture tb of tb_sbi_spi_quad is
+  -- =====[ Parameters ]==========================
+  constant TB_PERIOD               : time    := 10 ns;
+
+  constant REG_DATA                : natural := 0;
+  constant REG_CMD                 : natural := 1;
+  constant REG_CFG                 : natural := 2;
+  constant REG_PRESCALER           : natural := 3;
+
+  constant CMD_TX                  : natural := 16#80#;
+  constant CMD_RX                  : natural := 16#40#;
+  constant CMD_LAST                : natural := 16#20#;
+
+  constant CFG_ENABLE              : natural := 16#01#;
+  constant CFG_LOOPBACK            : natural := 16#08#;
+
+  type     natural_vector_t is array (natural range <>) of natural;
+
+  constant WIDTH_BITS              : natural_vector_t(0 to 2) := (1, 2, 4);
+
+  -- Output enables while a command shifts
+  type     oe_vector_t is array (0 to 2) of std_logic_vector(4-1 downto 0);
+  constant OE_TX                   : oe_vector_t := ("1101", "1111", "1111");
+  constant OE_RX                   : oe_vector_t := ("1101", "1100", "0000");
+  constant OE_CS_RELEASED          : std_logic_vector(4-1 downto 0) := "1101";
+  constant OE_CS_GAP               : std_logic_vector(4-1 downto 0) := "0000";
+
+  -- IOs driven by the "flash" : RX byte is 0xAA in Dual and Quad, 0xFF in Single
+  constant IO_FLASH                : std_logic_vector(4-1 downto 0) := "1010";
+  constant RX_FLASH                : natural_vector_t(0 to 2) := (16#FF#, 16#AA#, 16#AA#);
+
+  -- =====[ Dut Signals ]=========================
+  signal  clk_i                    : std_logic := '0';
+  signal  arst_b_i                 : std_logic;
+
+  signal  sbi_ini                  : sbi_ini_t (addr (SBI_ADDR_WIDTH-1 downto 0),
+                                                wdata(SBI_DATA_WIDTH-1 downto 0));
+  signal  sbi_tgt                  : sbi_tgt_t (rdata(SBI_DATA_WIDTH-1 downto 0));
+
+  signal  sclk_o                   : std_logic;
+  signal  cs_b_o                   : std_logic;
+  signal  io_o                     : std_logic_vector(4-1 downto 0);
+  signal  io_oe_o                  : std_logic_vector(4-1 downto 0);
+  signal  io_i                     : std_logic_vector(4-1 downto 0);
+
+  -- =====[ Test Signals ]========================
+  signal  test_done                : std_logic := '0';
+  signal  sclk_r                   : std_logic := '0';
+  signal  sclk_cnt                 : natural   := 0;           -- SCLK periods
+  signal  oe_exp                   : std_logic_vector(4-1 downto 0) := OE_CS_RELEASED;
+  signal  oe_error                 : natural   := 0;
+
+begin  -- architecture tb
+
+  -----------------------------------------------------
+  -- Design Under Test
+  -----------------------------------------------------
+  dut : sbi_spi_quad
+    generic map
+    (PRESCALER_RATIO       => std_logic_vector(to_unsigned(PRESCALER,8))
+     )
+    port map
+    (clk_i                 => clk_i
+    ,arst_b_i              => arst_b_i
+    ,sbi_ini_i             => sbi_ini
+    ,sbi_tgt_o             => sbi_tgt
+    ,sclk_o                => sclk_o
+    ,cs_b_o                => cs_b_o
+    ,io_o                  => io_o
+    ,io_oe_o               => io_oe_o
+    ,io_i                  => io_i
+    );
+
+  io_i  <= IO_FLASH;
+
+  -----------------------------------------------------
+  -- Clock Tree
+  -----------------------------------------------------
+  clk_i <= not test_done and not clk_i after TB_PERIOD/2;
+
+  -----------------------------------------------------
+  -- SCLK periods and output enables at each leading edge (CPOL = 0)
+  -----------------------------------------------------
+  p_monitor: process (clk_i) is
+  begin
+    if rising_edge(clk_i)
+    then
+      sclk_r <= sclk_o;
+
+      if sclk_r = '0' and sclk_o = '1'
+      then
+        sclk_cnt <= sclk_cnt+1;
+
+        if cs_b_o /= '0' or io_oe_o /= oe_exp
+        then
+          report "[TESTBENCH] SCLK edge with CS_B " & std_logic'image(cs_b_o) & " and OE " & to_string(io_oe_o) & " (expected " & to_string(oe_exp) & ")" severity error;
+          oe_error <= oe_error+1;
+        end if;
+      end if;
+    end if;
+  end process p_monitor;
+
+  -----------------------------------------------------
+  -- Test suite
+  -----------------------------------------------------
+  process is
+    variable nb_ko    : natural;
+    variable rdata    : natural;
+    variable sclk_beg : natural;
+
+    -- SBI access (stalled while ready = 0)
+    procedure sbi_access
+      (constant addr  : in  natural
+      ;constant we    : in  std_logic
+      ;constant wdata : in  natural
+      ) is
+    begin
+      sbi_ini.cs    <= '1';
+      sbi_ini.we    <= we;
+      sbi_ini.re    <= not we;
+      sbi_ini.addr  <= std_logic_vector(to_unsigned(addr , SBI_ADDR_WIDTH));
+      sbi_ini.wdata <= std_logic_vector(to_unsigned(wdata, SBI_DATA_WIDTH));
+
+      loop
+        wait until rising_edge(clk_i);
+        exit when sbi_tgt.ready = '1';
+      end loop;
+
+      rdata         := to_integer(unsigned(sbi_tgt.rdata));
+      sbi_ini.cs    <= '0';
+      sbi_ini.we    <= '0';
+      sbi_ini.re    <= '0';
+    end procedure sbi_access;
+
+    procedure sbi_wr
+      (constant addr  : in  natural
+      ;constant wdata : in  natural
+      ) is
+    begin
+      sbi_access(addr, '1', wdata);
+    end procedure sbi_wr;
+
+    procedure sbi_rd
+      (constant addr  : in  natural
+      ) is
+    begin
+      sbi_access(addr, '0', 0);
+    end procedure sbi_rd;
+
+    procedure check
+      (constant cond  : in  boolean
+      ;constant msg   : in  string
+      ) is
+    begin
+      if not cond
+      then
+        report "[TESTBENCH] " & msg severity error;
+        nb_ko := nb_ko+1;
+      end if;
+    end procedure check;
+
+    -- End of a TX command without RX : SCLK idle during one byte
+    procedure wait_tx_end is
+      variable sclk_last : natural;
+    begin
+      loop
+        sclk_last := sclk_cnt;
+        for c in 1 to 2*8*(PRESCALER+1)+4
+        loop
+          wait until rising_edge(clk_i);
+        end loop;
+        exit when sclk_cnt = sclk_last;
+      end loop;
+    end procedure wait_tx_end;
+
+    -- Release of CS after the last command
+    procedure wait_cs_release is
+    begin
+      loop
+        wait until rising_edge(clk_i);
+        exit when cs_b_o = '1';
+      end loop;
+    end procedure wait_cs_release;
+
+    -- CS asserted between two commands : the IOs are tri-stated
+    procedure check_gap
+      (constant msg   : in  string
+      ) is
+    begin
+      for c in 1 to GAP
+      loop
+        wait until rising_edge(clk_i);
+        check(cs_b_o = '0'        , msg & " : CS released between two commands");
+        check(io_oe_o = OE_CS_GAP , msg & " : OE " & to_string(io_oe_o) & " between two commands");
+      end loop;
+    end procedure check_gap;
+
+  begin  -- process
+      nb_ko          := 0;
+
+      sbi_ini.cs     <= '0';
+      sbi_ini.we     <= '0';
+      sbi_ini.re     <= '0';
+      sbi_ini.addr   <= (others => '0');
+      sbi_ini.wdata  <= (others => '0');
+
+      report "[TESTBENCH] Reset Sequence";
+      arst_b_i       <= '0';
+
+      wait for 10*TB_PERIOD;
+      wait until rising_edge(clk_i);
+
+      arst_b_i       <= '1';
+
+      wait until rising_edge(clk_i);
+      check(cs_b_o = '1' and io_oe_o = OE_CS_RELEASED, "OE " & to_string(io_oe_o) & " after the reset");
+
+      -------------------------------------------------
+      -- Loopback : TX and RX in x1, x2 and x4
+      -------------------------------------------------
+      for w in 0 to 2
+      loop
+        report "[TESTBENCH] Loopback x" & integer'image(WIDTH_BITS(w));
+
+        sbi_wr(REG_CFG, CFG_ENABLE + CFG_LOOPBACK + w*16);
+        oe_exp   <= OE_TX(w);
+        sclk_beg := sclk_cnt;
+
+        sbi_wr(REG_CMD, CMD_TX + CMD_RX + CMD_LAST + (4-1));
+
+        for b in 0 to 4-1
+        loop
+          sbi_wr(REG_DATA, 16#5A# + 16#31#*b + w);
+          sbi_rd(REG_DATA);
+          check(rdata = (16#5A# + 16#31#*b + w) mod 256, "Loopback x" & integer'image(WIDTH_BITS(w)) & " : byte " & integer'image(b) & " read " & integer'image(rdata));
+        end loop;
+
+        wait_cs_release;
+
+        check(sclk_cnt-sclk_beg = 4*8/WIDTH_BITS(w), "Loopback x" & integer'image(WIDTH_BITS(w)) & " : " & integer'image(sclk_cnt-sclk_beg) & " SCLK periods");
+        check(io_oe_o = OE_CS_RELEASED , "Loopback x" & integer'image(WIDTH_BITS(w)) & " : OE " & to_string(io_oe_o) & " after the release of CS");
+      end loop;
+
+      -------------------------------------------------
+      -- Flash read : instruction, address and dummy in Single,
+      -- then RX bursts in Dual / Quad
+      -------------------------------------------------
+      for w in 1 to 2
+      loop
+        report "[TESTBENCH] Flash read x" & integer'image(WIDTH_BITS(w));
+
+        -- Instruction, address, dummy
+        sbi_wr(REG_CFG, CFG_ENABLE);
+        oe_exp   <= OE_TX(0);
+        sbi_wr(REG_CMD, CMD_TX + (5-1));
+        for b in 0 to 5-1
+        loop
+          sbi_wr(REG_DATA, 16#6B#);
+        end loop;
+        wait_tx_end;
+        check_gap("Flash read x" & integer'image(WIDTH_BITS(w)) & " after the dummy");
+
+        -- Data : 2 bursts
+        sbi_wr(REG_CFG, CFG_ENABLE + w*16);
+        check_gap("Flash read x" & integer'image(WIDTH_BITS(w)) & " after the width change");
+
+        for burst in 0 to 2-1
+        loop
+          oe_exp   <= OE_RX(w);
+          sclk_beg := sclk_cnt;
+
+          if burst = 2-1
+          then
+            sbi_wr(REG_CMD, CMD_RX + CMD_LAST + (3-1));
+          else
+            sbi_wr(REG_CMD, CMD_RX            + (3-1));
+          end if;
+
+          for b in 0 to 3-1
+          loop
+            sbi_rd(REG_DATA);
+            check(rdata = RX_FLASH(w), "Flash read x" & integer'image(WIDTH_BITS(w)) & " : burst " & integer'image(burst) & " byte " & integer'image(b) & " read " & integer'image(rdata));
+          end loop;
+
+          if burst /= 2-1
+          then
+            check(sclk_cnt-sclk_beg = 3*8/WIDTH_BITS(w), "Flash read x" & integer'image(WIDTH_BITS(w)) & " : " & integer'image(sclk_cnt-sclk_beg) & " SCLK periods");
+            check_gap("Flash read x" & integer'image(WIDTH_BITS(w)) & " between two bursts");
+          end if;
+        end loop;
+
+        wait_cs_release;
+        check(io_oe_o = OE_CS_RELEASED , "Flash read x" & integer'image(WIDTH_BITS(w)) & " : OE " & to_string(io_oe_o) & " after the release of CS");
+
+        -- Back to Single (WP#, HOLD# driven)
+        sbi_wr(REG_CFG, CFG_ENABLE);
+      end loop;
+
+      -------------------------------------------------
+      -- Quad TX (Page Program data) : IO3..IO0 driven
+      -------------------------------------------------
+      report "[TESTBENCH] Quad TX";
+      sbi_wr(REG_CFG, CFG_ENABLE + 2*16);
+      oe_exp   <= OE_TX(2);
+      sbi_wr(REG_CMD, CMD_TX + CMD_LAST + (2-1));
+      sbi_wr(REG_DATA, 16#C3#);
+      sbi_wr(REG_DATA, 16#3C#);
+      wait_cs_release;
+      check(io_oe_o = OE_CS_RELEASED , "Quad TX : OE " & to_string(io_oe_o) & " after the release of CS");
+
+      check(oe_error = 0, integer'image(oe_error) & " SCLK edges with a bad OE");
+
+      assert (nb_ko = 0) report "[TESTBENCH] Test KO" severity error;
+
+      report "[TESTBENCH] Test Done";
+      test_done      <= '1';
+      wait;
+  end process;
+
+end architecture tb;
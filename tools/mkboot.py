@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+
+#-----------------------------------------------------------------------------
+# Title      : Build a boot image for esw/user_boot.c
+# Project    : Asylum
+#-----------------------------------------------------------------------------
+# File       : mkboot.py
+# Author     : mrosiere
+#-----------------------------------------------------------------------------
+# Description:
+# Input  : one instruction per line in hexadecimal (empty lines and lines
+#          starting with '#' are ignored)
+# Output : image to write in the spi flash at BOOT_IMAGE<n>_ADDR
+#   +0 LEN   : Number of instructions (16 bits, LSB first)
+#   +2 CRC   : CRC16 of the instructions (16 bits, LSB first)
+#   +4 INSTR : Instructions, BYTES bytes each, LSB first
+# With --mem, the image is also written in a flash memory file : "@aaaaaa"
+# is the address of the next byte, then one byte per line in hexadecimal
+# (the flash model keeps the other bytes erased, 0xFF)
+#-----------------------------------------------------------------------------
+# Copyright (c) 2026
+#-----------------------------------------------------------------------------
+# Revisions  :
+# Date        Version  Author   Description
+# 2026-10-17  1.0      mrosiere Created
+# 2026-10-17  1.1      mrosiere Memory file with the address of the image
+#-----------------------------------------------------------------------------
+
+import argparse
+import sys
+
+CRC16_POLYNOM = 0xA001
+
+# Same CRC than the CRC of the user SoC (and esw/include/crc16.h)
+def crc16(data: bytes, crc: int = 0xFFFF) -> int:
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            if crc & 0x0001:
+                crc = (crc >> 1) ^ CRC16_POLYNOM
+            else:
+                crc >>= 1
+    return crc
+
+def read_instructions(filename: str) -> list:
+    instructions = []
+    with open(filename) as f:
+        for line in f:
+            line = line.strip()
+            if line == "" or line.startswith("#"):
+                continue
+            instructions.append(int(line, 16))
+    return instructions
+
+def build_image(instructions: list, width: int, depth: int) -> bytes:
+    nb_bytes = (width+7)//8
+
+    if len(instructions) == 0 or len(instructions) > depth:
+        raise ValueError(f"{len(instructions)} instructions, expected 1 to {depth}")
+
+    payload = bytearray()
+    for instruction in instructions:
+        if instruction >> width:
+            raise ValueError(f"Instruction 0x{instruction:X} is wider than {width} bits")
+        payload += instruction.to_bytes(nb_bytes, "little")
+
+    header  = len(instructions).to_bytes(2, "little")
+    header += crc16(payload).to_bytes(2, "little")
+
+    return bytes(header + payload)
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Build a boot image for the instruction RAM")
+    parser.add_argument("input",                                       help="Instructions, one per line in hexadecimal")
+    parser.add_argument("-o", "--output",                              help="Binary image")
+    parser.add_argument("-w", "--width",  type=int, default=18,        help="Instruction width : 18 (picoblaze) or 32 (riscv)")
+    parser.add_argument("-d", "--depth",  type=int, default=1024,      help="Depth of the instruction RAM (BOOT_IMAGE_LEN_MAX)")
+    parser.add_argument("-a", "--addr",   type=lambda x: int(x, 0),
+                                          default=0x010000,            help="Address of the image in the flash (BOOT_IMAGE<n>_ADDR)")
+    parser.add_argument("-m", "--mem",                                 help="Flash memory file")
+    args = parser.parse_args()
+
+    try:
+        image = build_image(read_instructions(args.input), args.width, args.depth)
+    except ValueError as e:
+        print(f"mkboot: {e}", file=sys.stderr)
+        return 1
+
+    if args.output:
+        with open(args.output, "wb") as f:
+            f.write(image)
+
+    if args.mem:
+        with open(args.mem, "w") as f:
+            f.write(f"// {args.input}\n")
+            f.write(f"@{args.addr:06X}\n")
+            for byte in image:
+                f.write(f"{byte:02X}\n")
+
+    print(f"mkboot: {len(image)} bytes, CRC 0x{int.from_bytes(image[2:4], 'little'):04X}")
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -56,6 +56,30 @@ def modbus_write(client: ModbusSerialClient, slave_id: int, address: int, value:
     log.info(f"Successfully wrote value 0x{value:04X} to address 0x{address:04X}")
     return True
 
+def modbus_write_multiple(client: ModbusSerialClient, slave_id: int, address: int, values: list):
+    log.info(f"Function 16: Writing {len(values)} register(s) to address 0x{address:04X} (slave ID: 0x{slave_id:02X})")
+    result = client.write_registers(address=address, values=values, unit=slave_id)
+    if result.isError():
+        log.debug(f"Modbus error: {result}")
+        log.error(f"Error writing registers to address 0x{address:04X}")
+        return False
+    log.debug(f"Raw response object: {result}")
+    log.info(f"Successfully wrote {len(values)} register(s) to address 0x{address:04X}")
+    return True
+
+def modbus_read_write(client: ModbusSerialClient, slave_id: int, read_address: int, count: int, write_address: int, values: list):
+    log.info(f"Function 23: Writing {len(values)} register(s) to address 0x{write_address:04X} and reading {count} register(s) from address 0x{read_address:04X} (slave ID: 0x{slave_id:02X})")
+    result = client.readwrite_registers(read_address=read_address, read_count=count, write_address=write_address, write_registers=values, unit=slave_id)
+    if result.isError():
+        log.error(f"Modbus error: {result}")
+        log.error(f"Error reading/writing registers")
+        return None
+    log.debug(f"Raw response object: {result}")
+    for register in result.registers:
+        log.info(f"[0x{read_address:04X}] : 0x{register:04X}")
+        read_address+=1
+    return result.registers
+
 # === Example usage ===
 if __name__ == "__main__":
     try:
@@ -73,10 +97,16 @@ if __name__ == "__main__":
         modbus_read  (client, slave_id=slave_id, address=addrmap["led0"], count=1)
         modbus_read  (client, slave_id=slave_id, address=addrmap["led0"], count=1)
 
+        modbus_write_multiple (client, slave_id=slave_id, address=addrmap["led0"], values=[0x003C,0x00FF])
+
+        # Function 23 write led0 with the previous switch value and read switch in one round trip
+        # On error, the last valid switch value is kept
         cnt           = 0
+        switch        = [0]
         while True:
-            res = modbus_read  (client, slave_id=slave_id, address=addrmap["switch"], count=1)
-            modbus_write (client, slave_id=slave_id, address=addrmap["led0"], value=res[0])            
+            res = modbus_read_write (client, slave_id=slave_id, read_address=addrmap["switch"], count=1, write_address=addrmap["led0"], values=switch)
+            if res is not None:
+                switch = res
             modbus_write (client, slave_id=slave_id, address=addrmap["led1"], value=(cnt&0xFF))            
             cnt += 1
         